@@ -0,0 +1,69 @@
+﻿#pragma once
+#include <cstddef>		// std::size_t
+#include <new>			// ::operator new, std::align_val_t, std::bad_array_new_length
+#include <limits>		// std::numeric_limits
+
+namespace mini
+{
+	/// @brief キャッシュラインのサイズ（バイト）
+	inline constexpr std::size_t CacheLineSize = 64;
+
+	/// @brief 指定した境界に揃えてメモリを確保するアロケータ
+	/// @tparam Type 要素の型
+	/// @tparam Alignment アライメント（バイト）
+	template <class Type, std::size_t Alignment = CacheLineSize>
+	class AlignedAllocator
+	{
+	public:
+
+		static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+		static_assert(alignof(Type) <= Alignment, "Alignment must not be weaker than alignof(Type)");
+
+		/// @brief 要素の型
+		using value_type = Type;
+
+		/// @brief 別の要素の型のアロケータ
+		template <class Other>
+		struct rebind
+		{
+			using other = AlignedAllocator<Other, Alignment>;
+		};
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		constexpr AlignedAllocator() noexcept = default;
+
+		/// @brief 別の要素の型のアロケータから作成します。
+		template <class Other>
+		[[nodiscard]]
+		constexpr AlignedAllocator(const AlignedAllocator<Other, Alignment>&) noexcept {}
+
+		/// @brief メモリを確保します。
+		/// @param n 要素数
+		/// @return 確保したメモリの先頭ポインタ（`Alignment` バイト境界に揃う）
+		[[nodiscard]]
+		Type* allocate(const std::size_t n)
+		{
+			if ((std::numeric_limits<std::size_t>::max() / sizeof(Type)) < n)
+			{
+				throw std::bad_array_new_length{};
+			}
+
+			return static_cast<Type*>(::operator new((n * sizeof(Type)), std::align_val_t{ Alignment }));
+		}
+
+		/// @brief メモリを解放します。
+		/// @param p 確保したメモリの先頭ポインタ
+		void deallocate(Type* p, std::size_t) noexcept
+		{
+			::operator delete(p, std::align_val_t{ Alignment });
+		}
+
+		template <class Other>
+		[[nodiscard]]
+		friend constexpr bool operator ==(const AlignedAllocator&, const AlignedAllocator<Other, Alignment>&) noexcept
+		{
+			return true;
+		}
+	};
+}
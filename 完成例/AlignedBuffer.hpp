@@ -0,0 +1,210 @@
+﻿#pragma once
+#include <cstddef>		// std::size_t
+#include <cstring>		// std::memcpy
+#include <memory>		// std::uninitialized_fill_n, std::shared_ptr
+#include <memory_resource>	// std::pmr::memory_resource
+#include <utility>		// std::exchange, std::swap
+#include <type_traits>	// std::is_trivially_copyable_v, std::is_trivially_destructible_v
+#include "AlignedAllocator.hpp"	// mini::AlignedAllocator, mini::CacheLineSize
+
+namespace mini
+{
+	/// @brief 要素を初期化しないことを指定するタグの型
+	struct UninitializedTag
+	{
+		explicit UninitializedTag() = default;
+	};
+
+	/// @brief 要素を初期化しないことを指定するタグ
+	inline constexpr UninitializedTag Uninitialized{};
+
+	/// @brief 指定した境界に揃えて確保される、固定長の配列
+	/// @tparam Type 要素の型（trivially copyable かつ trivially destructible でなければならない）
+	/// @tparam Alignment アライメント（バイト）
+	/// @remark コピーすると内容も複製されます。
+	/// メモリリソースを指定した場合は、そこからメモリを確保し、破棄するときにそこへ戻します。
+	template <class Type, std::size_t Alignment = CacheLineSize>
+	class AlignedBuffer
+	{
+	public:
+
+		static_assert(std::is_trivially_copyable_v<Type> && std::is_trivially_destructible_v<Type>);
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		AlignedBuffer() = default;
+
+		/// @brief 指定した要素数の配列を作成します。
+		/// @param size 要素数
+		/// @param value 各要素の初期値
+		/// @param resource メモリを確保するメモリリソース。nullptr の場合は `AlignedAllocator` で確保する
+		[[nodiscard]]
+		AlignedBuffer(const std::size_t size, const Type& value, std::shared_ptr<std::pmr::memory_resource> resource = nullptr)
+			: m_resource{ std::move(resource) }
+			, m_data{ allocate(size) }
+			, m_size{ size }
+		{
+			std::uninitialized_fill_n(m_data, size, value);
+		}
+
+		/// @brief 指定した要素数の配列を、要素を初期化せずに作成します。
+		/// @param size 要素数
+		/// @param resource メモリを確保するメモリリソース。nullptr の場合は `AlignedAllocator` で確保する
+		/// @remark 要素の値は不定です。読み込む前に必ず書き込んでください。
+		[[nodiscard]]
+		AlignedBuffer(const std::size_t size, UninitializedTag, std::shared_ptr<std::pmr::memory_resource> resource = nullptr)
+			: m_resource{ std::move(resource) }
+			, m_data{ allocate(size) }
+			, m_size{ size } {}
+
+		/// @brief コピーコンストラクタ
+		[[nodiscard]]
+		AlignedBuffer(const AlignedBuffer& other)
+			: m_resource{ other.m_resource }
+			, m_data{ allocate(other.m_size) }
+			, m_size{ other.m_size }
+		{
+			if (m_size)
+			{
+				std::memcpy(m_data, other.m_data, (m_size * sizeof(Type)));
+			}
+		}
+
+		/// @brief ムーブコンストラクタ
+		[[nodiscard]]
+		AlignedBuffer(AlignedBuffer&& other) noexcept
+			: m_resource{ std::move(other.m_resource) }
+			, m_data{ std::exchange(other.m_data, nullptr) }
+			, m_size{ std::exchange(other.m_size, 0) } {}
+
+		/// @brief デストラクタ
+		~AlignedBuffer()
+		{
+			deallocate();
+		}
+
+		/// @brief コピー代入演算子
+		AlignedBuffer& operator =(const AlignedBuffer& other)
+		{
+			if (this != &other)
+			{
+				AlignedBuffer{ other }.swap(*this);
+			}
+
+			return *this;
+		}
+
+		/// @brief ムーブ代入演算子
+		AlignedBuffer& operator =(AlignedBuffer&& other) noexcept
+		{
+			AlignedBuffer{ std::move(other) }.swap(*this);
+			return *this;
+		}
+
+		/// @brief 要素数を返します。
+		/// @return 要素数
+		[[nodiscard]]
+		std::size_t size() const noexcept
+		{
+			return m_size;
+		}
+
+		/// @brief 配列が空であるかを返します。
+		/// @return 配列が空である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool empty() const noexcept
+		{
+			return (m_size == 0);
+		}
+
+		/// @brief 先頭ポインタを返します。
+		/// @return 先頭ポインタ（`Alignment` バイト境界に揃う）
+		[[nodiscard]]
+		Type* data() noexcept
+		{
+			return m_data;
+		}
+
+		/// @brief 先頭ポインタを返します。
+		/// @return 先頭ポインタ（`Alignment` バイト境界に揃う）
+		[[nodiscard]]
+		const Type* data() const noexcept
+		{
+			return m_data;
+		}
+
+		[[nodiscard]]
+		Type& operator [](const std::size_t index) noexcept
+		{
+			return m_data[index];
+		}
+
+		[[nodiscard]]
+		const Type& operator [](const std::size_t index) const noexcept
+		{
+			return m_data[index];
+		}
+
+		/// @brief 内容を交換します。
+		/// @param other 交換する配列
+		void swap(AlignedBuffer& other) noexcept
+		{
+			std::swap(m_resource, other.m_resource);
+			std::swap(m_data, other.m_data);
+			std::swap(m_size, other.m_size);
+		}
+
+		/// @brief メモリを確保するメモリリソースを返します。
+		/// @return メモリリソース。`AlignedAllocator` で確保している場合は nullptr
+		[[nodiscard]]
+		const std::shared_ptr<std::pmr::memory_resource>& resource() const noexcept
+		{
+			return m_resource;
+		}
+
+	private:
+
+		/// @brief メモリを確保するメモリリソース（nullptr の場合は `AlignedAllocator` を使う）
+		std::shared_ptr<std::pmr::memory_resource> m_resource;
+
+		/// @brief 先頭ポインタ
+		Type* m_data = nullptr;
+
+		/// @brief 要素数
+		std::size_t m_size = 0;
+
+		[[nodiscard]]
+		Type* allocate(const std::size_t size) const
+		{
+			if (size == 0)
+			{
+				return nullptr;
+			}
+
+			if (m_resource)
+			{
+				return static_cast<Type*>(m_resource->allocate((size * sizeof(Type)), Alignment));
+			}
+
+			return AlignedAllocator<Type, Alignment>{}.allocate(size);
+		}
+
+		void deallocate() noexcept
+		{
+			if (m_data)
+			{
+				if (m_resource)
+				{
+					m_resource->deallocate(m_data, (m_size * sizeof(Type)), Alignment);
+				}
+				else
+				{
+					AlignedAllocator<Type, Alignment>{}.deallocate(m_data, m_size);
+				}
+
+				m_data = nullptr;
+				m_size = 0;
+			}
+		}
+	};
+}
@@ -1,5 +1,5 @@
 ﻿#pragma once
-#include <cstdint> // std::uint16_t, std::uint32_t, std::int32_t
+#include <cstdint> // std::uint16_t, std::uint32_t, std::int32_t, std::int64_t, std::uint64_t, UINT32_MAX
 
 namespace mini
 {
@@ -17,7 +17,7 @@ namespace mini
 		std::int32_t  biWidth = 0;		// 画像の幅（ピクセル）
 		std::int32_t  biHeight = 0;		// 画像の高さ（ピクセル）。正の場合は下の行から、負の場合は上の行から格納
 		std::uint16_t biPlanes = 1;		// 1（この値は固定）
-		std::uint16_t biBitCount = 24;	// 24 ビットカラーの場合は 24
+		std::uint16_t biBitCount = 24;	// 24 ビットカラーの場合は 24, 不透明度付きの 32 ビットカラーの場合は 32
 		std::uint32_t biCompression = 0;
 		std::uint32_t biSizeImage = 0;	// 画像データのサイズ（バイト）
 		std::int32_t  biXPelsPerMeter = 0;
@@ -28,18 +28,41 @@ namespace mini
 		/// @brief 指定した幅と高さに基づいて BMPHeader を作成します。
 		/// @param width 画像の幅（ピクセル）
 		/// @param height 画像の高さ（ピクセル）
+		/// @param bitCount 1 ピクセルあたりのビット数（24 または 32）
 		/// @return 作成した BMPHeader
+		/// @remark ファイル全体のサイズが 32 ビットで表せない（4 GiB 以上の）場合、bfSize は表現できないため、
+		/// bfSize と biSizeImage を 0 にします（非圧縮の場合、biSizeImage は 0 でもよい）。
 		[[nodiscard]]
-		static constexpr BMPHeader Make(int width, int height) noexcept
+		static constexpr BMPHeader Make(int width, int height, std::uint16_t bitCount = 24) noexcept
 		{
 			BMPHeader header;
 			header.biWidth = width;
 			header.biHeight = height;
-			const int rowSize = ((width * 3 + 3) / 4) * 4; // 4 バイト境界に合わせる
-			header.bfSize = sizeof(BMPHeader) + (rowSize * height);
-			header.biSizeImage = (rowSize * height);
+			header.biBitCount = bitCount;
+
+			// 大きな画像でもオーバーフローしないよう、64 ビットで計算する
+			const std::uint64_t imageSize = (FileSize(width, height, bitCount) - sizeof(BMPHeader));
+
+			if ((sizeof(BMPHeader) + imageSize) <= UINT32_MAX)
+			{
+				header.bfSize = static_cast<std::uint32_t>(sizeof(BMPHeader) + imageSize);
+				header.biSizeImage = static_cast<std::uint32_t>(imageSize);
+			}
+
 			return header;
 		}
+
+		/// @brief 指定した幅と高さの BMP ファイル全体のサイズを返します。
+		/// @param width 画像の幅（ピクセル）
+		/// @param height 画像の高さ（ピクセル）
+		/// @param bitCount 1 ピクセルあたりのビット数（24 または 32）
+		/// @return ファイル全体のサイズ（バイト）。bfSize と異なり、4 GiB 以上でも正しい値を返します
+		[[nodiscard]]
+		static constexpr std::int64_t FileSize(int width, int height, std::uint16_t bitCount = 24) noexcept
+		{
+			const std::int64_t rowSize = ((static_cast<std::int64_t>(width) * (bitCount / 8) + 3) / 4) * 4; // 4 バイト境界に合わせる
+			return (static_cast<std::int64_t>(sizeof(BMPHeader)) + (rowSize * height));
+		}
 	};
 
 #pragma pack(pop) // アライメント設定を元に戻す
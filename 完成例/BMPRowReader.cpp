@@ -0,0 +1,276 @@
+﻿#include <vector>				// std::vector
+#include <cmath>				// std::abs
+#include <cstddef>				// std::byte
+#include <cstdint>				// std::int64_t, INT32_MIN
+#include <algorithm>			// std::min
+#include "BMPRowReader.hpp"
+#include "BinaryFileReader.hpp" // mini::BinaryFileReader
+#include "PixelCodec.hpp"		// mini::DecodeBGR24Row, mini::DecodeBGRA32Row
+
+namespace mini
+{
+	class BMPRowReader::Impl
+	{
+	public:
+
+		Impl() = default;
+
+		[[nodiscard]]
+		bool isOpen() const noexcept
+		{
+			return m_reader.isOpen();
+		}
+
+		bool open(const std::string_view fileName)
+		{
+			close();
+
+			if (!m_reader.open(fileName))
+			{
+				return false;
+			}
+
+			// ヘッダーサイズ分のデータを読み込めない場合、
+			// BMP 形式でない場合、または 24 ビットカラーか圧縮なしの 32 ビットカラーでない場合は失敗
+			if ((m_reader.read(m_header) != sizeof(BMPHeader))
+				|| (m_header.bfType != 0x4D42)
+				|| ((m_header.biBitCount != 24) && ((m_header.biBitCount != 32) || (m_header.biCompression != 0)))
+				|| (m_header.biWidth <= 0) || (m_header.biHeight == 0) || (m_header.biHeight == INT32_MIN))
+			{
+				close();
+				return false;
+			}
+
+			m_width = m_header.biWidth;
+			m_height = std::abs(m_header.biHeight); // 負の場合は上の行から格納されている
+			m_rowSize = ((static_cast<std::int64_t>(m_width) * (m_header.biBitCount / 8) + 3) / 4) * 4; // 4 バイト境界に合わせる
+
+			// 画素データがファイルに収まっていない場合は失敗
+			if (m_reader.size() < (m_header.bfOffBits + (m_rowSize * m_height)))
+			{
+				close();
+				return false;
+			}
+
+			return true;
+		}
+
+		void close()
+		{
+			m_reader.close();
+			m_header = BMPHeader{};
+			m_width = 0;
+			m_height = 0;
+			m_rowSize = 0;
+			m_currentRow = 0;
+			m_buffer.clear();
+			m_buffer.shrink_to_fit();
+		}
+
+		[[nodiscard]]
+		const BMPHeader& header() const noexcept
+		{
+			return m_header;
+		}
+
+		[[nodiscard]]
+		int width() const noexcept
+		{
+			return m_width;
+		}
+
+		[[nodiscard]]
+		int height() const noexcept
+		{
+			return m_height;
+		}
+
+		[[nodiscard]]
+		int currentRow() const noexcept
+		{
+			return m_currentRow;
+		}
+
+		bool readRow(const int y, const std::span<Color> row)
+		{
+			if ((y < 0) || (m_height <= y) || (row.size() < static_cast<std::size_t>(m_width)))
+			{
+				return false;
+			}
+
+			m_buffer.resize(static_cast<std::size_t>(m_rowSize));
+
+			if (!readFileRows(y, 1))
+			{
+				return false;
+			}
+
+			decodeRow(m_buffer, row.first(m_width));
+			m_currentRow = (y + 1);
+
+			return true;
+		}
+
+		int readRows(Image& band)
+		{
+			if ((band.width() != m_width) || (m_height <= m_currentRow))
+			{
+				return 0;
+			}
+
+			const int y0 = m_currentRow;
+			const int numRows = std::min(band.height(), (m_height - m_currentRow));
+
+			// 複数行をまとめて 1 回で読み込み、行ごとに変換する
+			m_buffer.resize(static_cast<std::size_t>(m_rowSize * numRows));
+
+			if (!readFileRows(y0, numRows))
+			{
+				return 0;
+			}
+
+			for (int i = 0; i < numRows; ++i)
+			{
+				// 下の行から格納されている場合は、バッファ内で行が逆順に並んでいる
+				const int bufferRow = (isTopDown() ? i : (numRows - 1 - i));
+				const std::span<const std::byte> src{ (m_buffer.data() + (m_rowSize * bufferRow)), static_cast<std::size_t>(m_rowSize) };
+				decodeRow(src, band.row(i));
+			}
+
+			m_currentRow += numRows;
+
+			return numRows;
+		}
+
+	private:
+
+		/// @brief バイナリファイルの読み込み
+		BinaryFileReader m_reader;
+
+		/// @brief BMP ファイルのヘッダー
+		BMPHeader m_header;
+
+		/// @brief 画像の幅（ピクセル）
+		int m_width = 0;
+
+		/// @brief 画像の高さ（ピクセル）
+		int m_height = 0;
+
+		/// @brief 1 行分のデータのサイズ（バイト）
+		std::int64_t m_rowSize = 0;
+
+		/// @brief 次に読み込む行の行番号
+		int m_currentRow = 0;
+
+		/// @brief ファイルから読み込んだデータを一時的に格納するバッファ
+		std::vector<std::byte> m_buffer;
+
+		[[nodiscard]]
+		bool isTopDown() const noexcept
+		{
+			return (m_header.biHeight < 0);
+		}
+
+		/// @brief ファイルの 1 行分のデータを、1 ピクセルあたりのビット数に応じて色の配列に変換します。
+		void decodeRow(const std::span<const std::byte> src, const std::span<Color> dst) const noexcept
+		{
+			if (m_header.biBitCount == 32)
+			{
+				DecodeBGRA32Row(src, dst);
+			}
+			else
+			{
+				DecodeBGR24Row(src, dst);
+			}
+		}
+
+		/// @brief 画像の行番号を、ファイル内での格納順の行番号に変換します。
+		[[nodiscard]]
+		int fileRowIndex(const int y) const noexcept
+		{
+			return (isTopDown() ? y : (m_height - 1 - y));
+		}
+
+		/// @brief 画像の y0 行目から numRows 行分のデータを、ファイル内での格納順のままバッファに読み込みます。
+		[[nodiscard]]
+		bool readFileRows(const int y0, const int numRows)
+		{
+			// 下の行から格納されている場合は、最後の行がファイル内で最も手前にある
+			const int firstFileRow = (isTopDown() ? y0 : fileRowIndex(y0 + numRows - 1));
+			const std::int64_t size = (m_rowSize * numRows);
+
+			if (!m_reader.seek(m_header.bfOffBits + (m_rowSize * firstFileRow)))
+			{
+				return false;
+			}
+
+			return (m_reader.read(m_buffer.data(), static_cast<std::size_t>(size)) == size);
+		}
+	};
+
+	BMPRowReader::BMPRowReader()
+		: m_pImpl{ std::make_shared<Impl>() } {}
+
+	BMPRowReader::BMPRowReader(const std::string_view fileName)
+		: BMPRowReader{} // 移譲コンストラクタ
+	{
+		m_pImpl->open(fileName);
+	}
+
+	BMPRowReader::~BMPRowReader() = default;
+
+	bool BMPRowReader::isOpen() const noexcept
+	{
+		return m_pImpl->isOpen();
+	}
+
+	BMPRowReader::operator bool() const noexcept
+	{
+		return m_pImpl->isOpen();
+	}
+
+	bool BMPRowReader::open(const std::string_view fileName)
+	{
+		return m_pImpl->open(fileName);
+	}
+
+	void BMPRowReader::close()
+	{
+		m_pImpl->close();
+	}
+
+	const BMPHeader& BMPRowReader::header() const noexcept
+	{
+		return m_pImpl->header();
+	}
+
+	int BMPRowReader::width() const noexcept
+	{
+		return m_pImpl->width();
+	}
+
+	int BMPRowReader::height() const noexcept
+	{
+		return m_pImpl->height();
+	}
+
+	int BMPRowReader::currentRow() const noexcept
+	{
+		return m_pImpl->currentRow();
+	}
+
+	bool BMPRowReader::readRow(const std::span<Color> row)
+	{
+		return m_pImpl->readRow(m_pImpl->currentRow(), row);
+	}
+
+	bool BMPRowReader::readRow(const int y, const std::span<Color> row)
+	{
+		return m_pImpl->readRow(y, row);
+	}
+
+	int BMPRowReader::readRows(Image& band)
+	{
+		return m_pImpl->readRows(band);
+	}
+}
@@ -0,0 +1,89 @@
+﻿#pragma once
+#include <memory>		// std::shared_ptr
+#include <span>			// std::span
+#include <string_view>	// std::string_view
+#include "BMPHeader.hpp"	// mini::BMPHeader
+#include "Image.hpp"	// mini::Image
+
+namespace mini
+{
+	/// @brief BMP ファイルを 1 行ずつ読み込むクラス
+	/// @remark 画像全体をメモリに読み込まないため、メモリに収まらない大きさの画像も扱えます。
+	/// 行は、ファイル内の格納順（biHeight の符号）にかかわらず、常に上の行から順に返します。
+	class BMPRowReader
+	{
+	public:
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		BMPRowReader();
+
+		/// @brief BMP ファイルをオープンします。
+		/// @param fileName ファイル名
+		[[nodiscard]]
+		explicit BMPRowReader(std::string_view fileName);
+
+		/// @brief デストラクタ
+		~BMPRowReader();
+
+		/// @brief ファイルがオープンされているかを返します。
+		/// @return オープンされている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		/// @brief ファイルがオープンされているかを返します。
+		/// @return オープンされている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief BMP ファイルをオープンします。すでにオープンされている場合はクローズしてから再オープンします。
+		/// @param fileName ファイル名
+		/// @return オープンに成功し、対応している形式の BMP ファイルであった場合 true, それ以外の場合は false
+		bool open(std::string_view fileName);
+
+		/// @brief ファイルをクローズします。
+		void close();
+
+		/// @brief BMP ファイルのヘッダーを返します。
+		/// @return BMP ファイルのヘッダー
+		[[nodiscard]]
+		const BMPHeader& header() const noexcept;
+
+		/// @brief 画像の幅（ピクセル）を返します。
+		/// @return 画像の幅（ピクセル）
+		[[nodiscard]]
+		int width() const noexcept;
+
+		/// @brief 画像の高さ（ピクセル）を返します。
+		/// @return 画像の高さ（ピクセル）
+		[[nodiscard]]
+		int height() const noexcept;
+
+		/// @brief 次に読み込む行の行番号を返します。
+		/// @return 次に読み込む行の行番号。すべての行を読み込んだ場合は `height()`
+		[[nodiscard]]
+		int currentRow() const noexcept;
+
+		/// @brief 次の 1 行を読み込みます。
+		/// @param row 読み込んだ行の格納先（`width()` ピクセル以上）
+		/// @return 読み込みに成功した場合 true, それ以外の場合は false
+		bool readRow(std::span<Color> row);
+
+		/// @brief 指定した行を読み込みます。次に読み込む行は y + 1 行目になります。
+		/// @param y 行番号
+		/// @param row 読み込んだ行の格納先（`width()` ピクセル以上）
+		/// @return 読み込みに成功した場合 true, それ以外の場合は false
+		bool readRow(int y, std::span<Color> row);
+
+		/// @brief 次の複数行をまとめて読み込みます。
+		/// @param band 読み込んだ行の格納先。幅は `width()` と等しく、高さの分だけ読み込みます
+		/// @return 読み込んだ行数。残りの行数が `band.height()` より少ない場合は残りの行数
+		int readRows(Image& band);
+
+	private:
+
+		class Impl;
+
+		std::shared_ptr<Impl> m_pImpl;
+	};
+}
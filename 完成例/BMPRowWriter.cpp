@@ -0,0 +1,242 @@
+﻿#include <vector>				// std::vector
+#include <cstddef>				// std::byte
+#include <cstdint>				// std::int64_t
+#include "BMPRowWriter.hpp"
+#include "BinaryFileWriter.hpp"	// mini::BinaryFileWriter
+#include "PixelCodec.hpp"		// mini::EncodeBGR24Row
+
+namespace mini
+{
+	class BMPRowWriter::Impl
+	{
+	public:
+
+		Impl() = default;
+
+		~Impl()
+		{
+			close();
+		}
+
+		[[nodiscard]]
+		bool isOpen() const noexcept
+		{
+			return m_writer.isOpen();
+		}
+
+		bool open(const std::string_view fileName, const int width, const int height)
+		{
+			close();
+
+			// サイズが不正な場合は失敗
+			if ((width <= 0) || (height <= 0))
+			{
+				return false;
+			}
+
+			// 一時ファイルに書き出し、すべての行を書き出せた場合のみ置き換える
+			if (!m_writer.open(fileName, WriteMode::Atomic))
+			{
+				return false;
+			}
+
+			// 上の行から順に書き出せるよう、高さを負にする（上の行から格納）
+			m_header = BMPHeader::Make(width, height);
+			m_header.biHeight = -height;
+			m_width = width;
+			m_height = height;
+			m_rowSize = ((static_cast<std::size_t>(width) * 3 + 3) / 4) * 4; // 4 バイト境界に合わせる
+
+			// 最終的なサイズはわかっているので、領域をあらかじめ確保する
+			m_writer.preallocate(BMPHeader::FileSize(width, height));
+
+			// ヘッダーを書き込む
+			if (m_writer.write(m_header) != sizeof(BMPHeader))
+			{
+				close();
+				return false;
+			}
+
+			return true;
+		}
+
+		bool close()
+		{
+			// すべての行を書き出せた場合のみ確定する。それ以外の場合は一時ファイルを削除する
+			const bool completed = (m_writer.isOpen() && (!m_failed) && (m_currentRow == m_height) && m_writer.commit());
+
+			m_writer.close();
+			m_failed = false;
+			m_header = BMPHeader{};
+			m_width = 0;
+			m_height = 0;
+			m_rowSize = 0;
+			m_currentRow = 0;
+			m_buffer.clear();
+			m_buffer.shrink_to_fit();
+
+			return completed;
+		}
+
+		[[nodiscard]]
+		const BMPHeader& header() const noexcept
+		{
+			return m_header;
+		}
+
+		[[nodiscard]]
+		int width() const noexcept
+		{
+			return m_width;
+		}
+
+		[[nodiscard]]
+		int height() const noexcept
+		{
+			return m_height;
+		}
+
+		[[nodiscard]]
+		int currentRow() const noexcept
+		{
+			return m_currentRow;
+		}
+
+		bool writeRow(const std::span<const Color> row)
+		{
+			if ((!m_writer.isOpen()) || m_failed || (m_height <= m_currentRow) || (row.size() < static_cast<std::size_t>(m_width)))
+			{
+				return false;
+			}
+
+			// 4 バイト境界に合わせるための末尾の余白は 0 のままにする
+			m_buffer.resize(m_rowSize);
+			EncodeBGR24Row(row.first(m_width), m_buffer);
+			if (m_writer.write(m_buffer.data(), m_rowSize) != static_cast<std::int64_t>(m_rowSize))
+			{
+				// 一部だけ書き出された行があるため、以降の書き出しはすべて失敗させる
+				m_failed = true;
+				return false;
+			}
+
+			++m_currentRow;
+
+			return true;
+		}
+
+		bool writeRows(const Image& band)
+		{
+			if ((!m_writer.isOpen()) || m_failed || (band.width() != m_width) || ((m_height - m_currentRow) < band.height()))
+			{
+				return false;
+			}
+
+			// 複数行をまとめて変換し、1 回で書き出す
+			const std::size_t bandSize = (m_rowSize * static_cast<std::size_t>(band.height()));
+			m_buffer.assign(bandSize, std::byte{ 0 });
+
+			for (int i = 0; i < band.height(); ++i)
+			{
+				EncodeBGR24Row(band.row(i), std::span{ m_buffer }.subspan(m_rowSize * i, m_rowSize));
+			}
+
+			if (m_writer.write(m_buffer.data(), bandSize) != static_cast<std::int64_t>(bandSize))
+			{
+				// 一部だけ書き出された行があるため、以降の書き出しはすべて失敗させる
+				m_failed = true;
+				return false;
+			}
+
+			m_currentRow += band.height();
+
+			return true;
+		}
+
+	private:
+
+		/// @brief バイナリファイルの書き出し
+		BinaryFileWriter m_writer;
+
+		/// @brief BMP ファイルのヘッダー
+		BMPHeader m_header;
+
+		/// @brief 画像の幅（ピクセル）
+		int m_width = 0;
+
+		/// @brief 画像の高さ（ピクセル）
+		int m_height = 0;
+
+		/// @brief 1 行分のデータのサイズ（バイト）
+		std::size_t m_rowSize = 0;
+
+		/// @brief 次に書き出す行の行番号
+		int m_currentRow = 0;
+
+		/// @brief 書き出しに失敗したか
+		bool m_failed = false;
+
+		/// @brief ファイルに書き出すデータを一時的に格納するバッファ
+		std::vector<std::byte> m_buffer;
+	};
+
+	BMPRowWriter::BMPRowWriter()
+		: m_pImpl{ std::make_shared<Impl>() } {}
+
+	BMPRowWriter::BMPRowWriter(const std::string_view fileName, const int width, const int height)
+		: BMPRowWriter{} // 移譲コンストラクタ
+	{
+		m_pImpl->open(fileName, width, height);
+	}
+
+	BMPRowWriter::~BMPRowWriter() = default;
+
+	bool BMPRowWriter::isOpen() const noexcept
+	{
+		return m_pImpl->isOpen();
+	}
+
+	BMPRowWriter::operator bool() const noexcept
+	{
+		return m_pImpl->isOpen();
+	}
+
+	bool BMPRowWriter::open(const std::string_view fileName, const int width, const int height)
+	{
+		return m_pImpl->open(fileName, width, height);
+	}
+
+	bool BMPRowWriter::close()
+	{
+		return m_pImpl->close();
+	}
+
+	const BMPHeader& BMPRowWriter::header() const noexcept
+	{
+		return m_pImpl->header();
+	}
+
+	int BMPRowWriter::width() const noexcept
+	{
+		return m_pImpl->width();
+	}
+
+	int BMPRowWriter::height() const noexcept
+	{
+		return m_pImpl->height();
+	}
+
+	int BMPRowWriter::currentRow() const noexcept
+	{
+		return m_pImpl->currentRow();
+	}
+
+	bool BMPRowWriter::writeRow(const std::span<const Color> row)
+	{
+		return m_pImpl->writeRow(row);
+	}
+
+	bool BMPRowWriter::writeRows(const Image& band)
+	{
+		return m_pImpl->writeRows(band);
+	}
+}
@@ -0,0 +1,91 @@
+﻿#pragma once
+#include <memory>		// std::shared_ptr
+#include <span>			// std::span
+#include <string_view>	// std::string_view
+#include "BMPHeader.hpp"	// mini::BMPHeader
+#include "Image.hpp"	// mini::Image
+
+namespace mini
+{
+	/// @brief BMP ファイルを 1 行ずつ書き出すクラス
+	/// @remark 画像全体をメモリに用意しなくてよいため、メモリに収まらない大きさの画像も扱えます。
+	/// 行は上の行から順に受け取り、先頭から順に書き出せるよう biHeight を負（上の行から格納）にして保存します。
+	/// 一時ファイルに書き出し、`close()` ですべての行がそろっている場合のみ、指定したファイルに置き換えます。
+	/// ファイル全体のサイズが 4 GiB 以上になる場合、bfSize と biSizeImage は 0 になります（`BMPHeader::Make()` を参照）。
+	class BMPRowWriter
+	{
+	public:
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		BMPRowWriter();
+
+		/// @brief BMP ファイルを作成してオープンします。
+		/// @param fileName ファイル名
+		/// @param width 画像の幅（ピクセル）
+		/// @param height 画像の高さ（ピクセル）
+		[[nodiscard]]
+		BMPRowWriter(std::string_view fileName, int width, int height);
+
+		/// @brief デストラクタ
+		~BMPRowWriter();
+
+		/// @brief ファイルがオープンされているかを返します。
+		/// @return オープンされている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		/// @brief ファイルがオープンされているかを返します。
+		/// @return オープンされている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief BMP ファイルを作成してオープンします。すでにオープンされている場合はクローズしてから再オープンします。
+		/// @param fileName ファイル名
+		/// @param width 画像の幅（ピクセル）
+		/// @param height 画像の高さ（ピクセル）
+		/// @return オープンに成功した場合 true, それ以外の場合は false
+		bool open(std::string_view fileName, int width, int height);
+
+		/// @brief ファイルをクローズします。
+		/// @return すべての行を書き出してファイルを確定できた場合 true, それ以外の場合は false
+		/// @remark 書き出していない行が残っている場合や、書き出しに失敗した場合は、不完全な画像としてファイルを作成しません（既存のファイルは変更しません）。
+		bool close();
+
+		/// @brief BMP ファイルのヘッダーを返します。
+		/// @return BMP ファイルのヘッダー
+		[[nodiscard]]
+		const BMPHeader& header() const noexcept;
+
+		/// @brief 画像の幅（ピクセル）を返します。
+		/// @return 画像の幅（ピクセル）
+		[[nodiscard]]
+		int width() const noexcept;
+
+		/// @brief 画像の高さ（ピクセル）を返します。
+		/// @return 画像の高さ（ピクセル）
+		[[nodiscard]]
+		int height() const noexcept;
+
+		/// @brief 次に書き出す行の行番号を返します。
+		/// @return 次に書き出す行の行番号。すべての行を書き出した場合は `height()`
+		[[nodiscard]]
+		int currentRow() const noexcept;
+
+		/// @brief 次の 1 行を書き出します。
+		/// @param row 書き出す行（`width()` ピクセル以上）
+		/// @return 書き出しに成功した場合 true, それ以外の場合は false
+		bool writeRow(std::span<const Color> row);
+
+		/// @brief 次の複数行をまとめて書き出します。
+		/// @param band 書き出す行。幅は `width()` と等しく、高さの分だけ書き出します
+		/// @return 書き出しに成功した場合 true, 残りの行数を超える場合などは false
+		bool writeRows(const Image& band);
+
+	private:
+
+		class Impl;
+
+		std::shared_ptr<Impl> m_pImpl;
+	};
+}
@@ -1,28 +1,118 @@
-﻿#include <fstream> // std::ifstream
-#include <filesystem> // std::filesystem::absolute
+﻿#include <algorithm>	// std::min
+#include <cstddef>		// std::byte
+#include <cstring>		// std::memcpy
+#include <vector>		// std::vector
+#include <filesystem>	// std::filesystem::absolute
 #include "BinaryFileReader.hpp"
 
+#if defined(_WIN32)
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <Windows.h>
+#else
+	#include <fcntl.h>		// ::open
+	#include <unistd.h>		// ::pread, ::close
+	#include <sys/stat.h>	// ::fstat
+#endif
+
 namespace mini
 {
 	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
 	namespace
 	{
+	#if defined(_WIN32)
+
+		/// @brief ファイルのハンドルの型
+		using FileHandle = HANDLE;
+
+		/// @brief 無効なファイルのハンドル
+		const FileHandle InvalidFileHandle = INVALID_HANDLE_VALUE;
+
+		[[nodiscard]]
+		FileHandle OpenExistingFile(const std::filesystem::path& path) noexcept
+		{
+			return ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+				OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		}
+
+		void CloseFile(const FileHandle file) noexcept
+		{
+			::CloseHandle(file);
+		}
+
 		/// @brief ファイルのサイズ（バイト）を取得します。
 		/// @param file ファイル
 		/// @return ファイルのサイズ（バイト）
 		[[nodiscard]]
-		std::int64_t GetFileSize(std::ifstream& file)
+		std::int64_t GetFileSize(const FileHandle file) noexcept
+		{
+			LARGE_INTEGER size;
+			return (::GetFileSizeEx(file, &size) ? size.QuadPart : 0);
+		}
+
+		/// @brief ファイルの指定した位置から読み込みます。
+		/// @return 読み込んだバイト数。失敗した場合は -1
+		[[nodiscard]]
+		std::int64_t ReadFileChunkAt(const FileHandle file, const std::int64_t offset, void* data, const std::size_t size) noexcept
 		{
-			const std::int64_t currentPos = file.tellg();
+			OVERLAPPED overlapped{};
+			overlapped.Offset = static_cast<DWORD>(offset);
+			overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+			DWORD numRead = 0;
+			const DWORD chunk = static_cast<DWORD>(std::min<std::size_t>(size, 0x40000000));
+
+			if (::ReadFile(file, data, chunk, &numRead, &overlapped))
+			{
+				return numRead;
+			}
+
+			// ファイルの終端を越えて読もうとした場合は 0 バイトとする
+			return ((::GetLastError() == ERROR_HANDLE_EOF) ? 0 : -1);
+		}
 
-			file.seekg(0, std::ios::end);
+	#else
 
-			const std::int64_t size = file.tellg();
+		/// @brief ファイルのハンドルの型
+		using FileHandle = int;
 
-			file.seekg(currentPos);
+		/// @brief 無効なファイルのハンドル
+		constexpr FileHandle InvalidFileHandle = -1;
 
-			return size;
+		[[nodiscard]]
+		FileHandle OpenExistingFile(const std::filesystem::path& path) noexcept
+		{
+			return ::open(path.c_str(), O_RDONLY);
 		}
+
+		void CloseFile(const FileHandle file) noexcept
+		{
+			::close(file);
+		}
+
+		/// @brief ファイルのサイズ（バイト）を取得します。
+		/// @param file ファイル
+		/// @return ファイルのサイズ（バイト）
+		[[nodiscard]]
+		std::int64_t GetFileSize(const FileHandle file) noexcept
+		{
+			struct stat st;
+			return ((::fstat(file, &st) == 0) ? st.st_size : 0);
+		}
+
+		/// @brief ファイルの指定した位置から読み込みます。
+		/// @return 読み込んだバイト数。失敗した場合は -1
+		[[nodiscard]]
+		std::int64_t ReadFileChunkAt(const FileHandle file, const std::int64_t offset, void* data, const std::size_t size) noexcept
+		{
+			return ::pread(file, data, size, static_cast<off_t>(offset));
+		}
+
+	#endif
 	}
 
 	class BinaryFileReader::Impl
@@ -39,28 +129,29 @@ namespace mini
 		[[nodiscard]]
 		bool isOpen() const noexcept
 		{
-			return m_file.is_open();
+			return (m_file != InvalidFileHandle);
 		}
 
 		bool open(const std::string_view path)
 		{
 			// すでにオープンされている場合はクローズする
-			if (m_file.is_open())
+			if (isOpen())
 			{
 				close();
 			}
 
-			// ファイルをバイナリモードでオープンする
-			m_file.open(path, std::ios::binary);
+			// ファイルをオープンする
+			const std::filesystem::path filePath{ path };
+			m_file = OpenExistingFile(filePath);
 
 			// オープンに失敗した場合は false を返す
-			if (!m_file.is_open())
+			if (!isOpen())
 			{
 				return false;
 			}
 
 			// ファイルの絶対パスとサイズを取得して記録する
-			m_fullPath = std::filesystem::absolute(path).string();
+			m_fullPath = std::filesystem::absolute(filePath).string();
 			m_size = GetFileSize(m_file);
 
 			return true;
@@ -69,11 +160,20 @@ namespace mini
 		void close()
 		{
 			// ファイルをクローズする
-			m_file.close();
+			if (isOpen())
+			{
+				CloseFile(m_file);
+				m_file = InvalidFileHandle;
+			}
 
 			// 記録していたファイルの絶対パスとサイズをクリアする
 			m_fullPath.clear();
 			m_size = 0;
+			m_pos = 0;
+
+			// バッファを空にする
+			m_bufferPos = 0;
+			m_bufferSize = 0;
 		}
 
 		[[nodiscard]]
@@ -85,10 +185,101 @@ namespace mini
 		[[nodiscard]]
 		std::int64_t read(void* data, const size_t size)
 		{
-			m_file.read(static_cast<char*>(data), size);
+			const std::int64_t numRead = peek(data, size);
+			m_pos += numRead;
+			return numRead;
+		}
+
+		[[nodiscard]]
+		std::int64_t peek(void* data, const size_t size)
+		{
+			if (!isOpen())
+			{
+				return 0;
+			}
+
+			std::byte* dst = static_cast<std::byte*>(data);
+			std::int64_t pos = m_pos;
+			std::int64_t total = 0;
+
+			while (total < static_cast<std::int64_t>(size))
+			{
+				const std::int64_t remaining = (size - total);
+
+				if (!inBuffer(pos))
+				{
+					// 残りがバッファより大きい場合は、バッファを介さずに直接読み込む
+					if (BufferSize <= remaining)
+					{
+						total += readAt(pos, (dst + total), remaining);
+						break;
+					}
+
+					// バッファに読み込む。ファイルの終端に達した場合は終了
+					if (!fillBuffer(pos))
+					{
+						break;
+					}
+				}
+
+				// バッファからコピーする
+				const std::int64_t offsetInBuffer = (pos - m_bufferPos);
+				const std::int64_t n = std::min((m_bufferSize - offsetInBuffer), remaining);
+				std::memcpy((dst + total), (m_buffer.data() + offsetInBuffer), n);
+				total += n;
+				pos += n;
+			}
+
+			return total;
+		}
+
+		[[nodiscard]]
+		std::int64_t readAt(const std::int64_t offset, void* data, const size_t size) const
+		{
+			if ((!isOpen()) || (offset < 0))
+			{
+				return 0;
+			}
+
+			// 一度に読み込めるとは限らないので、終端に達するまで繰り返す
+			std::int64_t total = 0;
+
+			while (total < static_cast<std::int64_t>(size))
+			{
+				const std::int64_t n = ReadFileChunkAt(m_file, (offset + total), (static_cast<char*>(data) + total), (size - total));
+
+				if (n <= 0)
+				{
+					break;
+				}
+
+				total += n;
+			}
+
+			return total;
+		}
+
+		bool seek(const std::int64_t pos)
+		{
+			// ファイルの範囲外には移動できない
+			if ((!isOpen()) || (pos < 0) || (m_size < pos))
+			{
+				return false;
+			}
+
+			m_pos = pos;
+			return true;
+		}
+
+		bool skip(const std::int64_t offset)
+		{
+			return seek(m_pos + offset);
+		}
 
-			// 直近の read で読み込んだバイト数を返す
-			return m_file.gcount();
+		[[nodiscard]]
+		std::int64_t tell() const noexcept
+		{
+			return m_pos;
 		}
 
 		[[nodiscard]]
@@ -99,14 +290,51 @@ namespace mini
 
 	private:
 
-		/// @brief ファイル入力ストリーム
-		std::ifstream m_file;
+		/// @brief ファイルのハンドル
+		FileHandle m_file = InvalidFileHandle;
 
 		/// @brief ファイルのサイズ（バイト）
 		std::int64_t m_size = 0;
 
+		/// @brief 読み込み位置（ファイル先頭からのバイト数）
+		std::int64_t m_pos = 0;
+
 		/// @brief ファイルの絶対パス
 		std::string m_fullPath;
+
+		/// @brief バッファのサイズ（バイト）
+		static constexpr std::int64_t BufferSize = (256 * 1024);
+
+		/// @brief 小さな読み込みをまとめるためのバッファ
+		std::vector<std::byte> m_buffer;
+
+		/// @brief バッファの先頭のファイル内での位置
+		std::int64_t m_bufferPos = 0;
+
+		/// @brief バッファに読み込まれている有効なデータのサイズ（バイト）
+		std::int64_t m_bufferSize = 0;
+
+		/// @brief 指定した位置のデータがバッファに読み込まれているかを返します。
+		[[nodiscard]]
+		bool inBuffer(const std::int64_t pos) const noexcept
+		{
+			return ((m_bufferPos <= pos) && (pos < (m_bufferPos + m_bufferSize)));
+		}
+
+		/// @brief 指定した位置からバッファに読み込みます。
+		/// @return 1 バイト以上読み込めた場合 true, ファイルの終端に達している場合は false
+		bool fillBuffer(const std::int64_t pos)
+		{
+			if (m_buffer.empty())
+			{
+				m_buffer.resize(BufferSize);
+			}
+
+			m_bufferPos = pos;
+			m_bufferSize = readAt(pos, m_buffer.data(), BufferSize);
+
+			return (0 < m_bufferSize);
+		}
 	};
 
 	BinaryFileReader::BinaryFileReader()
@@ -150,6 +378,31 @@ namespace mini
 		return m_pImpl->read(data, size);
 	}
 
+	std::int64_t BinaryFileReader::readAt(const std::int64_t offset, void* data, const size_t size) const
+	{
+		return m_pImpl->readAt(offset, data, size);
+	}
+
+	std::int64_t BinaryFileReader::peek(void* data, const size_t size)
+	{
+		return m_pImpl->peek(data, size);
+	}
+
+	bool BinaryFileReader::seek(const std::int64_t pos)
+	{
+		return m_pImpl->seek(pos);
+	}
+
+	bool BinaryFileReader::skip(const std::int64_t offset)
+	{
+		return m_pImpl->skip(offset);
+	}
+
+	std::int64_t BinaryFileReader::tell() const noexcept
+	{
+		return m_pImpl->tell();
+	}
+
 	const std::string& BinaryFileReader::fullPath() const noexcept
 	{
 		return m_pImpl->fullPath();
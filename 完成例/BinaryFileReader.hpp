@@ -4,10 +4,12 @@
 #include <string_view>	// std::string_view
 #include <string>		// std::string
 #include <type_traits>	// std::is_trivially_copyable_v
+#include <span>			// std::span
 
 namespace mini
 {
 	/// @brief バイナリファイルを読み込むクラス
+	/// @remark 内部のバッファにまとめて読み込むため、小さなデータを何度も読み込んでも高速です。
 	class BinaryFileReader
 	{
 	public:
@@ -53,6 +55,35 @@ namespace mini
 		/// @return 読み込んだバイト数
 		std::int64_t read(void* data, size_t size);
 
+		/// @brief 読み込み位置を進めずに、ファイルからデータを読み込みます。
+		/// @param data 読み込んだデータを格納するバッファ
+		/// @param size データのサイズ（バイト）
+		/// @return 読み込んだバイト数
+		std::int64_t peek(void* data, size_t size);
+
+		/// @brief 読み込み位置を変更します。
+		/// @param pos 新しい読み込み位置（ファイル先頭からのバイト数）
+		/// @return 変更に成功した場合 true, それ以外の場合は false
+		bool seek(std::int64_t pos);
+
+		/// @brief 読み込み位置を進めます。
+		/// @param offset 進めるバイト数（負の場合は戻す）
+		/// @return 変更に成功した場合 true, それ以外の場合は false
+		bool skip(std::int64_t offset);
+
+		/// @brief 現在の読み込み位置を返します。
+		/// @return 現在の読み込み位置（ファイル先頭からのバイト数）
+		[[nodiscard]]
+		std::int64_t tell() const noexcept;
+
+		/// @brief ファイルの指定した位置からデータを読み込みます。読み込み位置は変更しません。
+		/// @param offset 読み込みを開始する位置（ファイル先頭からのバイト数）
+		/// @param data 読み込んだデータを格納するバッファ
+		/// @param size データのサイズ（バイト）
+		/// @return 読み込んだバイト数
+		/// @remark 読み込み位置を共有しないため、複数のスレッドから同時に呼び出せます。
+		std::int64_t readAt(std::int64_t offset, void* data, size_t size) const;
+
 		/// @brief ファイルからデータを読み込みます。
 		/// @tparam T 読み込むデータの型
 		/// @param data 読み込んだデータを格納する変数
@@ -64,6 +95,26 @@ namespace mini
 			return read(std::addressof(data), sizeof(T));
 		}
 
+		/// @brief ファイルからデータの配列をまとめて読み込みます。
+		/// @tparam T 読み込むデータの型
+		/// @param data 読み込んだデータを格納する配列
+		/// @return 読み込んだバイト数
+		template <class T> requires std::is_trivially_copyable_v<T>
+		std::int64_t read(std::span<T> data)
+		{
+			return read(data.data(), data.size_bytes());
+		}
+
+		/// @brief 読み込み位置を進めずに、ファイルからデータを読み込みます。
+		/// @tparam T 読み込むデータの型
+		/// @param data 読み込んだデータを格納する変数
+		/// @return 読み込んだバイト数
+		template <class T> requires std::is_trivially_copyable_v<T>
+		std::int64_t peek(T& data)
+		{
+			return peek(std::addressof(data), sizeof(T));
+		}
+
 		/// @brief ファイルの絶対パスを返します。
 		/// @return ファイルの絶対パス。ファイルがオープンされていない場合は空文字列
 		[[nodiscard]]
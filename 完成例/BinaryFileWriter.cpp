@@ -1,9 +1,274 @@
-﻿#include <fstream>		// std::ofstream
-#include <filesystem>	// std::filesystem::absolute
+﻿#include <algorithm>		// std::min
+#include <filesystem>		// std::filesystem::absolute, std::filesystem::rename, std::filesystem::remove
+#include <random>			// std::random_device, std::mt19937_64
+#include <system_error>		// std::error_code
 #include "BinaryFileWriter.hpp"
 
+#if defined(_WIN32)
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <Windows.h>
+#else
+	#include <fcntl.h>		// ::open, ::posix_fallocate
+	#include <cerrno>		// errno, EEXIST
+	#include <unistd.h>		// ::pwrite, ::ftruncate, ::fsync, ::close
+	#include <sys/uio.h>	// ::pwritev
+	#include <climits>		// IOV_MAX
+	#include <vector>		// std::vector
+#endif
+
 namespace mini
 {
+	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+	namespace
+	{
+	#if defined(_WIN32)
+
+		/// @brief ファイルのハンドルの型
+		using FileHandle = HANDLE;
+
+		/// @brief 無効なファイルのハンドル
+		const FileHandle InvalidFileHandle = INVALID_HANDLE_VALUE;
+
+		[[nodiscard]]
+		FileHandle CreateNewFile(const std::filesystem::path& path) noexcept
+		{
+			return ::CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr,
+				CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		}
+
+		/// @brief ファイルが存在しない場合のみ、ファイルを作成してオープンします。
+		/// @param alreadyExists ファイルがすでに存在したために失敗した場合 true
+		[[nodiscard]]
+		FileHandle CreateExclusiveFile(const std::filesystem::path& path, bool& alreadyExists) noexcept
+		{
+			const FileHandle file = ::CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr,
+				CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+			alreadyExists = ((file == INVALID_HANDLE_VALUE) && (::GetLastError() == ERROR_FILE_EXISTS));
+			return file;
+		}
+
+		void CloseFile(const FileHandle file) noexcept
+		{
+			::CloseHandle(file);
+		}
+
+		/// @brief ファイルの指定した位置に書き込みます。
+		/// @return 書き込んだバイト数。失敗した場合は -1
+		[[nodiscard]]
+		std::int64_t WriteFileChunkAt(const FileHandle file, const std::int64_t offset, const void* data, const std::size_t size) noexcept
+		{
+			OVERLAPPED overlapped{};
+			overlapped.Offset = static_cast<DWORD>(offset);
+			overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+			DWORD numWritten = 0;
+			const DWORD chunk = static_cast<DWORD>(std::min<std::size_t>(size, 0x40000000));
+			return (::WriteFile(file, data, chunk, &numWritten, &overlapped) ? numWritten : -1);
+		}
+
+		/// @brief 複数のデータを、ファイルの指定した位置から続けて書き込みます。
+		/// @return 書き込んだバイト数
+		/// @remark Windows の WriteFileGather はページ境界に揃ったバッファしか扱えないため、1 つずつ書き込みます。
+		[[nodiscard]]
+		std::int64_t WriteFileGatherAt(const FileHandle file, const std::int64_t offset, const std::span<const std::span<const std::byte>> buffers) noexcept
+		{
+			std::int64_t total = 0;
+
+			for (const auto& buffer : buffers)
+			{
+				std::size_t written = 0;
+
+				while (written < buffer.size())
+				{
+					const std::int64_t n = WriteFileChunkAt(file, (offset + total), (buffer.data() + written), (buffer.size() - written));
+
+					if (n <= 0)
+					{
+						return total;
+					}
+
+					written += n;
+					total += n;
+				}
+			}
+
+			return total;
+		}
+
+		/// @brief ファイルのサイズを変更して、領域を確保します。
+		[[nodiscard]]
+		bool PreallocateFile(const FileHandle file, const std::int64_t size) noexcept
+		{
+			FILE_END_OF_FILE_INFO info{};
+			info.EndOfFile.QuadPart = size;
+			return ::SetFileInformationByHandle(file, FileEndOfFileInfo, &info, sizeof(info));
+		}
+
+		/// @brief ファイルの内容をディスクに反映します。
+		[[nodiscard]]
+		bool FlushFile(const FileHandle file) noexcept
+		{
+			return ::FlushFileBuffers(file);
+		}
+
+	#else
+
+		/// @brief ファイルのハンドルの型
+		using FileHandle = int;
+
+		/// @brief 無効なファイルのハンドル
+		constexpr FileHandle InvalidFileHandle = -1;
+
+		[[nodiscard]]
+		FileHandle CreateNewFile(const std::filesystem::path& path) noexcept
+		{
+			return ::open(path.c_str(), (O_WRONLY | O_CREAT | O_TRUNC), 0644);
+		}
+
+		/// @brief ファイルが存在しない場合のみ、ファイルを作成してオープンします。
+		/// @param alreadyExists ファイルがすでに存在したために失敗した場合 true
+		[[nodiscard]]
+		FileHandle CreateExclusiveFile(const std::filesystem::path& path, bool& alreadyExists) noexcept
+		{
+			const FileHandle file = ::open(path.c_str(), (O_WRONLY | O_CREAT | O_EXCL), 0644);
+			alreadyExists = ((file == -1) && (errno == EEXIST));
+			return file;
+		}
+
+		void CloseFile(const FileHandle file) noexcept
+		{
+			::close(file);
+		}
+
+		/// @brief ファイルの指定した位置に書き込みます。
+		/// @return 書き込んだバイト数。失敗した場合は -1
+		[[nodiscard]]
+		std::int64_t WriteFileChunkAt(const FileHandle file, const std::int64_t offset, const void* data, const std::size_t size) noexcept
+		{
+			return ::pwrite(file, data, size, static_cast<off_t>(offset));
+		}
+
+		/// @brief 複数のデータを、ファイルの指定した位置から続けて書き込みます。
+		/// @return 書き込んだバイト数
+		[[nodiscard]]
+		std::int64_t WriteFileGatherAt(const FileHandle file, const std::int64_t offset, const std::span<const std::span<const std::byte>> buffers)
+		{
+			std::vector<::iovec> iov;
+			iov.reserve(buffers.size());
+
+			for (const auto& buffer : buffers)
+			{
+				if (!buffer.empty())
+				{
+					iov.push_back({ const_cast<std::byte*>(buffer.data()), buffer.size() });
+				}
+			}
+
+			std::int64_t total = 0;
+			std::size_t first = 0;
+
+			// 一度に書き込めるとは限らないので、すべて書き込むまで繰り返す
+			while (first < iov.size())
+			{
+				const int count = static_cast<int>(std::min<std::size_t>((iov.size() - first), IOV_MAX));
+				const ::ssize_t n = ::pwritev(file, (iov.data() + first), count, static_cast<off_t>(offset + total));
+
+				if (n <= 0)
+				{
+					break;
+				}
+
+				total += n;
+
+				// 書き込み済みの分だけ先へ進める
+				std::size_t rest = static_cast<std::size_t>(n);
+
+				while ((first < iov.size()) && (iov[first].iov_len <= rest))
+				{
+					rest -= iov[first].iov_len;
+					++first;
+				}
+
+				if (rest != 0)
+				{
+					iov[first].iov_base = (static_cast<char*>(iov[first].iov_base) + rest);
+					iov[first].iov_len -= rest;
+				}
+			}
+
+			return total;
+		}
+
+		/// @brief ファイルのサイズを変更して、領域を確保します。
+		[[nodiscard]]
+		bool PreallocateFile(const FileHandle file, const std::int64_t size) noexcept
+		{
+		#if defined(__linux__)
+			// ディスク上の領域を実際に確保する
+			if (::posix_fallocate(file, 0, static_cast<off_t>(size)) == 0)
+			{
+				return true;
+			}
+		#endif
+			// 確保できない場合は、サイズの変更のみ行う
+			return (::ftruncate(file, static_cast<off_t>(size)) == 0);
+		}
+
+		/// @brief ファイルの内容をディスクに反映します。
+		[[nodiscard]]
+		bool FlushFile(const FileHandle file) noexcept
+		{
+			return (::fsync(file) == 0);
+		}
+
+	#endif
+
+		/// @brief 一時ファイルを、他のファイルと重ならない名前で作成してオープンします。
+		/// @param path 最終的なファイルのパス
+		/// @param tempPath 作成した一時ファイルのパスの格納先
+		/// @return 一時ファイルのハンドル。作成できなかった場合は `InvalidFileHandle`
+		/// @remark rename で置き換えられるよう、同じディレクトリに `path` + ".<ランダムな 16 文字>.tmp" という名前で作ります。
+		/// 既存のファイルを上書きしないよう排他的に作成し、名前が重なった場合は別の名前で作り直します。
+		[[nodiscard]]
+		FileHandle CreateTemporaryFile(const std::filesystem::path& path, std::filesystem::path& tempPath)
+		{
+			constexpr int MaxAttempts = 100;
+			constexpr char Digits[] = "0123456789abcdef";
+			thread_local std::mt19937_64 rng{ std::random_device{}() };
+
+			for (int attempt = 0; attempt < MaxAttempts; ++attempt)
+			{
+				std::uint64_t bits = rng();
+				std::string suffix = ".";
+
+				for (int i = 0; i < 16; ++i)
+				{
+					suffix += Digits[bits & 0xF];
+					bits >>= 4;
+				}
+
+				tempPath = path;
+				tempPath += (suffix + ".tmp");
+
+				bool alreadyExists = false;
+				const FileHandle file = CreateExclusiveFile(tempPath, alreadyExists);
+
+				// 名前が重なった場合以外の失敗は、作り直しても成功しない
+				if ((file != InvalidFileHandle) || (!alreadyExists))
+				{
+					return file;
+				}
+			}
+
+			return InvalidFileHandle;
+		}
+	}
+
 	class BinaryFileWriter::Impl
 	{
 	public:
@@ -18,28 +283,33 @@ namespace mini
 		[[nodiscard]]
 		bool isOpen() const noexcept
 		{
-			return m_file.is_open();
+			return (m_file != InvalidFileHandle);
 		}
 
-		bool open(const std::string_view path)
+		bool open(const std::string_view path, const WriteMode mode)
 		{
 			// すでにオープンされている場合はクローズする
-			if (m_file.is_open())
+			if (isOpen())
 			{
 				close();
 			}
 
-			// ファイルをバイナリモードでオープンする
-			m_file.open(path, std::ios::binary);
+			// ファイルを作成してオープンする（Atomic の場合は一時ファイルに書き出す）
+			const std::filesystem::path filePath{ path };
+			m_mode = mode;
+			m_filePath = filePath;
+			m_file = ((mode == WriteMode::Atomic) ? CreateTemporaryFile(filePath, m_tempPath) : CreateNewFile(filePath));
 
 			// オープンに失敗した場合は false を返す
-			if (!m_file.is_open())
+			if (!isOpen())
 			{
+				m_filePath.clear();
+				m_tempPath.clear();
 				return false;
 			}
 
 			// ファイルの絶対パスを取得して記録する
-			m_fullPath = std::filesystem::absolute(path).string();
+			m_fullPath = std::filesystem::absolute(filePath).string();
 
 			return true;
 		}
@@ -47,15 +317,116 @@ namespace mini
 		void close()
 		{
 			// ファイルをクローズする
-			m_file.close();
+			if (isOpen())
+			{
+				CloseFile(m_file);
+				m_file = InvalidFileHandle;
+
+				// 確定していない一時ファイルは削除する
+				if (m_mode == WriteMode::Atomic)
+				{
+					std::error_code ec;
+					std::filesystem::remove(m_tempPath, ec);
+				}
+			}
 
 			// 記録していたファイルの絶対パスをクリアする
+			m_filePath.clear();
+			m_tempPath.clear();
 			m_fullPath.clear();
+			m_pos = 0;
 		}
 
-		void write(const void* data, const size_t size)
+		bool commit()
 		{
-			m_file.write(static_cast<const char*>(data), size);
+			if (!isOpen())
+			{
+				return false;
+			}
+
+			if (m_mode == WriteMode::Direct)
+			{
+				close();
+				return true;
+			}
+
+			// 内容をディスクに反映してから、一時ファイルを最終的なファイルに置き換える
+			const bool flushed = FlushFile(m_file);
+			CloseFile(m_file);
+			m_file = InvalidFileHandle;
+
+			std::error_code ec;
+
+			if (flushed)
+			{
+				std::filesystem::rename(m_tempPath, m_filePath, ec);
+			}
+
+			// 失敗した場合は一時ファイルを削除する
+			if ((!flushed) || ec)
+			{
+				std::filesystem::remove(m_tempPath, ec);
+				close();
+				return false;
+			}
+
+			close();
+			return true;
+		}
+
+		bool preallocate(const std::int64_t size)
+		{
+			if ((!isOpen()) || (size < 0))
+			{
+				return false;
+			}
+
+			return PreallocateFile(m_file, size);
+		}
+
+		std::int64_t write(const void* data, const size_t size)
+		{
+			// 書き込み位置は自前で管理し、位置を指定して書き込む
+			const std::int64_t numWritten = writeAt(m_pos, data, size);
+			m_pos += numWritten;
+			return numWritten;
+		}
+
+		std::int64_t write(const std::span<const std::span<const std::byte>> buffers)
+		{
+			if (!isOpen())
+			{
+				return 0;
+			}
+
+			const std::int64_t numWritten = WriteFileGatherAt(m_file, m_pos, buffers);
+			m_pos += numWritten;
+			return numWritten;
+		}
+
+		std::int64_t writeAt(const std::int64_t offset, const void* data, const size_t size) const
+		{
+			if ((!isOpen()) || (offset < 0))
+			{
+				return 0;
+			}
+
+			// 一度に書き込めるとは限らないので、すべて書き込むまで繰り返す
+			std::int64_t total = 0;
+
+			while (total < static_cast<std::int64_t>(size))
+			{
+				const std::int64_t n = WriteFileChunkAt(m_file, (offset + total), (static_cast<const char*>(data) + total), (size - total));
+
+				if (n <= 0)
+				{
+					break;
+				}
+
+				total += n;
+			}
+
+			return total;
 		}
 
 		[[nodiscard]]
@@ -66,8 +437,20 @@ namespace mini
 
 	private:
 
-		/// @brief ファイル出力ストリーム
-		std::ofstream m_file;
+		/// @brief ファイルのハンドル
+		FileHandle m_file = InvalidFileHandle;
+
+		/// @brief 書き込み位置（ファイル先頭からのバイト数）
+		std::int64_t m_pos = 0;
+
+		/// @brief ファイルの書き出し方法
+		WriteMode m_mode = WriteMode::Direct;
+
+		/// @brief 最終的なファイルのパス
+		std::filesystem::path m_filePath;
+
+		/// @brief 一時ファイルのパス（`WriteMode::Atomic` の場合）
+		std::filesystem::path m_tempPath;
 
 		/// @brief ファイルの絶対パス
 		std::string m_fullPath;
@@ -76,10 +459,10 @@ namespace mini
 	BinaryFileWriter::BinaryFileWriter()
 		: m_pImpl{ std::make_shared<Impl>() } {}
 
-	BinaryFileWriter::BinaryFileWriter(const std::string_view path)
+	BinaryFileWriter::BinaryFileWriter(const std::string_view path, const WriteMode mode)
 		: BinaryFileWriter{} // 移譲コンストラクタ
 	{
-		m_pImpl->open(path);
+		m_pImpl->open(path, mode);
 	}
 
 	BinaryFileWriter::~BinaryFileWriter() = default;
@@ -94,9 +477,9 @@ namespace mini
 		return m_pImpl->isOpen();
 	}
 
-	bool BinaryFileWriter::open(const std::string_view path)
+	bool BinaryFileWriter::open(const std::string_view path, const WriteMode mode)
 	{
-		return m_pImpl->open(path);
+		return m_pImpl->open(path, mode);
 	}
 
 	void BinaryFileWriter::close()
@@ -104,13 +487,33 @@ namespace mini
 		m_pImpl->close();
 	}
 
+	bool BinaryFileWriter::commit()
+	{
+		return m_pImpl->commit();
+	}
+
+	bool BinaryFileWriter::preallocate(const std::int64_t size)
+	{
+		return m_pImpl->preallocate(size);
+	}
+
 	const std::string& BinaryFileWriter::fullPath() const noexcept
 	{
 		return m_pImpl->fullPath();
 	}
 
-	void BinaryFileWriter::write(const void* data, const size_t size)
+	std::int64_t BinaryFileWriter::write(const void* data, const size_t size)
+	{
+		return m_pImpl->write(data, size);
+	}
+
+	std::int64_t BinaryFileWriter::write(const std::span<const std::span<const std::byte>> buffers)
+	{
+		return m_pImpl->write(buffers);
+	}
+
+	std::int64_t BinaryFileWriter::writeAt(const std::int64_t offset, const void* data, const size_t size) const
 	{
-		m_pImpl->write(data, size);
+		return m_pImpl->writeAt(offset, data, size);
 	}
 }
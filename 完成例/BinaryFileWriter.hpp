@@ -1,11 +1,25 @@
 ﻿#pragma once
 #include <memory>		// std::shared_ptr, std::addressof
+#include <cstdint>		// std::int64_t
+#include <cstddef>		// std::byte
+#include <span>			// std::span
 #include <string_view>	// std::string_view
 #include <string>		// std::string
-#include <type_traits>	// std::is_trivially_copyable_v
+#include <type_traits>	// std::is_trivially_copyable_v, std::is_convertible_v
 
 namespace mini
 {
+	/// @brief ファイルの書き出し方法
+	enum class WriteMode
+	{
+		/// @brief 指定したファイルに直接書き出す
+		Direct,
+
+		/// @brief 一時ファイルに書き出し、`commit()` で指定したファイルに置き換える
+		/// @remark 書き出し途中のファイルが他から見えることはありません。
+		Atomic,
+	};
+
 	/// @brief バイナリファイルを書き出すクラス
 	class BinaryFileWriter
 	{
@@ -17,8 +31,9 @@ namespace mini
 
 		/// @brief ファイルを作成してオープンします。
 		/// @param path ファイルパス
+		/// @param mode ファイルの書き出し方法
 		[[nodiscard]]
-		explicit BinaryFileWriter(std::string_view path);
+		explicit BinaryFileWriter(std::string_view path, WriteMode mode = WriteMode::Direct);
 		
 		/// @brief デストラクタ
 		~BinaryFileWriter();
@@ -35,25 +50,57 @@ namespace mini
 
 		/// @brief ファイルをオープンします。すでにオープンされている場合はクローズしてから再オープンします。
 		/// @param path ファイルパス
+		/// @param mode ファイルの書き出し方法
 		/// @return オープンに成功した場合 true, それ以外の場合は false
-		bool open(std::string_view path);
+		/// @remark `WriteMode::Atomic` の場合は、同じディレクトリに `path` + ".<ランダムな 16 文字>.tmp" という一時ファイルを、既存のファイルと重ならないよう作成します。
+		bool open(std::string_view path, WriteMode mode = WriteMode::Direct);
 
 		/// @brief ファイルをクローズします。
+		/// @remark `WriteMode::Atomic` で `commit()` していない場合は、一時ファイルを削除し、指定したファイルは変更しません。
 		void close();
 
+		/// @brief 書き出しを確定して、ファイルをクローズします。
+		/// @return 確定に成功した場合 true, それ以外の場合は false
+		/// @remark `WriteMode::Atomic` の場合は、一時ファイルの内容をディスクに反映してから、指定したファイルに置き換えます。
+		bool commit();
+
+		/// @brief ファイルの領域をあらかじめ確保します。
+		/// @param size 確保するファイルのサイズ（バイト）
+		/// @return 確保に成功した場合 true, それ以外の場合は false
+		/// @remark 最終的なサイズがわかっている場合に呼び出すと、書き込み時の領域の拡張や断片化を減らせます。
+		bool preallocate(std::int64_t size);
+
 		/// @brief ファイルにデータを書き込みます。
 		/// @param data 書き込むデータ
 		/// @param size データのサイズ（バイト）
-		void write(const void* data, size_t size);
+		/// @return 書き込んだバイト数
+		std::int64_t write(const void* data, size_t size);
+
+		/// @brief 複数のデータを、まとめてファイルに書き込みます。
+		/// @param buffers 書き込むデータの配列
+		/// @return 書き込んだバイト数
+		/// @remark 可能な場合は、1 回のシステムコール（`pwritev`）で書き込みます。
+		std::int64_t write(std::span<const std::span<const std::byte>> buffers);
+
+		/// @brief ファイルの指定した位置にデータを書き込みます。書き込み位置は変更しません。
+		/// @param offset 書き込みを開始する位置（ファイル先頭からのバイト数）
+		/// @param data 書き込むデータ
+		/// @param size データのサイズ（バイト）
+		/// @return 書き込んだバイト数
+		/// @remark 書き込み位置を共有しないため、複数のスレッドから同時に呼び出せます。
+		std::int64_t writeAt(std::int64_t offset, const void* data, size_t size) const;
 
 		/// @brief ファイルにデータを書き込みます。
 		/// @tparam T 書き込むデータの型
 		/// @param data 書き込むデータ
+		/// @return 書き込んだバイト数
+		/// @remark データの配列（`std::span<const std::byte>` の配列）は、まとめて書き込む `write()` が呼ばれます。
 		template <class T> requires std::is_trivially_copyable_v<T> // 関数テンプレートに対する制約（T は trivially copyable でなければならない）
-		void write(const T& data)
+			&& (!std::is_convertible_v<const T&, std::span<const std::span<const std::byte>>>)
+		std::int64_t write(const T& data)
 		{
 			// & 演算子のオーバーロード対策で std::addressof を使用
-			write(std::addressof(data), sizeof(T));
+			return write(std::addressof(data), sizeof(T));
 		}
 
 		/// @brief ファイルの絶対パスを返します。
@@ -0,0 +1,428 @@
+﻿#include <algorithm>		// std::max, std::min
+#include <cstdint>			// std::uint32_t
+#include "Blend.hpp"
+#include "Parallel.hpp"		// mini::ParallelOptions, mini::ParallelForBands
+#include "CPUFeatures.hpp"	// mini::GetCPUFeatures, MINI_TARGET
+
+#if MINI_ARCH_X86
+	#include <immintrin.h>
+#endif
+
+namespace mini
+{
+	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+	namespace
+	{
+		// 合成はすべて 8 ビット整数のまま計算する。
+		// x × y / 255 は (t + (t >> 8)) >> 8（t = x × y + 128）で、割り算を使わずに正しく四捨五入できる。
+		// t の最大値は 65153 なので、SIMD 版でも 16 ビット整数に収まる。
+		// スカラー版と SIMD 版は同じ式を使うので、結果は完全に一致する。
+
+		/// @brief x × y / 255 を四捨五入した値を返します。
+		[[nodiscard]]
+		constexpr std::uint32_t Mul255(const std::uint32_t x, const std::uint32_t y) noexcept
+		{
+			const std::uint32_t t = (x * y + 128);
+			return ((t + (t >> 8)) >> 8);
+		}
+
+		/// @brief 1 つの成分を合成します。
+		/// @param s 上に重ねる色の成分
+		/// @param d 下の色の成分
+		/// @param sa 上に重ねる色の不透明度
+		/// @param da 下の色の不透明度
+		template <BlendMode Mode>
+		[[nodiscard]]
+		constexpr std::uint8_t BlendChannel(const std::uint32_t s, const std::uint32_t d, const std::uint32_t sa, const std::uint32_t da) noexcept
+		{
+			std::uint32_t result;
+
+			if constexpr (Mode == BlendMode::Over)
+			{
+				result = (s + Mul255(d, (255 - sa)));
+			}
+			else if constexpr (Mode == BlendMode::Add)
+			{
+				result = (s + d);
+			}
+			else if constexpr (Mode == BlendMode::Multiply)
+			{
+				result = (Mul255(s, d) + Mul255(s, (255 - da)) + Mul255(d, (255 - sa)));
+			}
+			else
+			{
+				result = (s + d - Mul255(s, d));
+			}
+
+			return static_cast<std::uint8_t>(std::min<std::uint32_t>(result, 255));
+		}
+
+		/// @brief 1 ピクセルを合成します。不透明度も色成分と同じ式で合成します。
+		template <BlendMode Mode>
+		[[nodiscard]]
+		constexpr ColorA8 BlendPixel(const ColorA8& s, const ColorA8& d) noexcept
+		{
+			return{ BlendChannel<Mode>(s.r, d.r, s.a, d.a),
+				BlendChannel<Mode>(s.g, d.g, s.a, d.a),
+				BlendChannel<Mode>(s.b, d.b, s.a, d.a),
+				BlendChannel<Mode>(s.a, d.a, s.a, d.a) };
+		}
+
+		template <BlendMode Mode>
+		void CompositeRowScalar(const ColorA8* src, ColorA8* dst, const int width, int x) noexcept
+		{
+			for (; x < width; ++x)
+			{
+				dst[x] = BlendPixel<Mode>(src[x], dst[x]);
+			}
+		}
+
+		void PremultiplyRowScalar(const ColorA8* src, ColorA8* dst, const int width, int x) noexcept
+		{
+			for (; x < width; ++x)
+			{
+				dst[x] = src[x].premultiplied();
+			}
+		}
+
+	#if MINI_ARCH_X86
+
+		// SIMD 版は、各成分を 16 ビット整数に広げて計算し、飽和付きで 8 ビット整数に戻す。
+		// 1 ピクセルは 16 ビット整数 4 個（青、緑、赤、不透明度）になり、不透明度は各ピクセルの 4 番目の要素にある。
+
+		/// @brief 16 ビット整数の各要素について、x × y / 255 を四捨五入した値を返します。
+		MINI_TARGET("sse4.1")
+		inline __m128i Mul255(const __m128i x, const __m128i y) noexcept
+		{
+			const __m128i t = _mm_add_epi16(_mm_mullo_epi16(x, y), _mm_set1_epi16(128));
+			return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+		}
+
+		/// @brief 各ピクセルの不透明度を、そのピクセルの 4 つの要素すべてに複製します。
+		MINI_TARGET("sse4.1")
+		inline __m128i BroadcastAlpha(const __m128i x) noexcept
+		{
+			return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		}
+
+		/// @brief 16 ビット整数に広げた 2 ピクセルを合成します。
+		template <BlendMode Mode>
+		MINI_TARGET("sse4.1")
+		inline __m128i Blend16(const __m128i s, const __m128i d) noexcept
+		{
+			const __m128i c255 = _mm_set1_epi16(255);
+
+			if constexpr (Mode == BlendMode::Over)
+			{
+				return _mm_add_epi16(s, Mul255(d, _mm_sub_epi16(c255, BroadcastAlpha(s))));
+			}
+			else if constexpr (Mode == BlendMode::Multiply)
+			{
+				const __m128i sd = Mul255(s, d);
+				const __m128i sInvDa = Mul255(s, _mm_sub_epi16(c255, BroadcastAlpha(d)));
+				const __m128i dInvSa = Mul255(d, _mm_sub_epi16(c255, BroadcastAlpha(s)));
+				return _mm_add_epi16(_mm_add_epi16(sd, sInvDa), dInvSa);
+			}
+			else
+			{
+				return _mm_sub_epi16(_mm_add_epi16(s, d), Mul255(s, d));
+			}
+		}
+
+		template <BlendMode Mode>
+		MINI_TARGET("sse4.1")
+		void CompositeRowSSE41(const ColorA8* src, ColorA8* dst, const int width) noexcept
+		{
+			const __m128i zero = _mm_setzero_si128();
+			int x = 0;
+
+			// 4 ピクセルずつ処理する
+			for (; (x + 4) <= width; x += 4)
+			{
+				const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+				const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + x));
+				__m128i result;
+
+				if constexpr (Mode == BlendMode::Add)
+				{
+					// 加算は 8 ビット整数のまま飽和加算できる
+					result = _mm_adds_epu8(s, d);
+				}
+				else
+				{
+					const __m128i lo = Blend16<Mode>(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+					const __m128i hi = Blend16<Mode>(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+					result = _mm_packus_epi16(lo, hi);
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), result);
+			}
+
+			CompositeRowScalar<Mode>(src, dst, width, x);
+		}
+
+		MINI_TARGET("sse4.1")
+		void PremultiplyRowSSE41(const ColorA8* src, ColorA8* dst, const int width) noexcept
+		{
+			const __m128i zero = _mm_setzero_si128();
+			int x = 0;
+
+			for (; (x + 4) <= width; x += 4)
+			{
+				const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+				const __m128i lo = _mm_unpacklo_epi8(s, zero);
+				const __m128i hi = _mm_unpackhi_epi8(s, zero);
+
+				// 不透明度の要素には 255 を掛けて、値を変えない
+				const __m128i aLo = _mm_blend_epi16(BroadcastAlpha(lo), _mm_set1_epi16(255), 0x88);
+				const __m128i aHi = _mm_blend_epi16(BroadcastAlpha(hi), _mm_set1_epi16(255), 0x88);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(Mul255(lo, aLo), Mul255(hi, aHi)));
+			}
+
+			PremultiplyRowScalar(src, dst, width, x);
+		}
+
+		/// @brief 16 ビット整数の各要素について、x × y / 255 を四捨五入した値を返します。
+		MINI_TARGET("avx2")
+		inline __m256i Mul255(const __m256i x, const __m256i y) noexcept
+		{
+			const __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(x, y), _mm256_set1_epi16(128));
+			return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+		}
+
+		/// @brief 各ピクセルの不透明度を、そのピクセルの 4 つの要素すべてに複製します。
+		MINI_TARGET("avx2")
+		inline __m256i BroadcastAlpha(const __m256i x) noexcept
+		{
+			return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		}
+
+		/// @brief 16 ビット整数に広げた 4 ピクセルを合成します。
+		template <BlendMode Mode>
+		MINI_TARGET("avx2")
+		inline __m256i Blend16(const __m256i s, const __m256i d) noexcept
+		{
+			const __m256i c255 = _mm256_set1_epi16(255);
+
+			if constexpr (Mode == BlendMode::Over)
+			{
+				return _mm256_add_epi16(s, Mul255(d, _mm256_sub_epi16(c255, BroadcastAlpha(s))));
+			}
+			else if constexpr (Mode == BlendMode::Multiply)
+			{
+				const __m256i sd = Mul255(s, d);
+				const __m256i sInvDa = Mul255(s, _mm256_sub_epi16(c255, BroadcastAlpha(d)));
+				const __m256i dInvSa = Mul255(d, _mm256_sub_epi16(c255, BroadcastAlpha(s)));
+				return _mm256_add_epi16(_mm256_add_epi16(sd, sInvDa), dInvSa);
+			}
+			else
+			{
+				return _mm256_sub_epi16(_mm256_add_epi16(s, d), Mul255(s, d));
+			}
+		}
+
+		template <BlendMode Mode>
+		MINI_TARGET("avx2")
+		void CompositeRowAVX2(const ColorA8* src, ColorA8* dst, const int width) noexcept
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			int x = 0;
+
+			// 8 ピクセルずつ処理する（unpack と pack はどちらも 128 ビット単位なので、ピクセルの並びは保たれる）
+			for (; (x + 8) <= width; x += 8)
+			{
+				const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x));
+				const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + x));
+				__m256i result;
+
+				if constexpr (Mode == BlendMode::Add)
+				{
+					// 加算は 8 ビット整数のまま飽和加算できる
+					result = _mm256_adds_epu8(s, d);
+				}
+				else
+				{
+					const __m256i lo = Blend16<Mode>(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero));
+					const __m256i hi = Blend16<Mode>(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero));
+					result = _mm256_packus_epi16(lo, hi);
+				}
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x), result);
+			}
+
+			CompositeRowScalar<Mode>(src, dst, width, x);
+		}
+
+		MINI_TARGET("avx2")
+		void PremultiplyRowAVX2(const ColorA8* src, ColorA8* dst, const int width) noexcept
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			int x = 0;
+
+			for (; (x + 8) <= width; x += 8)
+			{
+				const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x));
+				const __m256i lo = _mm256_unpacklo_epi8(s, zero);
+				const __m256i hi = _mm256_unpackhi_epi8(s, zero);
+
+				// 不透明度の要素には 255 を掛けて、値を変えない
+				const __m256i aLo = _mm256_blend_epi16(BroadcastAlpha(lo), _mm256_set1_epi16(255), 0x88);
+				const __m256i aHi = _mm256_blend_epi16(BroadcastAlpha(hi), _mm256_set1_epi16(255), 0x88);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x), _mm256_packus_epi16(Mul255(lo, aLo), Mul255(hi, aHi)));
+			}
+
+			PremultiplyRowScalar(src, dst, width, x);
+		}
+
+	#endif
+
+		template <BlendMode Mode>
+		void CompositeRowDefault(const ColorA8* src, ColorA8* dst, const int width) noexcept
+		{
+			CompositeRowScalar<Mode>(src, dst, width, 0);
+		}
+
+		void PremultiplyRowDefault(const ColorA8* src, ColorA8* dst, const int width) noexcept
+		{
+			PremultiplyRowScalar(src, dst, width, 0);
+		}
+
+		/// @brief 1 行分を処理する関数（src と dst は同じでもよい）
+		using RowFunction = void(*)(const ColorA8*, ColorA8*, int) noexcept;
+
+		/// @brief 実行中の CPU で使える最速の合成関数を選びます。
+		template <BlendMode Mode>
+		[[nodiscard]]
+		RowFunction SelectComposite() noexcept
+		{
+		#if MINI_ARCH_X86
+			const CPUFeatures& features = GetCPUFeatures();
+
+			if (features.avx2)
+			{
+				return CompositeRowAVX2<Mode>;
+			}
+			else if (features.sse41)
+			{
+				return CompositeRowSSE41<Mode>;
+			}
+		#endif
+			return CompositeRowDefault<Mode>;
+		}
+
+		/// @brief 合成する方法に応じた、実行中の CPU で使える最速の合成関数を返します。
+		[[nodiscard]]
+		RowFunction GetCompositeFunction(const BlendMode mode) noexcept
+		{
+			static const RowFunction functions[4] =
+			{
+				SelectComposite<BlendMode::Over>(),
+				SelectComposite<BlendMode::Add>(),
+				SelectComposite<BlendMode::Multiply>(),
+				SelectComposite<BlendMode::Screen>(),
+			};
+
+			return functions[static_cast<int>(mode)];
+		}
+
+		/// @brief 実行中の CPU で使える最速の premultiply 関数を選びます。
+		[[nodiscard]]
+		RowFunction SelectPremultiply() noexcept
+		{
+		#if MINI_ARCH_X86
+			const CPUFeatures& features = GetCPUFeatures();
+
+			if (features.avx2)
+			{
+				return PremultiplyRowAVX2;
+			}
+			else if (features.sse41)
+			{
+				return PremultiplyRowSSE41;
+			}
+		#endif
+			return PremultiplyRowDefault;
+		}
+
+		/// @brief 1 行あたりのピクセル数に応じた並列処理の設定を返します。
+		/// @remark 1 ピクセルあたりの計算が少なくメモリの速度で律速されるため、小さい画像ではスレッドに分割しない。
+		[[nodiscard]]
+		ParallelOptions MakeOptions(const int width) noexcept
+		{
+			ParallelOptions options;
+			options.minRowsPerBand = std::max(options.minRowsPerBand, ((1 << 16) / std::max(width, 1))); // 1 つの帯あたり 64K ピクセル以上
+			return options;
+		}
+	}
+
+	ImageA8 Premultiply(const ImageA8& image)
+	{
+		static const RowFunction premultiply = SelectPremultiply();
+		ImageA8 result{ image.width(), image.height(), Uninitialized, image.layout() };
+
+		ParallelForBands(image.height(), MakeOptions(image.width()), [&](const int y0, const int y1)
+		{
+			for (int y = y0; y < y1; ++y)
+			{
+				premultiply(image[y], result[y], image.width());
+			}
+		});
+
+		return result;
+	}
+
+	ImageA8 Unpremultiply(const ImageA8& image)
+	{
+		ImageA8 result{ image.width(), image.height(), Uninitialized, image.layout() };
+
+		ParallelForBands(image.height(), MakeOptions(image.width()), [&](const int y0, const int y1)
+		{
+			for (int y = y0; y < y1; ++y)
+			{
+				const ColorA8* src = image[y];
+				ColorA8* dst = result[y];
+
+				for (int x = 0; x < image.width(); ++x)
+				{
+					dst[x] = src[x].unpremultiplied();
+				}
+			}
+		});
+
+		return result;
+	}
+
+	void Composite(ImageA8& dst, const ImageA8& src, const Point& offset, const BlendMode mode)
+	{
+		// 合成先の画像と重なる範囲だけを合成する
+		const Rect region = Rect{ offset.x, offset.y, src.width(), src.height() }.intersection(Rect{ 0, 0, dst.width(), dst.height() });
+
+		if (region.isEmpty())
+		{
+			return;
+		}
+
+		const RowFunction composite = GetCompositeFunction(mode);
+
+		ParallelForBands(region.h, MakeOptions(region.w), [&](const int y0, const int y1)
+		{
+			for (int y = y0; y < y1; ++y)
+			{
+				const int dy = (region.y + y);
+				composite((src[dy - offset.y] + (region.x - offset.x)), (dst[dy] + region.x), region.w);
+			}
+		});
+	}
+
+	ImageA8 Blend(const ImageA8& dst, const ImageA8& src, const BlendMode mode)
+	{
+		if ((dst.width() != src.width()) || (dst.height() != src.height()))
+		{
+			return{};
+		}
+
+		ImageA8 result = dst;
+		Composite(result, src, Point{ 0, 0 }, mode);
+		return result;
+	}
+}
@@ -0,0 +1,52 @@
+﻿#pragma once
+#include "Image.hpp"	// mini::ImageA8
+#include "Point.hpp"	// mini::Point
+
+namespace mini
+{
+	/// @brief 画像を合成する方法
+	/// @remark 色成分にあらかじめ不透明度を掛けた値（premultiplied alpha）に対する式です。s は上に重ねる色、d は下の色、sa, da はそれぞれの不透明度を表します。
+	enum class BlendMode
+	{
+		/// @brief 通常の重ね合わせ（s + d × (1 - sa)）
+		Over,
+
+		/// @brief 加算（s + d）
+		Add,
+
+		/// @brief 乗算（s × d + s × (1 - da) + d × (1 - sa)）
+		Multiply,
+
+		/// @brief スクリーン（s + d - s × d）
+		Screen,
+	};
+
+	/// @brief 色成分に不透明度を掛けた（premultiplied alpha の）画像を返します。
+	/// @param image 元の画像（straight alpha）
+	/// @return 色成分に不透明度を掛けた画像
+	[[nodiscard]]
+	ImageA8 Premultiply(const ImageA8& image);
+
+	/// @brief 色成分を不透明度で割った（straight alpha の）画像を返します。
+	/// @param image 元の画像（premultiplied alpha）
+	/// @return 色成分を不透明度で割った画像。完全に透明なピクセルは透明な黒になります
+	[[nodiscard]]
+	ImageA8 Unpremultiply(const ImageA8& image);
+
+	/// @brief 画像の上に別の画像を合成します。
+	/// @param dst 合成先の画像（premultiplied alpha）
+	/// @param src 上に重ねる画像（premultiplied alpha）
+	/// @param offset 合成先の画像における、上に重ねる画像の左上の位置
+	/// @param mode 合成する方法
+	/// @remark 合成先の画像からはみ出す部分は無視します。
+	/// 各成分は 8 ビット整数のまま計算し、実行中の CPU に応じて AVX2 または SSE4.1 で一度に 8 または 4 ピクセルずつ処理します。
+	void Composite(ImageA8& dst, const ImageA8& src, const Point& offset, BlendMode mode = BlendMode::Over);
+
+	/// @brief 2 つの同じ大きさの画像を合成した画像を返します。
+	/// @param dst 下の画像（premultiplied alpha）
+	/// @param src 上に重ねる画像（premultiplied alpha）
+	/// @param mode 合成する方法
+	/// @return 合成した画像。画像の大きさが異なる場合は空の画像
+	[[nodiscard]]
+	ImageA8 Blend(const ImageA8& dst, const ImageA8& src, BlendMode mode = BlendMode::Over);
+}
@@ -0,0 +1,104 @@
+﻿#include <cstdint>		// std::uint32_t, std::uint64_t
+#include "CPUFeatures.hpp"
+
+#if MINI_ARCH_X86
+	#if defined(_MSC_VER)
+		#include <intrin.h>	// __cpuid, __cpuidex, _xgetbv
+	#else
+		#include <cpuid.h>	// __get_cpuid_count
+	#endif
+#endif
+
+namespace mini
+{
+	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+	namespace
+	{
+	#if MINI_ARCH_X86
+
+		/// @brief CPUID 命令の結果
+		struct CPUIDResult
+		{
+			std::uint32_t eax = 0;
+			std::uint32_t ebx = 0;
+			std::uint32_t ecx = 0;
+			std::uint32_t edx = 0;
+		};
+
+		[[nodiscard]]
+		CPUIDResult CPUID(const std::uint32_t leaf, const std::uint32_t subLeaf) noexcept
+		{
+			CPUIDResult result;
+
+		#if defined(_MSC_VER)
+			int info[4];
+			__cpuidex(info, static_cast<int>(leaf), static_cast<int>(subLeaf));
+			result = { static_cast<std::uint32_t>(info[0]), static_cast<std::uint32_t>(info[1]),
+				static_cast<std::uint32_t>(info[2]), static_cast<std::uint32_t>(info[3]) };
+		#else
+			__get_cpuid_count(leaf, subLeaf, &result.eax, &result.ebx, &result.ecx, &result.edx);
+		#endif
+
+			return result;
+		}
+
+		/// @brief OS がレジスタの保存に対応している状態（XCR0）を返します。
+		[[nodiscard]]
+		std::uint64_t XGETBV() noexcept
+		{
+		#if defined(_MSC_VER)
+			return _xgetbv(0);
+		#else
+			std::uint32_t eax, edx;
+			__asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return ((static_cast<std::uint64_t>(edx) << 32) | eax);
+		#endif
+		}
+
+		[[nodiscard]]
+		CPUFeatures DetectCPUFeatures() noexcept
+		{
+			CPUFeatures features;
+
+			const CPUIDResult leaf0 = CPUID(0, 0);
+			const CPUIDResult leaf1 = CPUID(1, 0);
+
+			features.sse41 = ((leaf1.ecx >> 19) & 1);
+
+			// AVX 系の命令を使うには、OS が YMM / ZMM レジスタを保存してくれる必要がある
+			const bool osxsave = ((leaf1.ecx >> 27) & 1);
+
+			if ((!osxsave) || (leaf0.eax < 7))
+			{
+				return features;
+			}
+
+			const std::uint64_t xcr0 = XGETBV();
+			const bool osAVX = ((xcr0 & 0x06) == 0x06);			// XMM, YMM
+			const bool avx = ((leaf1.ecx >> 28) & 1);			// VEX エンコードの命令（AVX2 の前提）
+			const bool osAVX512 = ((xcr0 & 0xE6) == 0xE6);		// XMM, YMM, opmask, ZMM
+			const CPUIDResult leaf7 = CPUID(7, 0);
+
+			features.avx2 = (osAVX && avx && ((leaf7.ebx >> 5) & 1));
+			features.avx512f = (osAVX512 && features.avx2 && ((leaf7.ebx >> 16) & 1));
+
+			return features;
+		}
+
+	#else
+
+		[[nodiscard]]
+		CPUFeatures DetectCPUFeatures() noexcept
+		{
+			return{};
+		}
+
+	#endif
+	}
+
+	const CPUFeatures& GetCPUFeatures() noexcept
+	{
+		static const CPUFeatures features = DetectCPUFeatures();
+		return features;
+	}
+}
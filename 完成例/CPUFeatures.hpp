@@ -0,0 +1,37 @@
+﻿#pragma once
+
+// x86 / x64 向けのビルドであるか
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define MINI_ARCH_X86 1
+#else
+	#define MINI_ARCH_X86 0
+#endif
+
+// 関数単位で命令セットを指定する属性（MSVC では不要なので空にする）
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define MINI_TARGET(instructionSet)
+#else
+	#define MINI_TARGET(instructionSet) __attribute__((target(instructionSet)))
+#endif
+
+namespace mini
+{
+	/// @brief 実行中の CPU が対応している命令セット
+	struct CPUFeatures
+	{
+		/// @brief SSE4.1 に対応しているか
+		bool sse41 = false;
+
+		/// @brief AVX2 に対応しているか
+		bool avx2 = false;
+
+		/// @brief AVX-512F に対応しているか
+		bool avx512f = false;
+	};
+
+	/// @brief 実行中の CPU が対応している命令セットを返します。
+	/// @return 実行中の CPU が対応している命令セット。OS が対応していない命令セットは false になります
+	/// @remark 初回の呼び出し時に CPU と OS に問い合わせ、以降はその結果を返します。
+	[[nodiscard]]
+	const CPUFeatures& GetCPUFeatures() noexcept;
+}
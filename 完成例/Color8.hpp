@@ -0,0 +1,144 @@
+﻿#pragma once
+#include <cstdint>		// std::uint8_t
+#include <algorithm>	// std::clamp
+#include <iostream>		// std::ostream, std::istream
+#include <format>		// std::formatter
+#include <string_view>	// std::string_view
+#include "Color.hpp"	// mini::Color
+#include "ColorF.hpp"	// mini::ColorF
+
+namespace mini
+{
+	/// @brief 色を表現するクラス（各成分 8 ビット整数）
+	/// @remark BMP ファイルと同じく、メモリ上には青、緑、赤の順に格納します。
+	struct Color8
+	{
+		/// @brief 青成分
+		std::uint8_t b = 0;
+
+		/// @brief 緑成分
+		std::uint8_t g = 0;
+
+		/// @brief 赤成分
+		std::uint8_t r = 0;
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		Color8() = default;
+
+		/// @brief 色を作成します。
+		/// @param _r 赤成分
+		/// @param _g 緑成分
+		/// @param _b 青成分
+		[[nodiscard]]
+		constexpr Color8(std::uint8_t _r, std::uint8_t _g, std::uint8_t _b) noexcept
+			: b{ _b }
+			, g{ _g }
+			, r{ _r } {}
+
+		/// @brief グレースケールの色を作成します。
+		/// @param rgb 赤成分、緑成分、青成分
+		[[nodiscard]]
+		explicit constexpr Color8(std::uint8_t rgb) noexcept
+			: b{ rgb }
+			, g{ rgb }
+			, r{ rgb } {}
+
+		/// @brief `Color` から変換して色を作成します。各成分は 0.0 ～ 1.0 の範囲に丸められます。
+		/// @param color 変換元の色
+		[[nodiscard]]
+		explicit constexpr Color8(const Color& color) noexcept
+			: b{ ToUint8(color.b) }
+			, g{ ToUint8(color.g) }
+			, r{ ToUint8(color.r) } {}
+
+		/// @brief `ColorF` から変換して色を作成します。各成分は 0.0 ～ 1.0 の範囲に丸められます。
+		/// @param color 変換元の色
+		[[nodiscard]]
+		explicit constexpr Color8(const ColorF& color) noexcept
+			: b{ ToUint8(color.b) }
+			, g{ ToUint8(color.g) }
+			, r{ ToUint8(color.r) } {}
+
+		/// @brief `Color` に変換します。
+		/// @return 変換した色
+		[[nodiscard]]
+		constexpr Color toColor() const noexcept
+		{
+			return{ (r / 255.0), (g / 255.0), (b / 255.0) };
+		}
+
+		/// @brief `ColorF` に変換します。
+		/// @return 変換した色
+		[[nodiscard]]
+		constexpr ColorF toColorF() const noexcept
+		{
+			return{ (r / 255.0f), (g / 255.0f), (b / 255.0f) };
+		}
+
+		/// @brief グレースケール値を返します。
+		/// @return グレースケール値（0.0 ～ 1.0）
+		[[nodiscard]]
+		constexpr double grayscale() const noexcept
+		{
+			return toColor().grayscale();
+		}
+
+		[[nodiscard]]
+		friend constexpr bool operator ==(const Color8& lhs, const Color8& rhs) noexcept = default;
+
+		/// @brief 出力ストリームに書き込みます。
+		/// @param os 出力ストリーム
+		/// @param value 書き込む値
+		/// @return 出力ストリーム
+		friend std::ostream& operator <<(std::ostream& os, const Color8& value)
+		{
+			return os << '(' << static_cast<int>(value.r) << ", " << static_cast<int>(value.g) << ", " << static_cast<int>(value.b) << ')';
+		}
+
+		/// @brief 入力ストリームから読み込みます。
+		/// @param is 入力ストリーム
+		/// @param value 読み込んだ値の格納先
+		/// @return 入力ストリーム
+		friend std::istream& operator >>(std::istream& is, Color8& value)
+		{
+			char _; // 区切り文字用
+			int r, g, b;
+			is >> _ >> r >> _ >> g >> _ >> b >> _;
+			value = Color8{ static_cast<std::uint8_t>(r), static_cast<std::uint8_t>(g), static_cast<std::uint8_t>(b) };
+			return is;
+		}
+
+	private:
+
+		/// @brief 0.0 ～ 1.0 の範囲の実数を、8 ビット整数（0 ～ 255）に変換します。
+		/// @param value 変換する値
+		/// @return 変換した値
+		[[nodiscard]]
+		static constexpr std::uint8_t ToUint8(double value) noexcept
+		{
+			return static_cast<std::uint8_t>(std::clamp((value * 255.0 + 0.5), 0.0, 255.0));
+		}
+
+		/// @brief 0.0 ～ 1.0 の範囲の実数を、8 ビット整数（0 ～ 255）に変換します。
+		/// @param value 変換する値
+		/// @return 変換した値
+		[[nodiscard]]
+		static constexpr std::uint8_t ToUint8(float value) noexcept
+		{
+			return static_cast<std::uint8_t>(std::clamp((value * 255.0f + 0.5f), 0.0f, 255.0f));
+		}
+	};
+
+	// Color8 のサイズが 3 バイトであることをコンパイル時にチェック
+	static_assert(sizeof(Color8) == 3, "Color8 size must be 3 bytes");
+}
+
+template <>
+struct std::formatter<mini::Color8> : std::formatter<std::string_view>
+{
+	auto format(const mini::Color8& value, auto& ctx) const
+	{
+		return std::format_to(ctx.out(), "({}, {}, {})", value.r, value.g, value.b);
+	}
+};
@@ -0,0 +1,200 @@
+﻿#pragma once
+#include <cstdint>		// std::uint8_t
+#include <algorithm>	// std::clamp
+#include <iostream>		// std::ostream, std::istream
+#include <format>		// std::formatter
+#include <string_view>	// std::string_view
+#include "Color.hpp"	// mini::Color
+#include "ColorF.hpp"	// mini::ColorF
+#include "Color8.hpp"	// mini::Color8
+
+namespace mini
+{
+	/// @brief 不透明度付きの色を表現するクラス（各成分 8 ビット整数）
+	/// @remark 32 ビットの BMP ファイルと同じく、メモリ上には青、緑、赤、不透明度の順に格納します。
+	/// 合成（`Composite()`, `Blend()`）では、色成分にあらかじめ不透明度を掛けた値（premultiplied alpha）として扱います。
+	struct ColorA8
+	{
+		/// @brief 青成分
+		std::uint8_t b = 0;
+
+		/// @brief 緑成分
+		std::uint8_t g = 0;
+
+		/// @brief 赤成分
+		std::uint8_t r = 0;
+
+		/// @brief 不透明度（0: 透明, 255: 不透明）
+		std::uint8_t a = 0;
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		ColorA8() = default;
+
+		/// @brief 色を作成します。
+		/// @param _r 赤成分
+		/// @param _g 緑成分
+		/// @param _b 青成分
+		/// @param _a 不透明度
+		[[nodiscard]]
+		constexpr ColorA8(std::uint8_t _r, std::uint8_t _g, std::uint8_t _b, std::uint8_t _a = 255) noexcept
+			: b{ _b }
+			, g{ _g }
+			, r{ _r }
+			, a{ _a } {}
+
+		/// @brief `Color` から変換して、不透明な色を作成します。各成分は 0.0 ～ 1.0 の範囲に丸められます。
+		/// @param color 変換元の色
+		[[nodiscard]]
+		explicit constexpr ColorA8(const Color& color) noexcept
+			: b{ ToUint8(color.b) }
+			, g{ ToUint8(color.g) }
+			, r{ ToUint8(color.r) }
+			, a{ 255 } {}
+
+		/// @brief `ColorF` から変換して、不透明な色を作成します。各成分は 0.0 ～ 1.0 の範囲に丸められます。
+		/// @param color 変換元の色
+		[[nodiscard]]
+		explicit constexpr ColorA8(const ColorF& color) noexcept
+			: b{ ToUint8(color.b) }
+			, g{ ToUint8(color.g) }
+			, r{ ToUint8(color.r) }
+			, a{ 255 } {}
+
+		/// @brief `Color8` から変換して、不透明な色を作成します。
+		/// @param color 変換元の色
+		[[nodiscard]]
+		explicit constexpr ColorA8(const Color8& color) noexcept
+			: b{ color.b }
+			, g{ color.g }
+			, r{ color.r }
+			, a{ 255 } {}
+
+		/// @brief 不透明度を除いて `Color` に変換します。
+		/// @return 変換した色
+		[[nodiscard]]
+		constexpr Color toColor() const noexcept
+		{
+			return{ (r / 255.0), (g / 255.0), (b / 255.0) };
+		}
+
+		/// @brief 不透明度を除いて `ColorF` に変換します。
+		/// @return 変換した色
+		[[nodiscard]]
+		constexpr ColorF toColorF() const noexcept
+		{
+			return{ (r / 255.0f), (g / 255.0f), (b / 255.0f) };
+		}
+
+		/// @brief 不透明度を除いて `Color8` に変換します。
+		/// @return 変換した色
+		/// @remark premultiplied alpha の色の場合は、黒の上に合成した色になります。
+		[[nodiscard]]
+		constexpr Color8 toColor8() const noexcept
+		{
+			return{ r, g, b };
+		}
+
+		/// @brief グレースケール値を返します。
+		/// @return グレースケール値（0.0 ～ 1.0）
+		[[nodiscard]]
+		constexpr double grayscale() const noexcept
+		{
+			return toColor().grayscale();
+		}
+
+		/// @brief 色成分に不透明度を掛けた色（premultiplied alpha）を返します。
+		/// @return 色成分に不透明度を掛けた色
+		[[nodiscard]]
+		constexpr ColorA8 premultiplied() const noexcept
+		{
+			return{ MulDiv255(r, a), MulDiv255(g, a), MulDiv255(b, a), a };
+		}
+
+		/// @brief 色成分を不透明度で割った色（straight alpha）を返します。
+		/// @return 色成分を不透明度で割った色。完全に透明な場合は透明な黒
+		[[nodiscard]]
+		constexpr ColorA8 unpremultiplied() const noexcept
+		{
+			if (a == 0)
+			{
+				return{ 0, 0, 0, 0 };
+			}
+
+			return{ DivA(r), DivA(g), DivA(b), a };
+		}
+
+		[[nodiscard]]
+		friend constexpr bool operator ==(const ColorA8& lhs, const ColorA8& rhs) noexcept = default;
+
+		/// @brief 出力ストリームに書き込みます。
+		/// @param os 出力ストリーム
+		/// @param value 書き込む値
+		/// @return 出力ストリーム
+		friend std::ostream& operator <<(std::ostream& os, const ColorA8& value)
+		{
+			return os << '(' << static_cast<int>(value.r) << ", " << static_cast<int>(value.g) << ", " << static_cast<int>(value.b) << ", " << static_cast<int>(value.a) << ')';
+		}
+
+		/// @brief 入力ストリームから読み込みます。
+		/// @param is 入力ストリーム
+		/// @param value 読み込んだ値の格納先
+		/// @return 入力ストリーム
+		friend std::istream& operator >>(std::istream& is, ColorA8& value)
+		{
+			char _; // 区切り文字用
+			int r, g, b, a;
+			is >> _ >> r >> _ >> g >> _ >> b >> _ >> a >> _;
+			value = ColorA8{ static_cast<std::uint8_t>(r), static_cast<std::uint8_t>(g), static_cast<std::uint8_t>(b), static_cast<std::uint8_t>(a) };
+			return is;
+		}
+
+	private:
+
+		/// @brief 0.0 ～ 1.0 の範囲の実数を、8 ビット整数（0 ～ 255）に変換します。
+		/// @param value 変換する値
+		/// @return 変換した値
+		[[nodiscard]]
+		static constexpr std::uint8_t ToUint8(double value) noexcept
+		{
+			return static_cast<std::uint8_t>(std::clamp((value * 255.0 + 0.5), 0.0, 255.0));
+		}
+
+		/// @brief 0.0 ～ 1.0 の範囲の実数を、8 ビット整数（0 ～ 255）に変換します。
+		/// @param value 変換する値
+		/// @return 変換した値
+		[[nodiscard]]
+		static constexpr std::uint8_t ToUint8(float value) noexcept
+		{
+			return static_cast<std::uint8_t>(std::clamp((value * 255.0f + 0.5f), 0.0f, 255.0f));
+		}
+
+		/// @brief x * y / 255 を四捨五入した値を返します。
+		[[nodiscard]]
+		static constexpr std::uint8_t MulDiv255(const std::uint8_t x, const std::uint8_t y) noexcept
+		{
+			const unsigned t = (x * y + 128u);
+			return static_cast<std::uint8_t>((t + (t >> 8)) >> 8);
+		}
+
+		/// @brief value * 255 / a を四捨五入し、255 以下に丸めた値を返します。
+		[[nodiscard]]
+		constexpr std::uint8_t DivA(const std::uint8_t value) const noexcept
+		{
+			const unsigned v = ((value * 255u + a / 2u) / a);
+			return static_cast<std::uint8_t>((v < 255u) ? v : 255u);
+		}
+	};
+
+	// ColorA8 のサイズが 4 バイトであることをコンパイル時にチェック
+	static_assert(sizeof(ColorA8) == 4, "ColorA8 size must be 4 bytes");
+}
+
+template <>
+struct std::formatter<mini::ColorA8> : std::formatter<std::string_view>
+{
+	auto format(const mini::ColorA8& value, auto& ctx) const
+	{
+		return std::format_to(ctx.out(), "({}, {}, {}, {})", value.r, value.g, value.b, value.a);
+	}
+};
@@ -0,0 +1,727 @@
+﻿#include <algorithm>	// std::min, std::max
+#include <array>		// std::array
+#include <bit>			// std::bit_cast
+#include <cmath>		// std::floor
+#include <cstdint>		// std::uint8_t, std::int32_t, std::int64_t
+#include <type_traits>	// std::is_same_v
+#include "ColorConversion.hpp"
+#include "Parallel.hpp"	// mini::ParallelForBands, MINI_IVDEP
+#include "CPUFeatures.hpp"	// mini::GetCPUFeatures, MINI_TARGET
+
+#if MINI_ARCH_X86
+	#include <immintrin.h>
+#endif
+
+namespace mini
+{
+	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+	namespace
+	{
+		/// @brief 浮動小数点数の型ごとの、ビット表現と近似の次数
+		template <class Type>
+		struct FloatTraits;
+
+		template <>
+		struct FloatTraits<float>
+		{
+			using Int = std::int32_t;
+
+			static constexpr int MantissaBits = 23;
+
+			static constexpr int ExponentBias = 127;
+
+			/// @brief 対数の級数の項数
+			static constexpr int LogTerms = 5;
+
+			/// @brief 指数関数のテイラー展開の次数
+			static constexpr int ExpTerms = 7;
+		};
+
+		template <>
+		struct FloatTraits<double>
+		{
+			using Int = std::int64_t;
+
+			static constexpr int MantissaBits = 52;
+
+			static constexpr int ExponentBias = 1023;
+
+			static constexpr int LogTerms = 11;
+
+			static constexpr int ExpTerms = 13;
+		};
+
+		// 以下の近似は、SIMD 版と同じ手順・同じ演算順序で計算する。
+		// 分岐を含まない形で書いてあるのは SIMD 版との対応のためで、スカラー版はコンパイル時の変換表の作成と、端数の処理に使う。
+
+		/// @brief 2 を底とする対数の近似値を返します。
+		/// @param x 正の値（それより小さい値と NaN は、最小の正規化数とみなす）
+		/// @return log2(x)
+		/// @remark 指数部 e と、[√0.5, √2) に収めた仮数部 m に分け、log(m) を atanh の級数 2(t + t^3/3 + ...)（t = (m - 1) / (m + 1)）で求めます。
+		template <class Type>
+		[[nodiscard]]
+		constexpr Type FastLog2(Type x) noexcept
+		{
+			using Traits = FloatTraits<Type>;
+			using Int = typename Traits::Int;
+			constexpr Int MantissaMask = ((Int{ 1 } << Traits::MantissaBits) - 1);
+			constexpr Type MinNormal = std::bit_cast<Type>(Int{ 1 } << Traits::MantissaBits);
+
+			x = ((MinNormal < x) ? x : MinNormal);
+
+			const Int bits = std::bit_cast<Int>(x);
+			Type exponent = static_cast<Type>(static_cast<std::int32_t>(bits >> Traits::MantissaBits) - Traits::ExponentBias);
+			Type m = std::bit_cast<Type>((bits & MantissaMask) | std::bit_cast<Int>(Type{ 1 }));
+
+			if (static_cast<Type>(1.4142135623730951) < m)
+			{
+				m *= static_cast<Type>(0.5);
+				exponent += 1;
+			}
+
+			const Type t = ((m - 1) / (m + 1));
+			const Type t2 = (t * t);
+
+			Type s = static_cast<Type>(1.0 / (2 * Traits::LogTerms - 1));
+
+			for (int k = (Traits::LogTerms - 2); 0 <= k; --k)
+			{
+				s = (s * t2 + static_cast<Type>(1.0 / (2 * k + 1)));
+			}
+
+			// 2 / ln(2)
+			return (exponent + static_cast<Type>(2.8853900817779268) * t * s);
+		}
+
+		/// @brief 2 のべき乗の近似値を返します。
+		/// @param y 指数（正規化数の範囲に丸める。NaN は最小値とみなす）
+		/// @return 2^y
+		/// @remark 最も近い整数 n と端数 f に分け、2^f をテイラー展開で求めて、指数部に n を足します。
+		template <class Type>
+		[[nodiscard]]
+		constexpr Type FastExp2(Type y) noexcept
+		{
+			using Traits = FloatTraits<Type>;
+			using Int = typename Traits::Int;
+			constexpr Type MinExponent = static_cast<Type>(1 - Traits::ExponentBias);
+			constexpr Type MaxExponent = static_cast<Type>(Traits::ExponentBias);
+
+			y = ((MinExponent < y) ? y : MinExponent);
+			y = ((y < MaxExponent) ? y : MaxExponent);
+
+			// 正の値にずらしてから切り捨てることで、最も近い整数に丸める
+			const std::int32_t n = (static_cast<std::int32_t>(y + static_cast<Type>(Traits::ExponentBias + 0.5)) - Traits::ExponentBias);
+			const Type z = ((y - static_cast<Type>(n)) * static_cast<Type>(0.69314718055994531));
+
+			Type p = 1;
+
+			for (int k = Traits::ExpTerms; 1 <= k; --k)
+			{
+				p = (1 + p * z * static_cast<Type>(1.0 / k));
+			}
+
+			return (p * std::bit_cast<Type>(static_cast<Int>(n + Traits::ExponentBias) << Traits::MantissaBits));
+		}
+
+		/// @brief x^y の近似値を返します。
+		/// @param x 正の値
+		template <class Type>
+		[[nodiscard]]
+		constexpr Type FastPow(const Type x, const Type y) noexcept
+		{
+			return FastExp2(y * FastLog2(x));
+		}
+
+		/// @brief sRGB の値を線形の値に変換します。
+		template <class Type>
+		[[nodiscard]]
+		constexpr Type SRGBToLinearValue(const Type c) noexcept
+		{
+			if (c <= static_cast<Type>(0.04045))
+			{
+				return (c / static_cast<Type>(12.92));
+			}
+
+			return FastPow(((c + static_cast<Type>(0.055)) / static_cast<Type>(1.055)), static_cast<Type>(2.4));
+		}
+
+		/// @brief 線形の値を sRGB の値に変換します。
+		template <class Type>
+		[[nodiscard]]
+		constexpr Type LinearToSRGBValue(const Type c) noexcept
+		{
+			if (c <= static_cast<Type>(0.0031308))
+			{
+				return (c * static_cast<Type>(12.92));
+			}
+
+			return (static_cast<Type>(1.055) * FastPow(c, static_cast<Type>(1.0 / 2.4)) - static_cast<Type>(0.055));
+		}
+
+		/// @brief 配列の各要素を、sRGB と線形の間で変換します。
+		/// @tparam ToLinear sRGB から線形への変換の場合 true, 線形から sRGB への変換の場合 false
+		/// @param i 変換を開始する位置
+		template <bool ToLinear, class Type>
+		void TransferScalar(const Type* in, Type* out, const int n, int i) noexcept
+		{
+			for (; i < n; ++i)
+			{
+				out[i] = (ToLinear ? SRGBToLinearValue(in[i]) : LinearToSRGBValue(in[i]));
+			}
+		}
+
+	#if MINI_ARCH_X86
+
+		MINI_TARGET("avx2")
+		__m256 Log2AVX2(__m256 x) noexcept
+		{
+			x = _mm256_max_ps(x, _mm256_set1_ps(std::bit_cast<float>(0x00800000)));
+
+			const __m256i bits = _mm256_castps_si256(x);
+			__m256 exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+			__m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_castps_si256(_mm256_set1_ps(1.0f))));
+
+			const __m256 large = _mm256_cmp_ps(_mm256_set1_ps(1.4142135623730951f), m, _CMP_LT_OQ);
+			m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(0.5f)), large);
+			exponent = _mm256_add_ps(exponent, _mm256_and_ps(large, _mm256_set1_ps(1.0f)));
+
+			const __m256 one = _mm256_set1_ps(1.0f);
+			const __m256 t = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+			const __m256 t2 = _mm256_mul_ps(t, t);
+
+			__m256 s = _mm256_set1_ps(static_cast<float>(1.0 / (2 * FloatTraits<float>::LogTerms - 1)));
+
+			for (int k = (FloatTraits<float>::LogTerms - 2); 0 <= k; --k)
+			{
+				s = _mm256_add_ps(_mm256_mul_ps(s, t2), _mm256_set1_ps(static_cast<float>(1.0 / (2 * k + 1))));
+			}
+
+			return _mm256_add_ps(exponent, _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(2.8853900817779268f), t), s));
+		}
+
+		MINI_TARGET("avx2")
+		__m256d Log2AVX2(__m256d x) noexcept
+		{
+			x = _mm256_max_pd(x, _mm256_set1_pd(std::bit_cast<double>(0x0010000000000000LL)));
+
+			const __m256i bits = _mm256_castpd_si256(x);
+
+			// 指数部（各 64 ビットの下位 32 ビット）を集めて、4 つの 32 ビット整数にする
+			const __m256i biased = _mm256_permutevar8x32_epi32(_mm256_srli_epi64(bits, 52), _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+			__m256d exponent = _mm256_cvtepi32_pd(_mm_sub_epi32(_mm256_castsi256_si128(biased), _mm_set1_epi32(1023)));
+			__m256d m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)), _mm256_castpd_si256(_mm256_set1_pd(1.0))));
+
+			const __m256d large = _mm256_cmp_pd(_mm256_set1_pd(1.4142135623730951), m, _CMP_LT_OQ);
+			m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), large);
+			exponent = _mm256_add_pd(exponent, _mm256_and_pd(large, _mm256_set1_pd(1.0)));
+
+			const __m256d one = _mm256_set1_pd(1.0);
+			const __m256d t = _mm256_div_pd(_mm256_sub_pd(m, one), _mm256_add_pd(m, one));
+			const __m256d t2 = _mm256_mul_pd(t, t);
+
+			__m256d s = _mm256_set1_pd(1.0 / (2 * FloatTraits<double>::LogTerms - 1));
+
+			for (int k = (FloatTraits<double>::LogTerms - 2); 0 <= k; --k)
+			{
+				s = _mm256_add_pd(_mm256_mul_pd(s, t2), _mm256_set1_pd(1.0 / (2 * k + 1)));
+			}
+
+			return _mm256_add_pd(exponent, _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(2.8853900817779268), t), s));
+		}
+
+		MINI_TARGET("avx2")
+		__m256 Exp2AVX2(__m256 y) noexcept
+		{
+			y = _mm256_max_ps(y, _mm256_set1_ps(-126.0f));
+			y = _mm256_min_ps(y, _mm256_set1_ps(127.0f));
+
+			const __m256i n = _mm256_sub_epi32(_mm256_cvttps_epi32(_mm256_add_ps(y, _mm256_set1_ps(127.5f))), _mm256_set1_epi32(127));
+			const __m256 z = _mm256_mul_ps(_mm256_sub_ps(y, _mm256_cvtepi32_ps(n)), _mm256_set1_ps(0.69314718055994531f));
+			const __m256 one = _mm256_set1_ps(1.0f);
+
+			__m256 p = one;
+
+			for (int k = FloatTraits<float>::ExpTerms; 1 <= k; --k)
+			{
+				p = _mm256_add_ps(one, _mm256_mul_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(static_cast<float>(1.0 / k))));
+			}
+
+			return _mm256_mul_ps(p, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n, _mm256_set1_epi32(127)), 23)));
+		}
+
+		MINI_TARGET("avx2")
+		__m256d Exp2AVX2(__m256d y) noexcept
+		{
+			y = _mm256_max_pd(y, _mm256_set1_pd(-1022.0));
+			y = _mm256_min_pd(y, _mm256_set1_pd(1023.0));
+
+			const __m128i n = _mm_sub_epi32(_mm256_cvttpd_epi32(_mm256_add_pd(y, _mm256_set1_pd(1023.5))), _mm_set1_epi32(1023));
+			const __m256d z = _mm256_mul_pd(_mm256_sub_pd(y, _mm256_cvtepi32_pd(n)), _mm256_set1_pd(0.69314718055994531));
+			const __m256d one = _mm256_set1_pd(1.0);
+
+			__m256d p = one;
+
+			for (int k = FloatTraits<double>::ExpTerms; 1 <= k; --k)
+			{
+				p = _mm256_add_pd(one, _mm256_mul_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(1.0 / k)));
+			}
+
+			const __m256i scale = _mm256_slli_epi64(_mm256_cvtepi32_epi64(_mm_add_epi32(n, _mm_set1_epi32(1023))), 52);
+			return _mm256_mul_pd(p, _mm256_castsi256_pd(scale));
+		}
+
+		MINI_TARGET("avx2")
+		__m256 SRGBToLinearAVX2(const __m256 c) noexcept
+		{
+			const __m256 low = _mm256_div_ps(c, _mm256_set1_ps(12.92f));
+			const __m256 x = _mm256_div_ps(_mm256_add_ps(c, _mm256_set1_ps(0.055f)), _mm256_set1_ps(1.055f));
+			const __m256 high = Exp2AVX2(_mm256_mul_ps(_mm256_set1_ps(2.4f), Log2AVX2(x)));
+			return _mm256_blendv_ps(high, low, _mm256_cmp_ps(c, _mm256_set1_ps(0.04045f), _CMP_LE_OQ));
+		}
+
+		MINI_TARGET("avx2")
+		__m256d SRGBToLinearAVX2(const __m256d c) noexcept
+		{
+			const __m256d low = _mm256_div_pd(c, _mm256_set1_pd(12.92));
+			const __m256d x = _mm256_div_pd(_mm256_add_pd(c, _mm256_set1_pd(0.055)), _mm256_set1_pd(1.055));
+			const __m256d high = Exp2AVX2(_mm256_mul_pd(_mm256_set1_pd(2.4), Log2AVX2(x)));
+			return _mm256_blendv_pd(high, low, _mm256_cmp_pd(c, _mm256_set1_pd(0.04045), _CMP_LE_OQ));
+		}
+
+		MINI_TARGET("avx2")
+		__m256 LinearToSRGBAVX2(const __m256 c) noexcept
+		{
+			const __m256 low = _mm256_mul_ps(c, _mm256_set1_ps(12.92f));
+			const __m256 power = Exp2AVX2(_mm256_mul_ps(_mm256_set1_ps(static_cast<float>(1.0 / 2.4)), Log2AVX2(c)));
+			const __m256 high = _mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(1.055f), power), _mm256_set1_ps(0.055f));
+			return _mm256_blendv_ps(high, low, _mm256_cmp_ps(c, _mm256_set1_ps(0.0031308f), _CMP_LE_OQ));
+		}
+
+		MINI_TARGET("avx2")
+		__m256d LinearToSRGBAVX2(const __m256d c) noexcept
+		{
+			const __m256d low = _mm256_mul_pd(c, _mm256_set1_pd(12.92));
+			const __m256d power = Exp2AVX2(_mm256_mul_pd(_mm256_set1_pd(1.0 / 2.4), Log2AVX2(c)));
+			const __m256d high = _mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(1.055), power), _mm256_set1_pd(0.055));
+			return _mm256_blendv_pd(high, low, _mm256_cmp_pd(c, _mm256_set1_pd(0.0031308), _CMP_LE_OQ));
+		}
+
+		MINI_TARGET("avx2")
+		void TransferAVX2(const float* in, float* out, const int n, const bool toLinear) noexcept
+		{
+			int i = 0;
+
+			for (; (i + 8) <= n; i += 8)
+			{
+				const __m256 c = _mm256_loadu_ps(in + i);
+				_mm256_storeu_ps((out + i), (toLinear ? SRGBToLinearAVX2(c) : LinearToSRGBAVX2(c)));
+			}
+
+			if (toLinear)
+			{
+				TransferScalar<true>(in, out, n, i);
+			}
+			else
+			{
+				TransferScalar<false>(in, out, n, i);
+			}
+		}
+
+		MINI_TARGET("avx2")
+		void TransferAVX2(const double* in, double* out, const int n, const bool toLinear) noexcept
+		{
+			int i = 0;
+
+			for (; (i + 4) <= n; i += 4)
+			{
+				const __m256d c = _mm256_loadu_pd(in + i);
+				_mm256_storeu_pd((out + i), (toLinear ? SRGBToLinearAVX2(c) : LinearToSRGBAVX2(c)));
+			}
+
+			if (toLinear)
+			{
+				TransferScalar<true>(in, out, n, i);
+			}
+			else
+			{
+				TransferScalar<false>(in, out, n, i);
+			}
+		}
+
+	#endif
+
+		/// @brief 配列の各要素を、sRGB と線形の間で変換します。
+		/// @param toLinear sRGB から線形への変換の場合 true, 線形から sRGB への変換の場合 false
+		/// @remark AVX2 に対応している CPU では、8 個（float）または 4 個（double）ずつ SIMD で変換します。
+		template <class Type>
+		void Transfer(const Type* in, Type* out, const int n, const bool toLinear) noexcept
+		{
+		#if MINI_ARCH_X86
+			static const bool hasAVX2 = GetCPUFeatures().avx2;
+
+			if (hasAVX2)
+			{
+				TransferAVX2(in, out, n, toLinear);
+				return;
+			}
+		#endif
+
+			if (toLinear)
+			{
+				TransferScalar<true>(in, out, n, 0);
+			}
+			else
+			{
+				TransferScalar<false>(in, out, n, 0);
+			}
+		}
+
+		/// @brief 8 ビットの値を変換する表を、コンパイル時に作成します。
+		/// @param function 0.0 ～ 1.0 の値を変換する関数
+		template <class Function>
+		[[nodiscard]]
+		consteval std::array<std::uint8_t, 256> MakeTable(Function function)
+		{
+			std::array<std::uint8_t, 256> table{};
+
+			for (int i = 0; i < 256; ++i)
+			{
+				const double v = (function(i / 255.0) * 255.0 + 0.5);
+				table[i] = static_cast<std::uint8_t>((v < 0.0) ? 0.0 : ((255.0 < v) ? 255.0 : v));
+			}
+
+			return table;
+		}
+
+		/// @brief sRGB の 8 ビット値から、線形の 8 ビット値への変換表
+		constexpr std::array<std::uint8_t, 256> SRGBToLinearTable = MakeTable(SRGBToLinearValue<double>);
+
+		/// @brief 線形の 8 ビット値から、sRGB の 8 ビット値への変換表
+		constexpr std::array<std::uint8_t, 256> LinearToSRGBTable = MakeTable(LinearToSRGBValue<double>);
+
+		/// @brief 彩度を求めるための、255 * 65536 / v の表（v = 0 は 0）
+		constexpr std::array<std::int32_t, 256> SaturationReciprocalTable = []()
+		{
+			std::array<std::int32_t, 256> table{};
+
+			for (int v = 1; v < 256; ++v)
+			{
+				table[v] = (((255 << 16) + v / 2) / v);
+			}
+
+			return table;
+		}();
+
+		/// @brief 色相を求めるための、255 * 65536 / (6 * d) の表（d = 0 は 0）
+		constexpr std::array<std::int32_t, 256> HueReciprocalTable = []()
+		{
+			std::array<std::int32_t, 256> table{};
+
+			for (int d = 1; d < 256; ++d)
+			{
+				table[d] = (((255 << 16) + 3 * d) / (6 * d));
+			}
+
+			return table;
+		}();
+
+		/// @brief 固定小数点数の値を 0 ～ 255 の範囲に丸めます。
+		[[nodiscard]]
+		constexpr std::uint8_t ClampToUint8(const std::int32_t value) noexcept
+		{
+			return static_cast<std::uint8_t>((value < 0) ? 0 : ((255 < value) ? 255 : value));
+		}
+
+		/// @brief 1 行ずつ変換した画像を、行の帯ごとに並列に作成します。
+		/// @param rowFunction 変換元の行、変換先の行、幅を受け取って 1 行を変換する関数
+		template <class PixelType, class RowFunction>
+		[[nodiscard]]
+		BasicImage<PixelType> TransformRows(const BasicImage<PixelType>& image, RowFunction&& rowFunction)
+		{
+			if (image.isEmpty())
+			{
+				return{};
+			}
+
+			BasicImage<PixelType> result{ image.width(), image.height(), Uninitialized, image.layout() };
+
+			ParallelForBands(image.height(), ParallelOptions{}, [&](const int y0, const int y1)
+			{
+				for (int y = y0; y < y1; ++y)
+				{
+					rowFunction(image[y], result[y], image.width());
+				}
+			});
+
+			return result;
+		}
+
+		/// @brief 各成分を sRGB と線形の間で変換した画像を返します。
+		/// @param toLinear sRGB から線形への変換の場合 true, 線形から sRGB への変換の場合 false
+		/// @remark 成分の順序によらない変換なので、1 行を成分の配列とみなして処理します。
+		template <class PixelType>
+		[[nodiscard]]
+		BasicImage<PixelType> TransferImage(const BasicImage<PixelType>& image, const bool toLinear)
+		{
+			return TransformRows(image, [toLinear](const PixelType* src, PixelType* dst, const int width)
+			{
+				if constexpr (std::is_same_v<PixelType, Color8>)
+				{
+					const std::array<std::uint8_t, 256>& table = (toLinear ? SRGBToLinearTable : LinearToSRGBTable);
+					const std::uint8_t* in = reinterpret_cast<const std::uint8_t*>(src);
+					std::uint8_t* out = reinterpret_cast<std::uint8_t*>(dst);
+
+					for (int i = 0; i < (width * 3); ++i)
+					{
+						out[i] = table[in[i]];
+					}
+				}
+				else
+				{
+					using Type = decltype(PixelType::r);
+					Transfer(reinterpret_cast<const Type*>(src), reinterpret_cast<Type*>(dst), (width * 3), toLinear);
+				}
+			});
+		}
+
+		/// @brief 1 ピクセルを HSV から RGB に変換します。
+		template <class Type>
+		void HSVToRGBValue(const Type h, const Type s, const Type v, Type& r, Type& g, Type& b) noexcept
+		{
+			// 色相は 1.0 で 1 周する。丸め誤差で 6.0 になった場合は、最後の区間の終端とする
+			const Type h6 = ((h - std::floor(h)) * 6);
+			const int sector = std::min(static_cast<int>(h6), 5);
+			const Type f = (h6 - static_cast<Type>(sector));
+			const Type p = (v * (1 - s));
+			const Type q = (v * (1 - s * f));
+			const Type t = (v * (1 - s * (1 - f)));
+
+			switch (sector)
+			{
+			case 0: r = v; g = t; b = p; break;
+			case 1: r = q; g = v; b = p; break;
+			case 2: r = p; g = v; b = t; break;
+			case 3: r = p; g = q; b = v; break;
+			case 4: r = t; g = p; b = v; break;
+			default: r = v; g = p; b = q; break;
+			}
+		}
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> ToGrayscale(const BasicImage<PixelType>& image)
+	{
+		return TransformRows(image, [](const PixelType* src, PixelType* dst, const int width)
+		{
+			if constexpr (std::is_same_v<PixelType, Color8>)
+			{
+				// 0.299, 0.587, 0.114 の 65536 倍（合計 65536）
+				MINI_IVDEP
+				for (int x = 0; x < width; ++x)
+				{
+					const std::int32_t gray = ((19595 * src[x].r + 38470 * src[x].g + 7471 * src[x].b + 32768) >> 16);
+					dst[x] = Color8{ static_cast<std::uint8_t>(gray) };
+				}
+			}
+			else
+			{
+				MINI_IVDEP
+				for (int x = 0; x < width; ++x)
+				{
+					dst[x] = PixelType{ src[x].grayscale() };
+				}
+			}
+		});
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> SRGBToLinear(const BasicImage<PixelType>& image)
+	{
+		return TransferImage(image, true);
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> LinearToSRGB(const BasicImage<PixelType>& image)
+	{
+		return TransferImage(image, false);
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> RGBToHSV(const BasicImage<PixelType>& image)
+	{
+		return TransformRows(image, [](const PixelType* src, PixelType* dst, const int width)
+		{
+			if constexpr (std::is_same_v<PixelType, Color8>)
+			{
+				for (int x = 0; x < width; ++x)
+				{
+					const std::int32_t r = src[x].r, g = src[x].g, b = src[x].b;
+					const std::int32_t v = std::max({ r, g, b });
+					const std::int32_t d = (v - std::min({ r, g, b }));
+					const std::int32_t s = ((d * SaturationReciprocalTable[v] + 32768) >> 16);
+
+					// 色相を 6 倍した値の分子（d を単位とする）。赤が最大で負になる場合は 1 周分足す
+					std::int32_t numerator;
+
+					if (v == r)
+					{
+						numerator = ((g < b) ? (6 * d + g - b) : (g - b));
+					}
+					else if (v == g)
+					{
+						numerator = (2 * d + b - r);
+					}
+					else
+					{
+						numerator = (4 * d + r - g);
+					}
+
+					const std::int32_t h = static_cast<std::int32_t>((static_cast<std::int64_t>(numerator) * HueReciprocalTable[d] + 32768) >> 16);
+					dst[x] = Color8{ static_cast<std::uint8_t>((255 < h) ? 0 : h), static_cast<std::uint8_t>(s), static_cast<std::uint8_t>(v) };
+				}
+			}
+			else
+			{
+				using Type = decltype(PixelType::r);
+
+				MINI_IVDEP
+				for (int x = 0; x < width; ++x)
+				{
+					const Type r = src[x].r, g = src[x].g, b = src[x].b;
+					const Type v = ((r < g) ? ((g < b) ? b : g) : ((r < b) ? b : r));
+					const Type minimum = ((g < r) ? ((b < g) ? b : g) : ((b < r) ? b : r));
+					const Type d = (v - minimum);
+					const Type inverseD = ((0 < d) ? (1 / d) : 0);
+					const Type s = ((0 < v) ? (d / v) : 0);
+					const Type hr = ((g - b) * inverseD);
+					const Type h6 = ((v == r) ? ((hr < 0) ? (hr + 6) : hr)
+						: ((v == g) ? (2 + (b - r) * inverseD) : (4 + (r - g) * inverseD)));
+					const Type h = (h6 * static_cast<Type>(1.0 / 6.0));
+					dst[x] = PixelType{ ((1 <= h) ? 0 : h), s, v };
+				}
+			}
+		});
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> HSVToRGB(const BasicImage<PixelType>& image)
+	{
+		return TransformRows(image, [](const PixelType* src, PixelType* dst, const int width)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				if constexpr (std::is_same_v<PixelType, Color8>)
+				{
+					float r, g, b;
+					HSVToRGBValue((src[x].r / 255.0f), (src[x].g / 255.0f), (src[x].b / 255.0f), r, g, b);
+					dst[x] = Color8{ ColorF{ r, g, b } };
+				}
+				else
+				{
+					HSVToRGBValue(src[x].r, src[x].g, src[x].b, dst[x].r, dst[x].g, dst[x].b);
+				}
+			}
+		});
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> RGBToYCbCr(const BasicImage<PixelType>& image)
+	{
+		return TransformRows(image, [](const PixelType* src, PixelType* dst, const int width)
+		{
+			if constexpr (std::is_same_v<PixelType, Color8>)
+			{
+				// Cb, Cr は、最大値が 256 に丸められないよう 0.5 より少しだけ小さい値を足して切り捨てる
+				MINI_IVDEP
+				for (int x = 0; x < width; ++x)
+				{
+					const std::int32_t r = src[x].r, g = src[x].g, b = src[x].b;
+					const std::int32_t y = ((19595 * r + 38470 * g + 7471 * b + 32768) >> 16);
+					const std::int32_t cb = ((-11059 * r - 21709 * g + 32768 * b + (128 << 16) + 32767) >> 16);
+					const std::int32_t cr = ((32768 * r - 27439 * g - 5329 * b + (128 << 16) + 32767) >> 16);
+					dst[x] = Color8{ static_cast<std::uint8_t>(y), static_cast<std::uint8_t>(cb), static_cast<std::uint8_t>(cr) };
+				}
+			}
+			else
+			{
+				using Type = decltype(PixelType::r);
+
+				MINI_IVDEP
+				for (int x = 0; x < width; ++x)
+				{
+					const Type r = src[x].r, g = src[x].g, b = src[x].b;
+					const Type y = (static_cast<Type>(0.299) * r + static_cast<Type>(0.587) * g + static_cast<Type>(0.114) * b);
+					const Type cb = (static_cast<Type>(0.5) - static_cast<Type>(0.168736) * r - static_cast<Type>(0.331264) * g + static_cast<Type>(0.5) * b);
+					const Type cr = (static_cast<Type>(0.5) + static_cast<Type>(0.5) * r - static_cast<Type>(0.418688) * g - static_cast<Type>(0.081312) * b);
+					dst[x] = PixelType{ y, cb, cr };
+				}
+			}
+		});
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> YCbCrToRGB(const BasicImage<PixelType>& image)
+	{
+		return TransformRows(image, [](const PixelType* src, PixelType* dst, const int width)
+		{
+			if constexpr (std::is_same_v<PixelType, Color8>)
+			{
+				// 1.402, 0.344136, 0.714136, 1.772 の 65536 倍
+				MINI_IVDEP
+				for (int x = 0; x < width; ++x)
+				{
+					const std::int32_t y = (src[x].r << 16) + 32768;
+					const std::int32_t cb = (src[x].g - 128);
+					const std::int32_t cr = (src[x].b - 128);
+					const std::int32_t r = ((y + 91881 * cr) >> 16);
+					const std::int32_t g = ((y - 22554 * cb - 46802 * cr) >> 16);
+					const std::int32_t b = ((y + 116130 * cb) >> 16);
+					dst[x] = Color8{ ClampToUint8(r), ClampToUint8(g), ClampToUint8(b) };
+				}
+			}
+			else
+			{
+				using Type = decltype(PixelType::r);
+
+				MINI_IVDEP
+				for (int x = 0; x < width; ++x)
+				{
+					const Type y = src[x].r;
+					const Type cb = (src[x].g - static_cast<Type>(0.5));
+					const Type cr = (src[x].b - static_cast<Type>(0.5));
+					dst[x] = PixelType{ (y + static_cast<Type>(1.402) * cr),
+						(y - static_cast<Type>(0.344136) * cb - static_cast<Type>(0.714136) * cr),
+						(y + static_cast<Type>(1.772) * cb) };
+				}
+			}
+		});
+	}
+
+	template Image ToGrayscale<Color>(const Image&);
+	template ImageF ToGrayscale<ColorF>(const ImageF&);
+	template Image8 ToGrayscale<Color8>(const Image8&);
+
+	template Image SRGBToLinear<Color>(const Image&);
+	template ImageF SRGBToLinear<ColorF>(const ImageF&);
+	template Image8 SRGBToLinear<Color8>(const Image8&);
+
+	template Image LinearToSRGB<Color>(const Image&);
+	template ImageF LinearToSRGB<ColorF>(const ImageF&);
+	template Image8 LinearToSRGB<Color8>(const Image8&);
+
+	template Image RGBToHSV<Color>(const Image&);
+	template ImageF RGBToHSV<ColorF>(const ImageF&);
+	template Image8 RGBToHSV<Color8>(const Image8&);
+
+	template Image HSVToRGB<Color>(const Image&);
+	template ImageF HSVToRGB<ColorF>(const ImageF&);
+	template Image8 HSVToRGB<Color8>(const Image8&);
+
+	template Image RGBToYCbCr<Color>(const Image&);
+	template ImageF RGBToYCbCr<ColorF>(const ImageF&);
+	template Image8 RGBToYCbCr<Color8>(const Image8&);
+
+	template Image YCbCrToRGB<Color>(const Image&);
+	template ImageF YCbCrToRGB<ColorF>(const ImageF&);
+	template Image8 YCbCrToRGB<Color8>(const Image8&);
+}
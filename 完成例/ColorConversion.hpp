@@ -0,0 +1,66 @@
+﻿#pragma once
+#include "Image.hpp"	// mini::BasicImage
+
+namespace mini
+{
+	/// @brief グレースケールに変換した画像を返します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @return 各成分がグレースケール値（`Color::grayscale()` と同じ重み）の画像
+	/// @remark `Color8` の場合は 16 ビット固定小数点数で計算します。
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> ToGrayscale(const BasicImage<PixelType>& image);
+
+	/// @brief sRGB の画像を、線形の画像に変換します（ガンマの解除）。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @return 線形の画像
+	/// @remark `Color8` の場合はコンパイル時に作成した変換表を引き、`Color`, `ColorF` の場合は `std::pow` の代わりにベクトル化できる多項式近似を使います。
+	/// `Color8` の線形の値は暗い部分の階調が失われるため、精度が必要な場合は `Color` や `ColorF` に変換してから処理してください。
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> SRGBToLinear(const BasicImage<PixelType>& image);
+
+	/// @brief 線形の画像を、sRGB の画像に変換します（ガンマの適用）。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @return sRGB の画像
+	/// @remark `SRGBToLinear()` と同じく、`Color8` の場合は変換表、それ以外の場合は多項式近似を使います。
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> LinearToSRGB(const BasicImage<PixelType>& image);
+
+	/// @brief RGB の画像を、HSV の画像に変換します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @return 赤成分に色相（0.0 以上 1.0 未満。1.0 が 360°）、緑成分に彩度、青成分に明度を格納した画像
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> RGBToHSV(const BasicImage<PixelType>& image);
+
+	/// @brief HSV の画像を、RGB の画像に変換します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image `RGBToHSV()` と同じ並びの HSV の画像
+	/// @return RGB の画像
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> HSVToRGB(const BasicImage<PixelType>& image);
+
+	/// @brief RGB の画像を、YCbCr の画像に変換します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @return 赤成分に Y、緑成分に Cb、青成分に Cr を格納した画像
+	/// @remark JPEG と同じ、ITU-R BT.601 のフルレンジの式を使います（Cb, Cr は 0.5 を中心とする）。`Color8` の場合は 16 ビット固定小数点数で計算します。
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> RGBToYCbCr(const BasicImage<PixelType>& image);
+
+	/// @brief YCbCr の画像を、RGB の画像に変換します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image `RGBToYCbCr()` と同じ並びの YCbCr の画像
+	/// @return RGB の画像
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> YCbCrToRGB(const BasicImage<PixelType>& image);
+}
@@ -0,0 +1,174 @@
+﻿#pragma once
+#include <iostream>		// std::ostream, std::istream
+#include <format>		// std::formatter
+#include <string_view>	// std::string_view
+#include "Color.hpp"	// mini::Color
+
+namespace mini
+{
+	/// @brief 色を表現するクラス（各成分 float）
+	/// @remark `Color` の半分のメモリで済みます。
+	struct ColorF
+	{
+		/// @brief 赤成分
+		float r = 0.0f;
+
+		/// @brief 緑成分
+		float g = 0.0f;
+
+		/// @brief 青成分
+		float b = 0.0f;
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		ColorF() = default;
+
+		/// @brief 色を作成します。
+		/// @param _r 赤成分
+		/// @param _g 緑成分
+		/// @param _b 青成分
+		[[nodiscard]]
+		constexpr ColorF(float _r, float _g, float _b) noexcept
+			: r{ _r }
+			, g{ _g }
+			, b{ _b } {}
+
+		/// @brief グレースケールの色を作成します。
+		/// @param rgb 赤成分、緑成分、青成分
+		[[nodiscard]]
+		explicit constexpr ColorF(float rgb) noexcept
+			: r{ rgb }
+			, g{ rgb }
+			, b{ rgb } {}
+
+		/// @brief `Color` から変換して色を作成します。
+		/// @param color 変換元の色
+		[[nodiscard]]
+		explicit constexpr ColorF(const Color& color) noexcept
+			: r{ static_cast<float>(color.r) }
+			, g{ static_cast<float>(color.g) }
+			, b{ static_cast<float>(color.b) } {}
+
+		[[nodiscard]]
+		constexpr ColorF operator +() const noexcept
+		{
+			return *this;
+		}
+
+		[[nodiscard]]
+		constexpr ColorF operator -() const noexcept
+		{
+			return{ -r, -g, -b };
+		}
+
+		[[nodiscard]]
+		constexpr ColorF operator +(const ColorF& other) const noexcept
+		{
+			return{ (r + other.r), (g + other.g), (b + other.b) };
+		}
+
+		[[nodiscard]]
+		constexpr ColorF operator -(const ColorF& other) const noexcept
+		{
+			return{ (r - other.r), (g - other.g), (b - other.b) };
+		}
+
+		[[nodiscard]]
+		constexpr ColorF operator *(float s) const noexcept
+		{
+			return{ (r * s), (g * s), (b * s) };
+		}
+
+		[[nodiscard]]
+		friend constexpr ColorF operator *(float s, const ColorF& other) noexcept
+		{
+			return{ (s * other.r), (s * other.g), (s * other.b) };
+		}
+
+		[[nodiscard]]
+		constexpr ColorF operator /(float s) const noexcept
+		{
+			return{ (r / s), (g / s), (b / s) };
+		}
+
+		[[nodiscard]]
+		constexpr ColorF& operator +=(const ColorF& other) noexcept
+		{
+			r += other.r;
+			g += other.g;
+			b += other.b;
+			return *this;
+		}
+
+		[[nodiscard]]
+		constexpr ColorF& operator -=(const ColorF& other) noexcept
+		{
+			r -= other.r;
+			g -= other.g;
+			b -= other.b;
+			return *this;
+		}
+
+		[[nodiscard]]
+		constexpr ColorF& operator *=(float s) noexcept
+		{
+			r *= s;
+			g *= s;
+			b *= s;
+			return *this;
+		}
+
+		[[nodiscard]]
+		constexpr ColorF& operator /=(float s) noexcept
+		{
+			r /= s;
+			g /= s;
+			b /= s;
+			return *this;
+		}
+
+		/// @brief `Color` に変換します。
+		/// @return 変換した色
+		[[nodiscard]]
+		constexpr Color toColor() const noexcept
+		{
+			return{ r, g, b };
+		}
+
+		/// @brief グレースケール値を返します。
+		/// @return グレースケール値
+		[[nodiscard]]
+		constexpr float grayscale() const noexcept
+		{
+			return (0.299f * r) + (0.587f * g) + (0.114f * b);
+		}
+
+		/// @brief 出力ストリームに書き込みます。
+		/// @param os 出力ストリーム
+		/// @param value 書き込む値
+		/// @return 出力ストリーム
+		friend std::ostream& operator <<(std::ostream& os, const ColorF& value)
+		{
+			return os << '(' << value.r << ", " << value.g << ", " << value.b << ')';
+		}
+
+		/// @brief 入力ストリームから読み込みます。
+		/// @param is 入力ストリーム
+		/// @param value 読み込んだ値の格納先
+		/// @return 入力ストリーム
+		friend std::istream& operator >>(std::istream& is, ColorF& value)
+		{
+			char _; // 区切り文字用
+			return is >> _ >> value.r >> _ >> value.g >> _ >> value.b >> _;
+		}
+	};
+}
+
+template <>
+struct std::formatter<mini::ColorF> : std::formatter<std::string_view>
+{
+	auto format(const mini::ColorF& value, auto& ctx) const
+	{
+		return std::format_to(ctx.out(), "({}, {}, {})", value.r, value.g, value.b);
+	}
+};
@@ -0,0 +1,586 @@
+﻿#include <algorithm>		// std::min, std::max, std::clamp, std::fill, std::fill_n, std::sort
+#include <array>			// std::array
+#include <cmath>			// std::ceil, std::floor, std::sqrt, std::hypot, std::nextafter
+#include <cstdint>			// std::uint8_t
+#include <cstring>			// std::memcpy
+#include <limits>			// std::numeric_limits
+#include <type_traits>		// std::is_same_v
+#include <utility>			// std::swap
+#include <vector>			// std::vector
+#include "Drawing.hpp"
+
+namespace mini
+{
+	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+	namespace
+	{
+		/// @brief アンチエイリアスで、1 行あたりに調べる横線の数
+		/// @remark 縦方向はこの数で標本化し、横方向は各横線がピクセルを覆う長さを正確に求める。
+		constexpr int SubScanlines = 4;
+
+		/// @brief 完全に覆われているとみなすカバレッジ
+		constexpr float FullCoverage = 0.999f;
+
+		/// @brief 行の [x0, x1) の範囲を、同じ色で塗りつぶします。
+		/// @remark 長い範囲は、塗り終えた部分を倍々にコピーして広げる。
+		/// `Color8` のように大きさが 2 の累乗でない型でも、`std::memcpy` のベクトル化されたコピーで塗れる。
+		template <class PixelType>
+		void FillSpan(PixelType* row, const int x0, const int x1, const PixelType& color) noexcept
+		{
+			const int count = (x1 - x0);
+			PixelType* dst = (row + x0);
+
+			if (count < 16)
+			{
+				std::fill_n(dst, count, color);
+				return;
+			}
+
+			// 最初の 16 ピクセルを塗り、塗った範囲をコピーして広げる
+			std::fill_n(dst, 16, color);
+
+			for (int filled = 16; filled < count;)
+			{
+				const int n = std::min(filled, (count - filled));
+				std::memcpy((dst + filled), dst, (n * sizeof(PixelType)));
+				filled += n;
+			}
+		}
+
+		/// @brief 8 ビット整数の成分を、カバレッジに応じて混ぜます。
+		[[nodiscard]]
+		std::uint8_t MixChannel(const std::uint8_t dst, const std::uint8_t color, const float coverage) noexcept
+		{
+			return static_cast<std::uint8_t>(dst + (color - dst) * coverage + 0.5f);
+		}
+
+		/// @brief 元の色と塗る色を、カバレッジに応じて混ぜます。
+		/// @remark `ColorA8` は不透明度も同じ割合で混ぜる（premultiplied alpha の色の場合は、通常の重ね合わせと同じ結果になる）。
+		template <class PixelType>
+		[[nodiscard]]
+		PixelType Mix(const PixelType& dst, const PixelType& color, const float coverage) noexcept
+		{
+			if constexpr (std::is_same_v<PixelType, Color8>)
+			{
+				return{ MixChannel(dst.r, color.r, coverage), MixChannel(dst.g, color.g, coverage), MixChannel(dst.b, color.b, coverage) };
+			}
+			else if constexpr (std::is_same_v<PixelType, ColorA8>)
+			{
+				return{ MixChannel(dst.r, color.r, coverage), MixChannel(dst.g, color.g, coverage),
+					MixChannel(dst.b, color.b, coverage), MixChannel(dst.a, color.a, coverage) };
+			}
+			else
+			{
+				return (dst + (color - dst) * coverage);
+			}
+		}
+
+		/// @brief 1 行分のカバレッジを集計するクラス
+		/// @remark 横線が完全に覆うピクセルの範囲は、両端の差分（`m_delta`）だけを記録し、書き出すときに累積する。
+		/// 横線の両端のピクセルだけは、覆う長さを `m_partial` に直接加える。
+		/// これにより、横線 1 本あたりの処理は、長さにかかわらず一定になる。
+		class CoverageRow
+		{
+		public:
+
+			[[nodiscard]]
+			explicit CoverageRow(const int width)
+				: m_delta(width + 1)
+				, m_partial(width + 1)
+				, m_width{ width } {}
+
+			/// @brief ピクセルの角の座標で [left, right) の横線を、重み weight で加えます。
+			void addSpan(double left, double right, const float weight) noexcept
+			{
+				left = std::max(left, 0.0);
+				right = std::min(right, static_cast<double>(m_width));
+
+				if (right <= left)
+				{
+					return;
+				}
+
+				const int x0 = static_cast<int>(left);
+				const int x1 = static_cast<int>(right);
+
+				if (x0 == x1)
+				{
+					m_partial[x0] += (static_cast<float>(right - left) * weight);
+				}
+				else
+				{
+					m_partial[x0] += (static_cast<float>((x0 + 1) - left) * weight);
+					m_delta[x0 + 1] += weight;
+					m_delta[x1] -= weight;
+					m_partial[x1] += (static_cast<float>(right - x1) * weight);
+				}
+
+				m_minX = std::min(m_minX, x0);
+				m_maxX = std::max(m_maxX, x1);
+			}
+
+			/// @brief 集計したカバレッジに応じて行に色を塗り、集計をリセットします。
+			template <class PixelType>
+			void flush(PixelType* row, const PixelType& color) noexcept
+			{
+				if (m_maxX < m_minX)
+				{
+					return;
+				}
+
+				const int end = std::min((m_maxX + 1), m_width);
+				float running = 0.0f;
+
+				for (int x = m_minX; x < end;)
+				{
+					running += m_delta[x];
+					const float coverage = (running + m_partial[x]);
+
+					if (FullCoverage <= coverage)
+					{
+						// 完全に覆われている範囲を探し、まとめて塗る
+						int runEnd = (x + 1);
+
+						for (; runEnd < end; ++runEnd)
+						{
+							const float next = (running + m_delta[runEnd]);
+
+							if ((next + m_partial[runEnd]) < FullCoverage)
+							{
+								break;
+							}
+
+							running = next;
+						}
+
+						FillSpan(row, x, runEnd, color);
+						x = runEnd;
+					}
+					else
+					{
+						if (0.0f < coverage)
+						{
+							row[x] = Mix(row[x], color, coverage);
+						}
+
+						++x;
+					}
+				}
+
+				std::fill((m_delta.begin() + m_minX), (m_delta.begin() + m_maxX + 1), 0.0f);
+				std::fill((m_partial.begin() + m_minX), (m_partial.begin() + m_maxX + 1), 0.0f);
+				m_minX = std::numeric_limits<int>::max();
+				m_maxX = std::numeric_limits<int>::min();
+			}
+
+		private:
+
+			/// @brief 完全に覆う範囲の、カバレッジの差分
+			std::vector<float> m_delta;
+
+			/// @brief 横線の両端のピクセルのカバレッジ
+			std::vector<float> m_partial;
+
+			/// @brief 行の幅（ピクセル）
+			int m_width = 0;
+
+			/// @brief 集計した範囲の左端
+			int m_minX = std::numeric_limits<int>::max();
+
+			/// @brief 集計した範囲の右端（含む）
+			int m_maxX = std::numeric_limits<int>::min();
+		};
+
+		/// @brief 図形を、行ごとの横線（スパン）に分解して塗りつぶします。
+		/// @param top 図形の上端（ピクセルの角の座標）
+		/// @param bottom 図形の下端（ピクセルの角の座標、含まない）
+		/// @param spans 横線を求める関数。Y 座標と、横線 [left, right) を受け取る関数を受け取ります。Y 座標は増加する順に渡されます
+		template <class PixelType, class SpanFunction>
+		void RasterizeSpans(BasicImage<PixelType>& image, const double top, const double bottom, const PixelType& color, const bool antialiased, SpanFunction&& spans)
+		{
+			const int width = image.width();
+			const double maxX = width;
+			const double maxY = image.height();
+
+			if (!antialiased)
+			{
+				// ピクセルの中心 (x + 0.5, y + 0.5) が内側にあるピクセルを塗る
+				const int y0 = static_cast<int>(std::clamp(std::ceil(top - 0.5), 0.0, maxY));
+				const int y1 = static_cast<int>(std::clamp(std::ceil(bottom - 0.5), 0.0, maxY));
+
+				for (int y = y0; y < y1; ++y)
+				{
+					PixelType* row = image[y];
+
+					spans((y + 0.5), [&](const double left, const double right)
+					{
+						// 画像の範囲への切り詰めは、横線ごとに 1 回だけ行う
+						const int x0 = static_cast<int>(std::clamp(std::ceil(left - 0.5), 0.0, maxX));
+						const int x1 = static_cast<int>(std::clamp(std::ceil(right - 0.5), 0.0, maxX));
+
+						if (x0 < x1)
+						{
+							FillSpan(row, x0, x1, color);
+						}
+					});
+				}
+			}
+			else
+			{
+				const int y0 = static_cast<int>(std::clamp(std::floor(top), 0.0, maxY));
+				const int y1 = static_cast<int>(std::clamp(std::ceil(bottom), 0.0, maxY));
+				constexpr float Weight = (1.0f / SubScanlines);
+				CoverageRow coverage{ width };
+
+				for (int y = y0; y < y1; ++y)
+				{
+					for (int k = 0; k < SubScanlines; ++k)
+					{
+						const double sampleY = (y + (k + 0.5) / SubScanlines);
+
+						if ((sampleY < top) || (bottom <= sampleY))
+						{
+							continue;
+						}
+
+						spans(sampleY, [&](const double left, const double right)
+						{
+							coverage.addSpan(left, right, Weight);
+						});
+					}
+
+					coverage.flush(image[y], color);
+				}
+			}
+		}
+
+		/// @brief 多角形の辺
+		struct Edge
+		{
+			/// @brief 上端の Y 座標
+			double top = 0.0;
+
+			/// @brief 下端の Y 座標（含まない）
+			double bottom = 0.0;
+
+			/// @brief 上端の X 座標
+			double x = 0.0;
+
+			/// @brief Y が 1 増えたときの X の増分
+			double slope = 0.0;
+
+			/// @brief 下向きの辺は +1, 上向きの辺は -1
+			int winding = 0;
+
+			/// @brief Y 座標における X 座標を返します。
+			[[nodiscard]]
+			double xAt(const double y) const noexcept
+			{
+				return (x + (y - top) * slope);
+			}
+
+			/// @brief 2 点を結ぶ辺を作成します。
+			[[nodiscard]]
+			static Edge Make(double x0, double y0, double x1, double y1) noexcept
+			{
+				int winding = 1;
+
+				if (y1 < y0)
+				{
+					std::swap(x0, x1);
+					std::swap(y0, y1);
+					winding = -1;
+				}
+
+				return{ y0, y1, x0, ((x1 - x0) / (y1 - y0)), winding };
+			}
+		};
+
+		/// @brief 任意の多角形の横線を、辺の表（active edge table）を使って求めるクラス
+		class PolygonSpans
+		{
+		public:
+
+			[[nodiscard]]
+			explicit PolygonSpans(const std::span<const Point> points)
+			{
+				m_edges.reserve(points.size());
+
+				for (std::size_t i = 0; i < points.size(); ++i)
+				{
+					const Point& p0 = points[i];
+					const Point& p1 = points[((i + 1) == points.size()) ? 0 : (i + 1)];
+
+					// 水平な辺は横線と交わらないので除く
+					if (p0.y != p1.y)
+					{
+						m_edges.push_back(Edge::Make(p0.x, p0.y, p1.x, p1.y));
+					}
+				}
+
+				// 上端の順に並べておき、Y 座標が進むごとに先頭から順に有効にする
+				std::sort(m_edges.begin(), m_edges.end(), [](const Edge& a, const Edge& b) { return (a.top < b.top); });
+
+				for (const Edge& edge : m_edges)
+				{
+					m_top = std::min(m_top, edge.top);
+					m_bottom = std::max(m_bottom, edge.bottom);
+				}
+
+				m_active.reserve(m_edges.size());
+			}
+
+			[[nodiscard]]
+			double top() const noexcept
+			{
+				return m_top;
+			}
+
+			[[nodiscard]]
+			double bottom() const noexcept
+			{
+				return m_bottom;
+			}
+
+			template <class Emit>
+			void operator ()(const double y, Emit&& emit)
+			{
+				// 上端に達した辺を有効にし、下端を過ぎた辺を除く
+				for (; (m_next < m_edges.size()) && (m_edges[m_next].top <= y); ++m_next)
+				{
+					m_active.push_back({ 0.0, &m_edges[m_next] });
+				}
+
+				std::erase_if(m_active, [=](const ActiveEdge& active) { return (active.edge->bottom <= y); });
+
+				// 交点を左から順に並べる。前の Y 座標とほとんど同じ順に並んでいるので、挿入ソートがほぼ線形時間で終わる
+				for (std::size_t i = 0; i < m_active.size(); ++i)
+				{
+					const ActiveEdge current{ m_active[i].edge->xAt(y), m_active[i].edge };
+					std::size_t k = i;
+
+					for (; (0 < k) && (current.x < m_active[k - 1].x); --k)
+					{
+						m_active[k] = m_active[k - 1];
+					}
+
+					m_active[k] = current;
+				}
+
+				// 回転数が 0 でない区間を塗る
+				int winding = 0;
+				double left = 0.0;
+
+				for (const ActiveEdge& active : m_active)
+				{
+					const int previous = winding;
+					winding += active.edge->winding;
+
+					if ((previous == 0) && (winding != 0))
+					{
+						left = active.x;
+					}
+					else if ((previous != 0) && (winding == 0))
+					{
+						emit(left, active.x);
+					}
+				}
+			}
+
+		private:
+
+			/// @brief 現在の Y 座標と交わる辺
+			struct ActiveEdge
+			{
+				/// @brief 現在の Y 座標における X 座標
+				double x;
+
+				const Edge* edge;
+			};
+
+			/// @brief すべての辺（上端の順）
+			std::vector<Edge> m_edges;
+
+			/// @brief 現在の Y 座標と交わる辺（X 座標の順）
+			std::vector<ActiveEdge> m_active;
+
+			/// @brief 次に有効にする辺のインデックス
+			std::size_t m_next = 0;
+
+			double m_top = std::numeric_limits<double>::max();
+
+			double m_bottom = std::numeric_limits<double>::lowest();
+		};
+	}
+
+	template <class PixelType>
+	void FillRect(BasicImage<PixelType>& image, const Rect& rect, const PixelType& color)
+	{
+		const Rect region = rect.intersection(Rect{ 0, 0, image.width(), image.height() });
+
+		if (region.isEmpty())
+		{
+			return;
+		}
+
+		for (int y = region.y; y < (region.y + region.h); ++y)
+		{
+			FillSpan(image[y], region.x, (region.x + region.w), color);
+		}
+	}
+
+	template <class PixelType>
+	void DrawRect(BasicImage<PixelType>& image, const Rect& rect, const PixelType& color, const int thickness)
+	{
+		if (thickness <= 0)
+		{
+			return;
+		}
+
+		// 枠が内側を埋め尽くす場合は、全体を塗りつぶす
+		if ((rect.w <= (thickness * 2)) || (rect.h <= (thickness * 2)))
+		{
+			FillRect(image, rect, color);
+			return;
+		}
+
+		FillRect(image, Rect{ rect.x, rect.y, rect.w, thickness }, color);
+		FillRect(image, Rect{ rect.x, (rect.y + rect.h - thickness), rect.w, thickness }, color);
+		FillRect(image, Rect{ rect.x, (rect.y + thickness), thickness, (rect.h - thickness * 2) }, color);
+		FillRect(image, Rect{ (rect.x + rect.w - thickness), (rect.y + thickness), thickness, (rect.h - thickness * 2) }, color);
+	}
+
+	template <class PixelType>
+	void FillCircle(BasicImage<PixelType>& image, const Point& center, const double radius, const PixelType& color, const bool antialiased)
+	{
+		FillEllipse(image, center, radius, radius, color, antialiased);
+	}
+
+	template <class PixelType>
+	void FillEllipse(BasicImage<PixelType>& image, const Point& center, const double radiusX, const double radiusY, const PixelType& color, const bool antialiased)
+	{
+		if ((radiusX < 0.0) || (radiusY < 0.0))
+		{
+			return;
+		}
+
+		// 中心のピクセルの中心を、楕円の中心とする
+		const double cx = (center.x + 0.5);
+		const double cy = (center.y + 0.5);
+		constexpr double Infinity = std::numeric_limits<double>::infinity();
+
+		// ちょうど境界上にあるピクセルも塗るよう、下端と右端を閉区間にする（左右、上下が対称になる）
+		RasterizeSpans(image, (cy - radiusY), std::nextafter((cy + radiusY), Infinity), color, antialiased, [&](const double y, auto&& emit)
+		{
+			// 円の場合に、整数の座標で誤差が出ないよう、半径で割る前に平方根をとる
+			const double dy = (y - cy);
+			const double t = (radiusY * radiusY - dy * dy);
+
+			if (t < 0.0)
+			{
+				return;
+			}
+
+			const double halfWidth = ((radiusY == 0.0) ? radiusX : ((radiusX / radiusY) * std::sqrt(t)));
+			emit((cx - halfWidth), std::nextafter((cx + halfWidth), Infinity));
+		});
+	}
+
+	template <class PixelType>
+	void DrawLine(BasicImage<PixelType>& image, const Point& from, const Point& to, const PixelType& color, const double thickness, const bool antialiased)
+	{
+		if (thickness <= 0.0)
+		{
+			return;
+		}
+
+		// 端点のピクセルの中心を結ぶ
+		const double x0 = (from.x + 0.5);
+		const double y0 = (from.y + 0.5);
+		const double x1 = (to.x + 0.5);
+		const double y1 = (to.y + 0.5);
+		const double length = std::hypot((x1 - x0), (y1 - y0));
+		constexpr double Infinity = std::numeric_limits<double>::infinity();
+
+		// 線の向きの単位ベクトル（始点と終点が同じ場合は右向きとする）
+		const double ux = ((0.0 < length) ? ((x1 - x0) / length) : 1.0);
+		const double uy = ((0.0 < length) ? ((y1 - y0) / length) : 0.0);
+		const double h = (thickness * 0.5);
+
+		// 両端を太さの半分だけ延ばした長方形の 4 つの頂点
+		const double ax = (x0 - ux * h), ay = (y0 - uy * h);
+		const double bx = (x1 + ux * h), by = (y1 + uy * h);
+		const double nx = (-uy * h), ny = (ux * h);
+		const std::array<Edge, 4> edges =
+		{
+			Edge::Make((ax + nx), (ay + ny), (bx + nx), (by + ny)),
+			Edge::Make((bx + nx), (by + ny), (bx - nx), (by - ny)),
+			Edge::Make((bx - nx), (by - ny), (ax - nx), (ay - ny)),
+			Edge::Make((ax - nx), (ay - ny), (ax + nx), (ay + ny)),
+		};
+
+		const double top = std::min({ (ay + ny), (ay - ny), (by + ny), (by - ny) });
+		const double bottom = std::max({ (ay + ny), (ay - ny), (by + ny), (by - ny) });
+
+		// 凸多角形なので、交点の最小値と最大値の間が横線になる（辺の表は不要）
+		RasterizeSpans(image, top, bottom, color, antialiased, [&](const double y, auto&& emit)
+		{
+			double left = Infinity;
+			double right = -Infinity;
+
+			for (const Edge& edge : edges)
+			{
+				// 水平な辺（top == bottom）はどの Y 座標とも交わらない
+				if ((edge.top <= y) && (y < edge.bottom))
+				{
+					const double x = edge.xAt(y);
+					left = std::min(left, x);
+					right = std::max(right, x);
+				}
+			}
+
+			if (left < right)
+			{
+				emit(left, right);
+			}
+		});
+	}
+
+	template <class PixelType>
+	void FillPolygon(BasicImage<PixelType>& image, const std::span<const Point> points, const PixelType& color, const bool antialiased)
+	{
+		if (points.size() < 3)
+		{
+			return;
+		}
+
+		PolygonSpans spans{ points };
+		RasterizeSpans(image, spans.top(), spans.bottom(), color, antialiased, spans);
+	}
+
+	// 対応するピクセルの型について、明示的にインスタンス化する
+	template void FillRect<Color>(Image&, const Rect&, const Color&);
+	template void FillRect<ColorF>(ImageF&, const Rect&, const ColorF&);
+	template void FillRect<Color8>(Image8&, const Rect&, const Color8&);
+	template void FillRect<ColorA8>(ImageA8&, const Rect&, const ColorA8&);
+	template void DrawRect<Color>(Image&, const Rect&, const Color&, int);
+	template void DrawRect<ColorF>(ImageF&, const Rect&, const ColorF&, int);
+	template void DrawRect<Color8>(Image8&, const Rect&, const Color8&, int);
+	template void DrawRect<ColorA8>(ImageA8&, const Rect&, const ColorA8&, int);
+	template void FillCircle<Color>(Image&, const Point&, double, const Color&, bool);
+	template void FillCircle<ColorF>(ImageF&, const Point&, double, const ColorF&, bool);
+	template void FillCircle<Color8>(Image8&, const Point&, double, const Color8&, bool);
+	template void FillCircle<ColorA8>(ImageA8&, const Point&, double, const ColorA8&, bool);
+	template void FillEllipse<Color>(Image&, const Point&, double, double, const Color&, bool);
+	template void FillEllipse<ColorF>(ImageF&, const Point&, double, double, const ColorF&, bool);
+	template void FillEllipse<Color8>(Image8&, const Point&, double, double, const Color8&, bool);
+	template void FillEllipse<ColorA8>(ImageA8&, const Point&, double, double, const ColorA8&, bool);
+	template void DrawLine<Color>(Image&, const Point&, const Point&, const Color&, double, bool);
+	template void DrawLine<ColorF>(ImageF&, const Point&, const Point&, const ColorF&, double, bool);
+	template void DrawLine<Color8>(Image8&, const Point&, const Point&, const Color8&, double, bool);
+	template void DrawLine<ColorA8>(ImageA8&, const Point&, const Point&, const ColorA8&, double, bool);
+	template void FillPolygon<Color>(Image&, std::span<const Point>, const Color&, bool);
+	template void FillPolygon<ColorF>(ImageF&, std::span<const Point>, const ColorF&, bool);
+	template void FillPolygon<Color8>(Image8&, std::span<const Point>, const Color8&, bool);
+	template void FillPolygon<ColorA8>(ImageA8&, std::span<const Point>, const ColorA8&, bool);
+}
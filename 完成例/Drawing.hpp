@@ -0,0 +1,76 @@
+﻿#pragma once
+#include <span>			// std::span
+#include "Image.hpp"	// mini::BasicImage
+#include "Point.hpp"	// mini::Point
+#include "Rect.hpp"		// mini::Rect
+
+namespace mini
+{
+	// 座標の扱い
+	// - ピクセル (x, y) は、連続な座標の [x, x + 1) × [y, y + 1) の正方形を占めるものとします（`Rect` と同じ）。
+	// - アンチエイリアスなしの場合は、中心 (x + 0.5, y + 0.5) が図形の内側にあるピクセルを塗ります。
+	// - アンチエイリアスありの場合は、図形がピクセルを覆う面積の割合（カバレッジ）に応じて、元の色と混ぜます。
+	// - 画像からはみ出す部分は、各行の塗りつぶす範囲（スパン）ごとに 1 回だけ切り詰めます。
+
+	/// @brief 長方形を塗りつぶします。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param image 描画先の画像
+	/// @param rect 塗りつぶす長方形
+	/// @param color 色
+	template <class PixelType>
+	void FillRect(BasicImage<PixelType>& image, const Rect& rect, const PixelType& color);
+
+	/// @brief 長方形の枠を描きます。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param image 描画先の画像
+	/// @param rect 枠の外側の長方形
+	/// @param color 色
+	/// @param thickness 枠の太さ（ピクセル）。長方形の内側に向かって太くなります
+	template <class PixelType>
+	void DrawRect(BasicImage<PixelType>& image, const Rect& rect, const PixelType& color, int thickness = 1);
+
+	/// @brief 円を塗りつぶします。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param image 描画先の画像
+	/// @param center 中心のピクセル
+	/// @param radius 半径（ピクセル）
+	/// @param color 色
+	/// @param antialiased アンチエイリアスをかける場合 true
+	/// @remark アンチエイリアスなしの場合は、中心からの距離が半径以下のピクセルを塗ります。
+	template <class PixelType>
+	void FillCircle(BasicImage<PixelType>& image, const Point& center, double radius, const PixelType& color, bool antialiased = false);
+
+	/// @brief 軸に平行な楕円を塗りつぶします。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param image 描画先の画像
+	/// @param center 中心のピクセル
+	/// @param radiusX X 方向の半径（ピクセル）
+	/// @param radiusY Y 方向の半径（ピクセル）
+	/// @param color 色
+	/// @param antialiased アンチエイリアスをかける場合 true
+	template <class PixelType>
+	void FillEllipse(BasicImage<PixelType>& image, const Point& center, double radiusX, double radiusY, const PixelType& color, bool antialiased = false);
+
+	/// @brief 線分を描きます。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param image 描画先の画像
+	/// @param from 始点のピクセル
+	/// @param to 終点のピクセル
+	/// @param color 色
+	/// @param thickness 線の太さ（ピクセル）
+	/// @param antialiased アンチエイリアスをかける場合 true
+	/// @remark 線の両端は、太さの半分だけ延ばした四角い形になります。始点と終点のピクセルは必ず塗られます。
+	template <class PixelType>
+	void DrawLine(BasicImage<PixelType>& image, const Point& from, const Point& to, const PixelType& color, double thickness = 1.0, bool antialiased = false);
+
+	/// @brief 多角形を塗りつぶします。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param image 描画先の画像
+	/// @param points 頂点の配列（ピクセルの角の座標）。最後の頂点と最初の頂点は自動的に結ばれます
+	/// @param color 色
+	/// @param antialiased アンチエイリアスをかける場合 true
+	/// @remark 自己交差する多角形は、非ゼロ回転数規則（nonzero winding rule）で内側を判定します。
+	/// 辺の表（active edge table）を使い、上の行から順に、各行と交わる辺だけを調べて塗りつぶす範囲を求めます。
+	template <class PixelType>
+	void FillPolygon(BasicImage<PixelType>& image, std::span<const Point> points, const PixelType& color, bool antialiased = false);
+}
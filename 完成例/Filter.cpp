@@ -0,0 +1,845 @@
+﻿#include <algorithm>	// std::min, std::max, std::fill_n, std::copy_n, std::clamp
+#include <bit>			// std::bit_ceil
+#include <cmath>		// std::ceil, std::exp, std::sqrt
+#include <complex>		// std::complex, std::polar, std::conj
+#include <numbers>		// std::numbers::pi
+#include <utility>		// std::swap
+#include <cstddef>		// std::size_t
+#include <vector>		// std::vector
+#include "Filter.hpp"
+#include "IntegralImage.hpp"	// mini::IntegralImage
+#include "PixelCast.hpp"	// mini::PixelCast
+#include "PixelAccumulator.hpp"	// mini::AccumulatorType, mini::ToChannels, mini::FromChannels
+#include "ThreadPool.hpp"	// mini::GetDefaultThreadPool
+
+namespace mini
+{
+	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+	namespace
+	{
+		/// @brief 1 つの列のブロックで使う作業領域の目安（L2 キャッシュに収まる大きさ）
+		constexpr std::size_t BlockBytes = (256 * 1024);
+
+		/// @brief 範囲外の位置を、境界の扱い方に従って範囲内の位置に変換します。
+		/// @param i 位置
+		/// @param n 範囲の大きさ
+		/// @param borderMode 範囲外のピクセルの扱い方
+		/// @return 範囲内の位置。`BorderMode::Zero` で範囲外の場合は -1
+		[[nodiscard]]
+		int BorderIndex(int i, const int n, const BorderMode borderMode) noexcept
+		{
+			if ((0 <= i) && (i < n))
+			{
+				return i;
+			}
+
+			switch (borderMode)
+			{
+			case BorderMode::Replicate:
+				return std::clamp(i, 0, (n - 1));
+			case BorderMode::Reflect:
+				// 周期 2n で折り返す（半径が画像より大きい場合も範囲内に収まるように）
+				i %= (2 * n);
+				i = ((i < 0) ? (i + 2 * n) : i);
+				return ((i < n) ? i : (2 * n - 1 - i));
+			case BorderMode::Wrap:
+				i %= n;
+				return ((i < 0) ? (i + n) : i);
+			default:
+				return -1;
+			}
+		}
+
+		/// @brief 正規化したガウス関数の重みを返します。
+		/// @param sigma 標準偏差
+		/// @return 重み（要素数は 2r + 1）
+		template <class Type>
+		[[nodiscard]]
+		std::vector<Type> GaussianKernel(const double sigma)
+		{
+			const int radius = std::max(1, static_cast<int>(std::ceil(3.0 * sigma)));
+			std::vector<double> weights(2 * radius + 1);
+			double sum = 0.0;
+
+			for (int i = -radius; i <= radius; ++i)
+			{
+				weights[i + radius] = std::exp(-(i * i) / (2.0 * sigma * sigma));
+				sum += weights[i + radius];
+			}
+
+			std::vector<Type> kernel(weights.size());
+
+			for (std::size_t i = 0; i < weights.size(); ++i)
+			{
+				kernel[i] = static_cast<Type>(weights[i] / sum);
+			}
+
+			return kernel;
+		}
+
+		/// @brief 行の帯 [y0, y1) に、分離可能なフィルタをかけます。
+		/// @param src 元の画像
+		/// @param dst 結果の画像
+		/// @param y0 帯の先頭の行
+		/// @param y1 帯の終端の行（含まない）
+		/// @param rowKernel 水平方向のフィルタの重み（中心は `size() / 2` 番目）
+		/// @param columnKernel 垂直方向のフィルタの重み（中心は `size() / 2` 番目）
+		/// @param borderMode 画像の範囲外のピクセルの扱い方
+		/// @remark 列のブロックごとに、水平方向にフィルタをかけた直近の行（垂直方向の重みの数だけ）をリングバッファに保持し、垂直方向のフィルタをかけます。
+		template <class PixelType, class Type>
+		void SeparableFilterBand(const BasicImage<PixelType>& src, BasicImage<PixelType>& dst, const int y0, const int y1,
+			const std::vector<Type>& rowKernel, const std::vector<Type>& columnKernel, const BorderMode borderMode)
+		{
+			const int width = src.width();
+			const int height = src.height();
+			const int numTapsX = static_cast<int>(rowKernel.size());
+			const int numTapsY = static_cast<int>(columnKernel.size());
+			const int anchorX = (numTapsX / 2);
+			const int anchorY = (numTapsY / 2);
+
+			// リングバッファと作業用の行が L2 キャッシュに収まる列数（ただし、ブロックの両端の余分な計算が多くなりすぎないようにする）
+			const int blockWidth = std::min(width, std::max({ 64, (2 * numTapsX),
+				static_cast<int>(BlockBytes / ((numTapsY + 2) * 3 * sizeof(Type))) }));
+
+			std::vector<Type> extended((blockWidth + numTapsX - 1) * 3);
+			std::vector<Type> ring(static_cast<std::size_t>(numTapsY) * blockWidth * 3);
+			std::vector<Type> sum(blockWidth * 3);
+			std::vector<int> sourceX(blockWidth + numTapsX - 1);
+
+			for (int x0 = 0; x0 < width; x0 += blockWidth)
+			{
+				const int blockPixels = std::min(blockWidth, (width - x0));
+				const int n = (blockPixels * 3);
+
+				for (int i = 0; i < (blockPixels + numTapsX - 1); ++i)
+				{
+					sourceX[i] = BorderIndex((x0 - anchorX + i), width, borderMode);
+				}
+
+				// 画像の行 y に対応するリングバッファの行
+				const auto ringRow = [&](const int y)
+				{
+					return (ring.data() + static_cast<std::size_t>((y % numTapsY + numTapsY) % numTapsY) * blockWidth * 3);
+				};
+
+				// 画像の行 y のブロックに水平方向のフィルタをかけて、リングバッファに書き込む
+				const auto filterRow = [&](const int y)
+				{
+					Type* const out = ringRow(y);
+					std::fill_n(out, n, Type{ 0 });
+
+					const int sy = BorderIndex(y, height, borderMode);
+
+					if (sy < 0)
+					{
+						return;
+					}
+
+					const PixelType* const row = src[sy];
+
+					for (int i = 0; i < (blockPixels + numTapsX - 1); ++i)
+					{
+						if (0 <= sourceX[i])
+						{
+							ToChannels(row[sourceX[i]], (extended.data() + i * 3));
+						}
+						else
+						{
+							std::fill_n((extended.data() + i * 3), 3, Type{ 0 });
+						}
+					}
+
+					for (int k = 0; k < numTapsX; ++k)
+					{
+						const Type weight = rowKernel[k];
+						const Type* const in = (extended.data() + k * 3);
+
+						MINI_IVDEP
+						for (int i = 0; i < n; ++i)
+						{
+							out[i] += (weight * in[i]);
+						}
+					}
+				};
+
+				for (int y = (y0 - anchorY); y < (y0 - anchorY + numTapsY - 1); ++y)
+				{
+					filterRow(y);
+				}
+
+				for (int y = y0; y < y1; ++y)
+				{
+					filterRow(y - anchorY + numTapsY - 1);
+
+					// 垂直方向のフィルタ
+					std::fill_n(sum.data(), n, Type{ 0 });
+
+					for (int k = 0; k < numTapsY; ++k)
+					{
+						const Type weight = columnKernel[k];
+						const Type* const in = ringRow(y - anchorY + k);
+
+						MINI_IVDEP
+						for (int i = 0; i < n; ++i)
+						{
+							sum[i] += (weight * in[i]);
+						}
+					}
+
+					PixelType* const out = (dst[y] + x0);
+
+					for (int x = 0; x < blockPixels; ++x)
+					{
+						out[x] = FromChannels<PixelType>(sum.data() + x * 3);
+					}
+				}
+			}
+		}
+
+		/// @brief 直接法で畳み込むタイルの幅
+		constexpr int DirectTileWidth = 128;
+
+		/// @brief 直接法で畳み込むタイルの高さ
+		constexpr int DirectTileHeight = 32;
+
+		/// @brief `ConvolutionMethod::Auto` で直接法を使う重みの数の上限
+		constexpr int MaxDirectTaps = 121;
+
+		/// @brief 範囲（画像の外にはみ出してもよい）のピクセルを、境界の扱い方に従って数値の配列に読み込みます。
+		/// @param src 画像
+		/// @param region 読み込む範囲
+		/// @param borderMode 画像の範囲外のピクセルの扱い方
+		/// @param dst 書き込み先（region.w * region.h * 3 要素）
+		template <class PixelType, class Type>
+		void LoadPaddedTile(const BasicImage<PixelType>& src, const Rect& region, const BorderMode borderMode, Type* dst)
+		{
+			std::vector<int> sourceX(region.w);
+
+			for (int i = 0; i < region.w; ++i)
+			{
+				sourceX[i] = BorderIndex((region.x + i), src.width(), borderMode);
+			}
+
+			for (int j = 0; j < region.h; ++j)
+			{
+				Type* const out = (dst + static_cast<std::size_t>(j) * region.w * 3);
+				const int sy = BorderIndex((region.y + j), src.height(), borderMode);
+
+				if (sy < 0)
+				{
+					std::fill_n(out, (region.w * 3), Type{ 0 });
+					continue;
+				}
+
+				const PixelType* const row = src[sy];
+
+				for (int i = 0; i < region.w; ++i)
+				{
+					if (0 <= sourceX[i])
+					{
+						ToChannels(row[sourceX[i]], (out + i * 3));
+					}
+					else
+					{
+						std::fill_n((out + i * 3), 3, Type{ 0 });
+					}
+				}
+			}
+		}
+
+		/// @brief 直接法で、1 つのタイルを畳み込みます。
+		/// @tparam Width 重みの行列の幅（0 の場合は実行時に決まる）
+		/// @tparam Height 重みの行列の高さ（0 の場合は実行時に決まる）
+		/// @remark 行列のサイズがコンパイル時に決まる場合は、各要素の積和をすべてレジスタ上で計算します。
+		template <int Width, int Height, class PixelType, class Type>
+		void ConvolveDirectTile(const BasicImage<PixelType>& src, BasicImage<PixelType>& dst, const Rect& tile,
+			const Kernel& kernel, const std::vector<Type>& weights, const BorderMode borderMode)
+		{
+			const int kernelWidth = ((0 < Width) ? Width : kernel.width());
+			const int kernelHeight = ((0 < Height) ? Height : kernel.height());
+			const Point anchor = kernel.anchor();
+			const int paddedWidth = (tile.w + kernelWidth - 1);
+			const std::size_t rowStride = (static_cast<std::size_t>(paddedWidth) * 3);
+			const int n = (tile.w * 3);
+
+			std::vector<Type> padded(rowStride * (tile.h + kernelHeight - 1));
+			std::vector<Type> sum(n);
+			LoadPaddedTile(src, Rect{ (tile.x - anchor.x), (tile.y - anchor.y), paddedWidth, (tile.h + kernelHeight - 1) }, borderMode, padded.data());
+
+			for (int y = 0; y < tile.h; ++y)
+			{
+				const Type* const in = (padded.data() + y * rowStride);
+
+				if constexpr ((0 < Width) && (0 < Height))
+				{
+					Type w[Width * Height];
+					std::copy_n(weights.data(), (Width * Height), w);
+
+					MINI_IVDEP
+					for (int i = 0; i < n; ++i)
+					{
+						Type s = 0;
+
+						for (int ky = 0; ky < Height; ++ky)
+						{
+							for (int kx = 0; kx < Width; ++kx)
+							{
+								s += (w[ky * Width + kx] * in[ky * rowStride + kx * 3 + i]);
+							}
+						}
+
+						sum[i] = s;
+					}
+				}
+				else
+				{
+					std::fill_n(sum.data(), n, Type{ 0 });
+
+					for (int ky = 0; ky < kernelHeight; ++ky)
+					{
+						for (int kx = 0; kx < kernelWidth; ++kx)
+						{
+							const Type weight = weights[ky * kernelWidth + kx];
+
+							if (weight == 0)
+							{
+								continue;
+							}
+
+							const Type* const p = (in + ky * rowStride + kx * 3);
+
+							MINI_IVDEP
+							for (int i = 0; i < n; ++i)
+							{
+								sum[i] += (weight * p[i]);
+							}
+						}
+					}
+				}
+
+				PixelType* const out = (dst[tile.y + y] + tile.x);
+
+				for (int x = 0; x < tile.w; ++x)
+				{
+					out[x] = FromChannels<PixelType>(sum.data() + x * 3);
+				}
+			}
+		}
+
+		/// @brief 直接法で畳み込みます。
+		template <int Width, int Height, class PixelType>
+		void ConvolveDirect(const BasicImage<PixelType>& src, BasicImage<PixelType>& dst, const Kernel& kernel, const BorderMode borderMode)
+		{
+			using Type = AccumulatorType<PixelType>;
+			const std::vector<Type> weights(kernel.values().begin(), kernel.values().end());
+
+			GetDefaultThreadPool().parallelFor(Rect{ 0, 0, src.width(), src.height() }, Point{ DirectTileWidth, DirectTileHeight }, [&](const Rect& tile)
+			{
+				ConvolveDirectTile<Width, Height>(src, dst, tile, kernel, weights, borderMode);
+			});
+		}
+
+		/// @brief 基数 2 の高速フーリエ変換
+		class FFTPlan
+		{
+		public:
+
+			/// @brief 指定した要素数（2 のべき乗）の変換を準備します。
+			explicit FFTPlan(const int size)
+				: m_size{ size }
+				, m_reversed(size)
+				, m_twiddles(size / 2)
+			{
+				for (int i = 0, j = 0; i < size; ++i)
+				{
+					m_reversed[i] = j;
+
+					// j をビットの並びを逆にした数として 1 進める
+					int bit = (size >> 1);
+
+					for (; (j & bit); bit >>= 1)
+					{
+						j ^= bit;
+					}
+
+					j |= bit;
+				}
+
+				for (int k = 0; k < (size / 2); ++k)
+				{
+					m_twiddles[k] = std::polar(1.0, (-2.0 * std::numbers::pi * k / size));
+				}
+			}
+
+			/// @brief 要素数を返します。
+			[[nodiscard]]
+			int size() const noexcept
+			{
+				return m_size;
+			}
+
+			/// @brief 1 次元の変換をその場で行います。
+			/// @param data 要素（`size()` 個）
+			/// @param inverse 逆変換の場合 true（1 / size() 倍はしない）
+			void transform(std::complex<double>* data, const bool inverse) const noexcept
+			{
+				for (int i = 0; i < m_size; ++i)
+				{
+					if (i < m_reversed[i])
+					{
+						std::swap(data[i], data[m_reversed[i]]);
+					}
+				}
+
+				for (int length = 2; length <= m_size; length <<= 1)
+				{
+					const int half = (length / 2);
+					const int step = (m_size / length);
+
+					for (int i = 0; i < m_size; i += length)
+					{
+						for (int k = 0; k < half; ++k)
+						{
+							const std::complex<double> w = (inverse ? std::conj(m_twiddles[k * step]) : m_twiddles[k * step]);
+							const std::complex<double> u = data[i + k];
+							const std::complex<double> v = (data[i + k + half] * w);
+							data[i + k] = (u + v);
+							data[i + k + half] = (u - v);
+						}
+					}
+				}
+			}
+
+			/// @brief 2 次元の順変換をその場で行います。
+			/// @param data 要素（size() x size()、行優先）
+			/// @param numRows 0 でない値を含む先頭からの行数（残りの行は 0 なので行方向の変換を省く）
+			void forward2D(std::complex<double>* data, const int numRows) const
+			{
+				for (int y = 0; y < numRows; ++y)
+				{
+					transform((data + static_cast<std::size_t>(y) * m_size), false);
+				}
+
+				transformColumns(data, false);
+			}
+
+			/// @brief 2 次元の逆変換をその場で行います（1 / size()^2 倍はしない）。
+			/// @param data 要素（size() x size()、行優先）
+			/// @param rowBegin 結果が必要な行の先頭
+			/// @param rowEnd 結果が必要な行の終端（含まない。それ以外の行の行方向の変換を省く）
+			void inverse2D(std::complex<double>* data, const int rowBegin, const int rowEnd) const
+			{
+				transformColumns(data, true);
+
+				for (int y = rowBegin; y < rowEnd; ++y)
+				{
+					transform((data + static_cast<std::size_t>(y) * m_size), true);
+				}
+			}
+
+		private:
+
+			int m_size = 0;
+
+			/// @brief 各位置の、ビットの並びを逆にした位置
+			std::vector<int> m_reversed;
+
+			/// @brief 回転因子 exp(-2πik / size)
+			std::vector<std::complex<double>> m_twiddles;
+
+			/// @brief 各列を、作業用の配列にコピーして変換します。
+			void transformColumns(std::complex<double>* data, const bool inverse) const
+			{
+				std::vector<std::complex<double>> column(m_size);
+
+				for (int x = 0; x < m_size; ++x)
+				{
+					for (int y = 0; y < m_size; ++y)
+					{
+						column[y] = data[static_cast<std::size_t>(y) * m_size + x];
+					}
+
+					transform(column.data(), inverse);
+
+					for (int y = 0; y < m_size; ++y)
+					{
+						data[static_cast<std::size_t>(y) * m_size + x] = column[y];
+					}
+				}
+			}
+		};
+
+		/// @brief 高速フーリエ変換を使って畳み込みます。
+		/// @remark 画像を (N - 行列のサイズ + 1) ピクセル四方のタイルに分け、周囲を含めた N x N の範囲の巡回畳み込みから、
+		/// 巡回の影響を受けない部分だけを取り出します（overlap-save 法）。重みは実数なので、赤と緑を 1 つの複素数にまとめて変換します。
+		template <class PixelType>
+		void ConvolveFFT(const BasicImage<PixelType>& src, BasicImage<PixelType>& dst, const Kernel& kernel, const BorderMode borderMode)
+		{
+			using Type = AccumulatorType<PixelType>;
+			using Complex = std::complex<double>;
+			const int kernelWidth = kernel.width();
+			const int kernelHeight = kernel.height();
+			const Point anchor = kernel.anchor();
+
+			// 取り出せる部分が、変換する範囲の 3/4 程度になる大きさ
+			const int size = static_cast<int>(std::bit_ceil(static_cast<unsigned>(std::max({ 32, (4 * kernelWidth), (4 * kernelHeight) }))));
+			const FFTPlan plan{ size };
+			const std::size_t numElements = (static_cast<std::size_t>(size) * size);
+
+			// 重みを上下左右に反転して配置したもののスペクトル（逆変換の 1 / size^2 倍もここで掛けておく）
+			std::vector<Complex> spectrum(numElements);
+
+			for (int ky = 0; ky < kernelHeight; ++ky)
+			{
+				for (int kx = 0; kx < kernelWidth; ++kx)
+				{
+					spectrum[static_cast<std::size_t>(kernelHeight - 1 - ky) * size + (kernelWidth - 1 - kx)] = kernel[ky][kx];
+				}
+			}
+
+			plan.forward2D(spectrum.data(), kernelHeight);
+
+			for (Complex& c : spectrum)
+			{
+				c /= static_cast<double>(numElements);
+			}
+
+			const Point tileSize{ (size - kernelWidth + 1), (size - kernelHeight + 1) };
+
+			GetDefaultThreadPool().parallelFor(Rect{ 0, 0, src.width(), src.height() }, tileSize, [&](const Rect& tile)
+			{
+				const int paddedWidth = (tile.w + kernelWidth - 1);
+				const int paddedHeight = (tile.h + kernelHeight - 1);
+				std::vector<Type> padded(static_cast<std::size_t>(paddedWidth) * paddedHeight * 3);
+				LoadPaddedTile(src, Rect{ (tile.x - anchor.x), (tile.y - anchor.y), paddedWidth, paddedHeight }, borderMode, padded.data());
+
+				std::vector<Complex> redGreen(numElements), blue(numElements);
+
+				for (int y = 0; y < paddedHeight; ++y)
+				{
+					for (int x = 0; x < paddedWidth; ++x)
+					{
+						const Type* const p = (padded.data() + (static_cast<std::size_t>(y) * paddedWidth + x) * 3);
+						redGreen[static_cast<std::size_t>(y) * size + x] = Complex{ static_cast<double>(p[0]), static_cast<double>(p[1]) };
+						blue[static_cast<std::size_t>(y) * size + x] = Complex{ static_cast<double>(p[2]), 0.0 };
+					}
+				}
+
+				plan.forward2D(redGreen.data(), paddedHeight);
+				plan.forward2D(blue.data(), paddedHeight);
+
+				for (std::size_t i = 0; i < numElements; ++i)
+				{
+					redGreen[i] *= spectrum[i];
+					blue[i] *= spectrum[i];
+				}
+
+				plan.inverse2D(redGreen.data(), (kernelHeight - 1), paddedHeight);
+				plan.inverse2D(blue.data(), (kernelHeight - 1), paddedHeight);
+
+				std::vector<Type> row(static_cast<std::size_t>(tile.w) * 3);
+
+				for (int y = 0; y < tile.h; ++y)
+				{
+					const std::size_t offset = (static_cast<std::size_t>(y + kernelHeight - 1) * size + (kernelWidth - 1));
+
+					for (int x = 0; x < tile.w; ++x)
+					{
+						row[x * 3 + 0] = static_cast<Type>(redGreen[offset + x].real());
+						row[x * 3 + 1] = static_cast<Type>(redGreen[offset + x].imag());
+						row[x * 3 + 2] = static_cast<Type>(blue[offset + x].real());
+					}
+
+					PixelType* const out = (dst[tile.y + y] + tile.x);
+
+					for (int x = 0; x < tile.w; ++x)
+					{
+						out[x] = FromChannels<PixelType>(row.data() + x * 3);
+					}
+				}
+			});
+		}
+
+		/// @brief グレースケール値の積分画像（1 成分のみ）
+		/// @remark 二値化はグレースケール値しか使わないため、3 成分を持つ `IntegralImage` の代わりに使います。
+		class GrayscaleIntegral
+		{
+		public:
+
+			/// @brief 画像のグレースケール値から積分画像を作成します。
+			template <class PixelType>
+			[[nodiscard]]
+			explicit GrayscaleIntegral(const BasicImage<PixelType>& image)
+				: m_width{ image.width() }
+				, m_height{ image.height() }
+				, m_values(static_cast<std::size_t>(m_width) * m_height)
+				, m_sums((static_cast<std::size_t>(m_width) + 1) * (m_height + 1), 0.0)
+				, m_squaredSums((static_cast<std::size_t>(m_width) + 1) * (m_height + 1), 0.0)
+			{
+				const std::size_t stride = (static_cast<std::size_t>(m_width) + 1);
+
+				for (int y = 0; y < m_height; ++y)
+				{
+					const PixelType* const src = image[y];
+					double* const values = (m_values.data() + static_cast<std::size_t>(y) * m_width);
+					const double* const sumsAbove = (m_sums.data() + y * stride);
+					const double* const squaredSumsAbove = (m_squaredSums.data() + y * stride);
+					double* const sums = (m_sums.data() + (y + 1) * stride);
+					double* const squaredSums = (m_squaredSums.data() + (y + 1) * stride);
+
+					// 行内の累積和に、1 つ上の行の値を足す
+					double rowSum = 0.0;
+					double rowSquaredSum = 0.0;
+
+					for (int x = 0; x < m_width; ++x)
+					{
+						const double v = PixelCast<Color>(src[x]).grayscale();
+						values[x] = v;
+						rowSum += v;
+						rowSquaredSum += (v * v);
+						sums[x + 1] = (sumsAbove[x + 1] + rowSum);
+						squaredSums[x + 1] = (squaredSumsAbove[x + 1] + rowSquaredSum);
+					}
+				}
+			}
+
+			/// @brief 行のグレースケール値の配列を返します。
+			[[nodiscard]]
+			const double* row(const int y) const noexcept
+			{
+				return (m_values.data() + static_cast<std::size_t>(y) * m_width);
+			}
+
+			/// @brief 長方形の範囲のグレースケール値の平均を返します（範囲外の部分は無視します）。
+			[[nodiscard]]
+			double mean(const Rect& rect) const noexcept
+			{
+				const Rect r = rect.intersection(Rect{ 0, 0, m_width, m_height });
+				return (r.isEmpty() ? 0.0 : (sumOf(m_sums, r) / static_cast<double>(r.area())));
+			}
+
+			/// @brief 長方形の範囲のグレースケール値の分散を返します（範囲外の部分は無視します）。
+			[[nodiscard]]
+			double variance(const Rect& rect) const noexcept
+			{
+				const Rect r = rect.intersection(Rect{ 0, 0, m_width, m_height });
+
+				if (r.isEmpty())
+				{
+					return 0.0;
+				}
+
+				// 分散 = 二乗の平均 - 平均の二乗（丸め誤差で負にならないようにする）
+				const double n = static_cast<double>(r.area());
+				const double m = (sumOf(m_sums, r) / n);
+				return std::max(((sumOf(m_squaredSums, r) / n) - m * m), 0.0);
+			}
+
+		private:
+
+			/// @brief 画像の幅（ピクセル）
+			int m_width = 0;
+
+			/// @brief 画像の高さ（ピクセル）
+			int m_height = 0;
+
+			/// @brief グレースケール値（width * height 要素）
+			std::vector<double> m_values;
+
+			/// @brief 合計（(width + 1) * (height + 1) 要素。先頭の行と列は 0）
+			std::vector<double> m_sums;
+
+			/// @brief 二乗の合計（(width + 1) * (height + 1) 要素。先頭の行と列は 0）
+			std::vector<double> m_squaredSums;
+
+			/// @brief テーブルから、長方形の範囲の合計を求めます（範囲は画像の範囲内であること）。
+			[[nodiscard]]
+			double sumOf(const std::vector<double>& table, const Rect& rect) const noexcept
+			{
+				const std::size_t stride = (static_cast<std::size_t>(m_width) + 1);
+				const std::size_t top = (rect.y * stride);
+				const std::size_t bottom = (rect.bottom() * stride);
+				return ((table[bottom + rect.right()] - table[top + rect.right()]) - (table[bottom + rect.x] - table[top + rect.x]));
+			}
+		};
+
+		/// @brief グレースケール値と位置ごとのしきい値を比べて、画像を白と黒に二値化します。
+		/// @param radius 窓の半径（負の場合は 0 として扱う）
+		/// @param threshold 積分画像と窓の範囲から、しきい値を求める関数
+		template <class PixelType, class Threshold>
+		[[nodiscard]]
+		BasicImage<PixelType> ThresholdByWindow(const BasicImage<PixelType>& image, const int radius, Threshold&& threshold)
+		{
+			if (image.isEmpty())
+			{
+				return{};
+			}
+
+			// 窓の位置と大きさで同じ半径を使うよう、最初に 0 以上にそろえる
+			const int windowRadius = std::max(radius, 0);
+			const GrayscaleIntegral integral{ image };
+			const PixelType white = PixelCast<PixelType>(Color{ 1.0 });
+			const int size = (2 * windowRadius + 1);
+			BasicImage<PixelType> result{ image.width(), image.height(), Uninitialized, image.layout() };
+
+			ParallelForBands(image.height(), ParallelOptions{}, [&](const int y0, const int y1)
+			{
+				for (int y = y0; y < y1; ++y)
+				{
+					const double* const src = integral.row(y);
+					PixelType* const dst = result[y];
+
+					for (int x = 0; x < image.width(); ++x)
+					{
+						const Rect window{ (x - windowRadius), (y - windowRadius), size, size };
+						dst[x] = ((threshold(integral, window) < src[x]) ? white : PixelType{});
+					}
+				}
+			});
+
+			return result;
+		}
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> GaussianBlur(const BasicImage<PixelType>& image, const double sigma, const BorderMode borderMode)
+	{
+		if (image.isEmpty() || (sigma <= 0.0))
+		{
+			return image;
+		}
+
+		const auto kernel = GaussianKernel<AccumulatorType<PixelType>>(sigma);
+		BasicImage<PixelType> result{ image.width(), image.height(), Uninitialized, image.layout() };
+
+		ParallelForBands(image.height(), ParallelOptions{}, [&](const int y0, const int y1)
+		{
+			SeparableFilterBand(image, result, y0, y1, kernel, kernel, borderMode);
+		});
+
+		return result;
+	}
+
+	template Image GaussianBlur<Color>(const Image&, double, BorderMode);
+	template ImageF GaussianBlur<ColorF>(const ImageF&, double, BorderMode);
+	template Image8 GaussianBlur<Color8>(const Image8&, double, BorderMode);
+
+	template <class PixelType>
+	BasicImage<PixelType> BoxBlur(const BasicImage<PixelType>& image, const int radius)
+	{
+		if (image.isEmpty() || (radius <= 0))
+		{
+			return image;
+		}
+
+		const IntegralImage integral{ image };
+		const int size = (2 * radius + 1);
+		BasicImage<PixelType> result{ image.width(), image.height(), Uninitialized, image.layout() };
+
+		ParallelForBands(image.height(), ParallelOptions{}, [&](const int y0, const int y1)
+		{
+			for (int y = y0; y < y1; ++y)
+			{
+				PixelType* const dst = result[y];
+
+				for (int x = 0; x < image.width(); ++x)
+				{
+					dst[x] = PixelCast<PixelType>(integral.mean(Rect{ (x - radius), (y - radius), size, size }));
+				}
+			}
+		});
+
+		return result;
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> AdaptiveThreshold(const BasicImage<PixelType>& image, const int radius, const double offset)
+	{
+		return ThresholdByWindow(image, radius, [=](const GrayscaleIntegral& integral, const Rect& window)
+		{
+			return (integral.mean(window) - offset);
+		});
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> SauvolaThreshold(const BasicImage<PixelType>& image, const int radius, const double k)
+	{
+		// 標準偏差の取りうる範囲（値が 0.0 ～ 1.0 の場合の最大値）
+		constexpr double DynamicRange = 0.5;
+
+		return ThresholdByWindow(image, radius, [=](const GrayscaleIntegral& integral, const Rect& window)
+		{
+			const double mean = integral.mean(window);
+			const double deviation = std::sqrt(integral.variance(window));
+			return (mean * (1.0 + k * (deviation / DynamicRange - 1.0)));
+		});
+	}
+
+	template Image BoxBlur<Color>(const Image&, int);
+	template ImageF BoxBlur<ColorF>(const ImageF&, int);
+	template Image8 BoxBlur<Color8>(const Image8&, int);
+
+	template Image AdaptiveThreshold<Color>(const Image&, int, double);
+	template ImageF AdaptiveThreshold<ColorF>(const ImageF&, int, double);
+	template Image8 AdaptiveThreshold<Color8>(const Image8&, int, double);
+
+	template Image SauvolaThreshold<Color>(const Image&, int, double);
+	template ImageF SauvolaThreshold<ColorF>(const ImageF&, int, double);
+	template Image8 SauvolaThreshold<Color8>(const Image8&, int, double);
+
+	template <class PixelType>
+	BasicImage<PixelType> Convolve(const BasicImage<PixelType>& image, const Kernel& kernel, const BorderMode borderMode, ConvolutionMethod method)
+	{
+		if (image.isEmpty() || kernel.isEmpty())
+		{
+			return image;
+		}
+
+		BasicImage<PixelType> result{ image.width(), image.height(), Uninitialized, image.layout() };
+
+		// ランク 1 の行列は、1 次元の畳み込み 2 回に分ける
+		if ((method == ConvolutionMethod::Auto) || (method == ConvolutionMethod::Separable))
+		{
+			std::vector<double> column, row;
+
+			if (kernel.separate(column, row))
+			{
+				using Type = AccumulatorType<PixelType>;
+				const std::vector<Type> columnKernel(column.begin(), column.end());
+				const std::vector<Type> rowKernel(row.begin(), row.end());
+
+				ParallelForBands(image.height(), ParallelOptions{}, [&](const int y0, const int y1)
+				{
+					SeparableFilterBand(image, result, y0, y1, rowKernel, columnKernel, borderMode);
+				});
+
+				return result;
+			}
+
+			method = (((kernel.width() * kernel.height()) <= MaxDirectTaps) ? ConvolutionMethod::Direct : ConvolutionMethod::FFT);
+		}
+
+		if (method == ConvolutionMethod::FFT)
+		{
+			ConvolveFFT(image, result, kernel, borderMode);
+		}
+		else if ((kernel.width() == 3) && (kernel.height() == 3))
+		{
+			ConvolveDirect<3, 3>(image, result, kernel, borderMode);
+		}
+		else if ((kernel.width() == 5) && (kernel.height() == 5))
+		{
+			ConvolveDirect<5, 5>(image, result, kernel, borderMode);
+		}
+		else
+		{
+			ConvolveDirect<0, 0>(image, result, kernel, borderMode);
+		}
+
+		return result;
+	}
+
+	template Image Convolve<Color>(const Image&, const Kernel&, BorderMode, ConvolutionMethod);
+	template ImageF Convolve<ColorF>(const ImageF&, const Kernel&, BorderMode, ConvolutionMethod);
+	template Image8 Convolve<Color8>(const Image8&, const Kernel&, BorderMode, ConvolutionMethod);
+}
@@ -0,0 +1,96 @@
+﻿#pragma once
+#include "Image.hpp"	// mini::BasicImage
+#include "Kernel.hpp"	// mini::Kernel
+
+namespace mini
+{
+	/// @brief 画像の範囲外のピクセルの扱い方
+	enum class BorderMode
+	{
+		/// @brief 最も近い端のピクセルを繰り返す（aaa|abcd|ddd）
+		Replicate,
+
+		/// @brief 端で折り返す（cba|abcd|dcb）
+		Reflect,
+
+		/// @brief 反対側の端から続ける（bcd|abcd|abc）
+		Wrap,
+
+		/// @brief 黒（0）とみなす
+		Zero,
+	};
+
+	/// @brief 畳み込みの計算方法
+	enum class ConvolutionMethod
+	{
+		/// @brief 重みの行列に応じて自動的に選ぶ
+		/// @remark ランク 1 の行列は `Separable`, 重みの数が 121（11 x 11）以下の行列は `Direct`, それ以外は `FFT` を使います。
+		Auto,
+
+		/// @brief 重みを 1 つずつ掛けて足し合わせる（3 x 3 と 5 x 5 は専用の処理）
+		Direct,
+
+		/// @brief 水平方向と垂直方向の 1 次元の畳み込みに分ける（ランク 1 の行列のみ。それ以外の場合は `Auto` と同じ）
+		Separable,
+
+		/// @brief 高速フーリエ変換を使う（大きな行列向け）
+		FFT,
+	};
+
+	/// @brief ガウスぼかしをかけた画像を返します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @param sigma ガウス関数の標準偏差（ピクセル）。0 以下の場合は元の画像のコピーを返します
+	/// @param borderMode 画像の範囲外のピクセルの扱い方
+	/// @return ぼかした画像
+	/// @remark 水平方向と垂直方向の 1 次元のぼかしに分けて計算します（半径 r に対し、1 ピクセルあたり 2(2r + 1) 回の積和）。
+	/// 画像を行の帯に分けて並列に処理し、各帯の中では、水平方向にぼかした行が L2 キャッシュに収まる幅の列ごとに処理します。
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> GaussianBlur(const BasicImage<PixelType>& image, double sigma, BorderMode borderMode = BorderMode::Replicate);
+
+	/// @brief ボックスぼかし（周囲の正方形の範囲の平均）をかけた画像を返します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @param radius 範囲の半径（範囲は (2 * radius + 1) ピクセル四方）。0 以下の場合は元の画像のコピーを返します
+	/// @return ぼかした画像
+	/// @remark 積分画像を使うため、1 ピクセルあたりの計算量は半径によらず一定です。画像の端では、範囲のうち画像の内側の部分だけの平均になります。
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> BoxBlur(const BasicImage<PixelType>& image, int radius);
+
+	/// @brief 周囲の明るさの平均をしきい値として、画像を白と黒に二値化します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @param radius 周囲の範囲の半径（範囲は (2 * radius + 1) ピクセル四方。負の場合は 0 として扱います）
+	/// @param offset しきい値を平均から下げる量（0.0 ～ 1.0）
+	/// @return グレースケール値が「周囲の平均 - offset」より大きいピクセルを白、それ以外を黒にした画像
+	/// @remark 照明にむらがある画像でも、文字や線を取り出せます。積分画像を使うため、計算量は半径によらず一定です。
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> AdaptiveThreshold(const BasicImage<PixelType>& image, int radius, double offset = 0.0);
+
+	/// @brief 周囲の明るさの平均と標準偏差から求めたしきい値（Sauvola 法）で、画像を白と黒に二値化します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @param radius 周囲の範囲の半径（範囲は (2 * radius + 1) ピクセル四方。負の場合は 0 として扱います）
+	/// @param k 標準偏差の影響の大きさ（一般的には 0.2 ～ 0.5）
+	/// @return グレースケール値が「平均 * (1 + k * (標準偏差 / 0.5 - 1))」より大きいピクセルを白、それ以外を黒にした画像
+	/// @remark コントラストの低い範囲ではしきい値が下がるため、背景のむらを文字と誤りにくくなります。
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> SauvolaThreshold(const BasicImage<PixelType>& image, int radius, double k = 0.2);
+
+	/// @brief 重みの行列で畳み込んだ画像を返します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @param kernel 重みの行列。結果の各ピクセルは、行列の中心（`kernel.anchor()`）をそのピクセルに重ねたときの、重みとピクセルの積の合計です（行列は反転しません）
+	/// @param borderMode 画像の範囲外のピクセルの扱い方
+	/// @param method 計算方法
+	/// @return 畳み込んだ画像。行列が空の場合は元の画像のコピーを返します
+	/// @remark 画像をタイルに分けて並列に処理します。範囲外のピクセルの扱いは、重みごとではなくタイルの読み込み時に 1 回だけ行います。
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> Convolve(const BasicImage<PixelType>& image, const Kernel& kernel,
+		BorderMode borderMode = BorderMode::Replicate, ConvolutionMethod method = ConvolutionMethod::Auto);
+}
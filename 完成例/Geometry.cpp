@@ -0,0 +1,282 @@
+﻿#include <algorithm>	// std::reverse, std::reverse_copy, std::copy_n, std::swap_ranges
+#include <utility>		// std::swap
+#include "Geometry.hpp"
+#include "ThreadPool.hpp"	// mini::GetDefaultThreadPool
+
+namespace mini
+{
+	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+	namespace
+	{
+		/// @brief タイルの一辺のピクセル数（入力と出力のタイルが、合わせて L1 キャッシュ程度に収まる大きさ）
+		template <class PixelType>
+		constexpr int TileSize = ((sizeof(PixelType) <= 4) ? 64 : 32);
+
+		/// @brief 入力の画像をタイルに分け、各タイルの列を出力の行として書き込みます。
+		/// @param src 入力の画像
+		/// @param dst 出力の画像（幅は入力の高さ、高さは入力の幅）
+		/// @param flipX 出力の行の並びを逆にする（入力の x が大きいほど上の行にする）場合 true
+		/// @param flipY 出力の各行の中の並びを逆にする（入力の y が大きいほど左にする）場合 true
+		/// @remark 転置（false, false）, 時計回りに 90°（false, true）, 時計回りに 270°（true, false）を表せます。
+		template <class PixelType>
+		void TransposeTiles(const BasicImage<PixelType>& src, BasicImage<PixelType>& dst, const bool flipX, const bool flipY)
+		{
+			const int width = src.width();
+			const int height = src.height();
+			constexpr int Tile = TileSize<PixelType>;
+
+			GetDefaultThreadPool().parallelFor(Rect{ 0, 0, width, height }, Point{ Tile, Tile }, [&](const Rect& tile)
+			{
+				// 出力の 1 行（入力の 1 列）ずつ、連続した位置に書き込む
+				for (int x = tile.x; x < tile.right(); ++x)
+				{
+					PixelType* const out = dst[flipX ? (width - 1 - x) : x];
+
+					for (int y = tile.y; y < tile.bottom(); ++y)
+					{
+						out[flipY ? (height - 1 - y) : y] = src[y][x];
+					}
+				}
+			});
+		}
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> FlipHorizontal(const BasicImage<PixelType>& image)
+	{
+		BasicImage<PixelType> result{ image.width(), image.height(), Uninitialized, image.layout() };
+
+		ParallelForBands(image.height(), ParallelOptions{}, [&](const int y0, const int y1)
+		{
+			for (int y = y0; y < y1; ++y)
+			{
+				std::reverse_copy(image[y], (image[y] + image.width()), result[y]);
+			}
+		});
+
+		return result;
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> FlipVertical(const BasicImage<PixelType>& image)
+	{
+		BasicImage<PixelType> result{ image.width(), image.height(), Uninitialized, image.layout() };
+
+		ParallelForBands(image.height(), ParallelOptions{}, [&](const int y0, const int y1)
+		{
+			for (int y = y0; y < y1; ++y)
+			{
+				std::copy_n(image[image.height() - 1 - y], image.width(), result[y]);
+			}
+		});
+
+		return result;
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> Rotate90(const BasicImage<PixelType>& image)
+	{
+		BasicImage<PixelType> result{ image.height(), image.width(), Uninitialized, image.layout() };
+		TransposeTiles(image, result, false, true);
+		return result;
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> Rotate180(const BasicImage<PixelType>& image)
+	{
+		BasicImage<PixelType> result{ image.width(), image.height(), Uninitialized, image.layout() };
+
+		ParallelForBands(image.height(), ParallelOptions{}, [&](const int y0, const int y1)
+		{
+			for (int y = y0; y < y1; ++y)
+			{
+				const PixelType* const src = image[image.height() - 1 - y];
+				std::reverse_copy(src, (src + image.width()), result[y]);
+			}
+		});
+
+		return result;
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> Rotate270(const BasicImage<PixelType>& image)
+	{
+		BasicImage<PixelType> result{ image.height(), image.width(), Uninitialized, image.layout() };
+		TransposeTiles(image, result, true, false);
+		return result;
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> Transpose(const BasicImage<PixelType>& image)
+	{
+		BasicImage<PixelType> result{ image.height(), image.width(), Uninitialized, image.layout() };
+		TransposeTiles(image, result, false, false);
+		return result;
+	}
+
+	template <class PixelType>
+	void FlipHorizontalInPlace(BasicImage<PixelType>& image)
+	{
+		ParallelForBands(image.height(), ParallelOptions{}, [&](const int y0, const int y1)
+		{
+			for (int y = y0; y < y1; ++y)
+			{
+				std::reverse(image[y], (image[y] + image.width()));
+			}
+		});
+	}
+
+	template <class PixelType>
+	void FlipVerticalInPlace(BasicImage<PixelType>& image)
+	{
+		// 上半分の各行を、対応する下半分の行と入れ替える
+		ParallelForBands((image.height() / 2), ParallelOptions{}, [&](const int y0, const int y1)
+		{
+			for (int y = y0; y < y1; ++y)
+			{
+				std::swap_ranges(image[y], (image[y] + image.width()), image[image.height() - 1 - y]);
+			}
+		});
+	}
+
+	template <class PixelType>
+	void Rotate180InPlace(BasicImage<PixelType>& image)
+	{
+		const int width = image.width();
+		const int height = image.height();
+
+		// 上半分の各行を、対応する下半分の行と、左右を逆にしながら入れ替える
+		ParallelForBands((height / 2), ParallelOptions{}, [&](const int y0, const int y1)
+		{
+			for (int y = y0; y < y1; ++y)
+			{
+				PixelType* const top = image[y];
+				PixelType* const bottom = image[height - 1 - y];
+
+				for (int x = 0; x < width; ++x)
+				{
+					std::swap(top[x], bottom[width - 1 - x]);
+				}
+			}
+		});
+
+		// 高さが奇数の場合は、中央の行の左右を反転する
+		if (height % 2)
+		{
+			std::reverse(image[height / 2], (image[height / 2] + width));
+		}
+	}
+
+	template <class PixelType>
+	bool Rotate90InPlace(BasicImage<PixelType>& image)
+	{
+		// 時計回りに 90° の回転 = 転置してから左右を反転
+		if (!TransposeInPlace(image))
+		{
+			return false;
+		}
+
+		FlipHorizontalInPlace(image);
+		return true;
+	}
+
+	template <class PixelType>
+	bool Rotate270InPlace(BasicImage<PixelType>& image)
+	{
+		// 時計回りに 270° の回転 = 転置してから上下を反転
+		if (!TransposeInPlace(image))
+		{
+			return false;
+		}
+
+		FlipVerticalInPlace(image);
+		return true;
+	}
+
+	template <class PixelType>
+	bool TransposeInPlace(BasicImage<PixelType>& image)
+	{
+		if (image.width() != image.height())
+		{
+			return false;
+		}
+
+		const int size = image.width();
+		constexpr int Tile = TileSize<PixelType>;
+
+		GetDefaultThreadPool().parallelFor(Rect{ 0, 0, size, size }, Point{ Tile, Tile }, [&](const Rect& tile)
+		{
+			// 対角線より右上のタイルは、左下の対応するタイルと入れ替える。対角線上のタイルは、タイルの中で入れ替える
+			if (tile.y < tile.x)
+			{
+				for (int y = tile.y; y < tile.bottom(); ++y)
+				{
+					for (int x = tile.x; x < tile.right(); ++x)
+					{
+						std::swap(image[y][x], image[x][y]);
+					}
+				}
+			}
+			else if (tile.y == tile.x)
+			{
+				for (int y = tile.y; y < tile.bottom(); ++y)
+				{
+					for (int x = (y + 1); x < tile.right(); ++x)
+					{
+						std::swap(image[y][x], image[x][y]);
+					}
+				}
+			}
+		});
+
+		return true;
+	}
+
+	template Image FlipHorizontal<Color>(const Image&);
+	template ImageF FlipHorizontal<ColorF>(const ImageF&);
+	template Image8 FlipHorizontal<Color8>(const Image8&);
+
+	template Image FlipVertical<Color>(const Image&);
+	template ImageF FlipVertical<ColorF>(const ImageF&);
+	template Image8 FlipVertical<Color8>(const Image8&);
+
+	template Image Rotate90<Color>(const Image&);
+	template ImageF Rotate90<ColorF>(const ImageF&);
+	template Image8 Rotate90<Color8>(const Image8&);
+
+	template Image Rotate180<Color>(const Image&);
+	template ImageF Rotate180<ColorF>(const ImageF&);
+	template Image8 Rotate180<Color8>(const Image8&);
+
+	template Image Rotate270<Color>(const Image&);
+	template ImageF Rotate270<ColorF>(const ImageF&);
+	template Image8 Rotate270<Color8>(const Image8&);
+
+	template Image Transpose<Color>(const Image&);
+	template ImageF Transpose<ColorF>(const ImageF&);
+	template Image8 Transpose<Color8>(const Image8&);
+
+	template void FlipHorizontalInPlace<Color>(Image&);
+	template void FlipHorizontalInPlace<ColorF>(ImageF&);
+	template void FlipHorizontalInPlace<Color8>(Image8&);
+
+	template void FlipVerticalInPlace<Color>(Image&);
+	template void FlipVerticalInPlace<ColorF>(ImageF&);
+	template void FlipVerticalInPlace<Color8>(Image8&);
+
+	template void Rotate180InPlace<Color>(Image&);
+	template void Rotate180InPlace<ColorF>(ImageF&);
+	template void Rotate180InPlace<Color8>(Image8&);
+
+	template bool Rotate90InPlace<Color>(Image&);
+	template bool Rotate90InPlace<ColorF>(ImageF&);
+	template bool Rotate90InPlace<Color8>(Image8&);
+
+	template bool Rotate270InPlace<Color>(Image&);
+	template bool Rotate270InPlace<ColorF>(ImageF&);
+	template bool Rotate270InPlace<Color8>(Image8&);
+
+	template bool TransposeInPlace<Color>(Image&);
+	template bool TransposeInPlace<ColorF>(ImageF&);
+	template bool TransposeInPlace<Color8>(Image8&);
+}
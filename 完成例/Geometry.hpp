@@ -0,0 +1,98 @@
+﻿#pragma once
+#include "Image.hpp"	// mini::BasicImage
+
+namespace mini
+{
+	/// @brief 左右を反転した画像を返します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @return 左右を反転した画像
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> FlipHorizontal(const BasicImage<PixelType>& image);
+
+	/// @brief 上下を反転した画像を返します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @return 上下を反転した画像
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> FlipVertical(const BasicImage<PixelType>& image);
+
+	/// @brief 時計回りに 90° 回転した画像を返します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @return 回転した画像（幅と高さが入れ替わります）
+	/// @remark 読み込みと書き込みの両方がキャッシュに収まるよう、タイルごとに処理します。
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> Rotate90(const BasicImage<PixelType>& image);
+
+	/// @brief 180° 回転した画像を返します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @return 回転した画像
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> Rotate180(const BasicImage<PixelType>& image);
+
+	/// @brief 時計回りに 270°（反時計回りに 90°）回転した画像を返します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @return 回転した画像（幅と高さが入れ替わります）
+	/// @remark 読み込みと書き込みの両方がキャッシュに収まるよう、タイルごとに処理します。
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> Rotate270(const BasicImage<PixelType>& image);
+
+	/// @brief 転置した（左上と右下を結ぶ対角線で反転した）画像を返します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @return 転置した画像（幅と高さが入れ替わります）
+	/// @remark 読み込みと書き込みの両方がキャッシュに収まるよう、タイルごとに処理します。
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> Transpose(const BasicImage<PixelType>& image);
+
+	/// @brief 画像の左右をその場で反転します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 反転する画像
+	template <class PixelType>
+	void FlipHorizontalInPlace(BasicImage<PixelType>& image);
+
+	/// @brief 画像の上下をその場で反転します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 反転する画像
+	template <class PixelType>
+	void FlipVerticalInPlace(BasicImage<PixelType>& image);
+
+	/// @brief 画像をその場で 180° 回転します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 回転する画像
+	template <class PixelType>
+	void Rotate180InPlace(BasicImage<PixelType>& image);
+
+	/// @brief 正方形の画像を、その場で時計回りに 90° 回転します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 回転する画像
+	/// @return 回転した場合 true, 正方形でないため回転できなかった場合は false
+	/// @remark 正方形でない画像は `Rotate90()` を使ってください。
+	template <class PixelType>
+	bool Rotate90InPlace(BasicImage<PixelType>& image);
+
+	/// @brief 正方形の画像を、その場で時計回りに 270° 回転します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 回転する画像
+	/// @return 回転した場合 true, 正方形でないため回転できなかった場合は false
+	/// @remark 正方形でない画像は `Rotate270()` を使ってください。
+	template <class PixelType>
+	bool Rotate270InPlace(BasicImage<PixelType>& image);
+
+	/// @brief 正方形の画像を、その場で転置します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 転置する画像
+	/// @return 転置した場合 true, 正方形でないため転置できなかった場合は false
+	/// @remark 対角線の反対側にある 2 つのタイルを入れ替えながら処理します。正方形でない画像は `Transpose()` を使ってください。
+	template <class PixelType>
+	bool TransposeInPlace(BasicImage<PixelType>& image);
+}
@@ -0,0 +1,419 @@
+﻿#include <algorithm>	// std::min, std::max, std::clamp, std::fill
+#include <array>		// std::array
+#include <cmath>		// std::ceil, std::sqrt
+#include <cstddef>		// std::size_t
+#include <type_traits>	// std::is_same_v
+#include <utility>		// std::move
+#include "Histogram.hpp"
+#include "AlignedAllocator.hpp"	// mini::AlignedAllocator, mini::CacheLineSize
+#include "Parallel.hpp"	// mini::ParallelForBands, MINI_IVDEP
+#include "ThreadPool.hpp"	// mini::GetDefaultThreadPool
+
+namespace mini
+{
+	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+	namespace
+	{
+		/// @brief 1 つのスレッドに割り当てる最小の行数
+		constexpr int MinRowsPerBand = 16;
+
+		/// @brief `Color`, `ColorF` のヒストグラムの平坦化に使うビンの数
+		constexpr int EqualizeBins = 4096;
+
+		/// @brief 1 つのスレッドが使う、ビンの組の数
+		/// @remark 同じ値が続くと、同じビンへの加算が前の加算の完了を待つことになるため、偶数番目と奇数番目のピクセルを別の組に数えます。
+		constexpr int NumCopies = 2;
+
+		/// @brief 値をビンの番号に変換します。
+		/// @param value 値（0.0 ～ 1.0。範囲外の値と NaN は、最初または最後のビンにする）
+		template <class Type>
+		[[nodiscard]]
+		int BinIndex(const Type value, const int numBins) noexcept
+		{
+			const Type scaled = (value * static_cast<Type>(numBins));
+			const Type maxBin = static_cast<Type>(numBins - 1);
+			return static_cast<int>((0 < scaled) ? ((scaled < maxBin) ? scaled : maxBin) : 0);
+		}
+
+		/// @brief 画像の一部の行と列を数えて、ビンの配列を作成します。
+		/// @param numBins ビンの数
+		/// @param step 数える行と列の間隔（1 の場合はすべてのピクセル）
+		/// @param counts 結果の格納先（3 * numBins 要素）
+		/// @return 数えたピクセルの数
+		/// @remark 行の帯ごとにスレッドを割り当て、各スレッドは自分専用のビンに数えます。
+		/// 各スレッドのビンはキャッシュラインの境界から始まり、キャッシュラインの倍数の大きさにするため、偽共有は起こりません。
+		template <class PixelType>
+		std::uint64_t CountBins(const BasicImage<PixelType>& image, const int numBins, const int step, std::vector<std::uint64_t>& counts)
+		{
+			counts.assign((static_cast<std::size_t>(numBins) * 3), 0);
+
+			if (image.isEmpty())
+			{
+				return 0;
+			}
+
+			// 各行の、最初に数える列（step 以下の位置を、行ごとに散らばらせる）
+			const auto firstColumn = [=](const int y) { return static_cast<int>((static_cast<std::uint32_t>(y / step) * 2654435761u) % static_cast<std::uint32_t>(step)); };
+
+			// Color8 の場合は、値からビンの番号への変換表を作っておく
+			std::array<int, 256> binTable{};
+
+			if constexpr (std::is_same_v<PixelType, Color8>)
+			{
+				for (int i = 0; i < 256; ++i)
+				{
+					binTable[i] = (i * numBins / 256);
+				}
+			}
+
+			const int numRows = ((image.height() + step - 1) / step);
+			const int numBands = std::min(GetDefaultThreadPool().concurrency(), ((numRows + MinRowsPerBand - 1) / MinRowsPerBand));
+			constexpr std::size_t CountsPerLine = (CacheLineSize / sizeof(std::uint64_t));
+			const std::size_t slotSize = ((static_cast<std::size_t>(numBins) * 3 * NumCopies + CountsPerLine - 1) / CountsPerLine * CountsPerLine);
+			std::vector<std::uint64_t, AlignedAllocator<std::uint64_t>> slots((slotSize * std::max(numBands, 1)), 0);
+
+			const auto countBand = [&](const int band)
+			{
+				const int r0 = static_cast<int>(static_cast<long long>(numRows) * band / numBands);
+				const int r1 = static_cast<int>(static_cast<long long>(numRows) * (band + 1) / numBands);
+				std::uint64_t* const bins = (slots.data() + slotSize * band);
+
+				for (int r = r0; r < r1; ++r)
+				{
+					const int y = (r * step);
+					const PixelType* const row = image[y];
+					int parity = 0;
+
+					for (int x = firstColumn(y); x < image.width(); x += step)
+					{
+						std::uint64_t* const copy = (bins + static_cast<std::size_t>(parity) * numBins * 3);
+
+						if constexpr (std::is_same_v<PixelType, Color8>)
+						{
+							++copy[binTable[row[x].r]];
+							++copy[numBins + binTable[row[x].g]];
+							++copy[2 * numBins + binTable[row[x].b]];
+						}
+						else
+						{
+							++copy[BinIndex(row[x].r, numBins)];
+							++copy[numBins + BinIndex(row[x].g, numBins)];
+							++copy[2 * numBins + BinIndex(row[x].b, numBins)];
+						}
+
+						parity ^= 1;
+					}
+				}
+			};
+
+			if (numBands <= 1)
+			{
+				countBand(0);
+			}
+			else
+			{
+				GetDefaultThreadPool().parallelFor(0, numBands, [&](const int b0, const int b1)
+				{
+					for (int band = b0; band < b1; ++band)
+					{
+						countBand(band);
+					}
+				});
+			}
+
+			// 各スレッドのビンを合計する
+			const std::size_t numCounts = counts.size();
+
+			for (int band = 0; band < std::max(numBands, 1); ++band)
+			{
+				for (int copy = 0; copy < NumCopies; ++copy)
+				{
+					const std::uint64_t* const bins = (slots.data() + slotSize * band + static_cast<std::size_t>(copy) * numBins * 3);
+
+					MINI_IVDEP
+					for (std::size_t i = 0; i < numCounts; ++i)
+					{
+						counts[i] += bins[i];
+					}
+				}
+			}
+
+			std::uint64_t total = 0;
+
+			for (int i = 0; i < numBins; ++i)
+			{
+				total += counts[i];
+			}
+
+			return total;
+		}
+
+		/// @brief 成分ごとに変換表を引いた `Color8` の画像を返します。
+		[[nodiscard]]
+		Image8 ApplyTables(const Image8& image, const std::array<std::array<std::uint8_t, 256>, 3>& tables)
+		{
+			Image8 result{ image.width(), image.height(), Uninitialized, image.layout() };
+
+			ParallelForBands(image.height(), ParallelOptions{}, [&](const int y0, const int y1)
+			{
+				for (int y = y0; y < y1; ++y)
+				{
+					const Color8* const src = image[y];
+					Color8* const dst = result[y];
+
+					for (int x = 0; x < image.width(); ++x)
+					{
+						dst[x] = Color8{ tables[0][src[x].r], tables[1][src[x].g], tables[2][src[x].b] };
+					}
+				}
+			});
+
+			return result;
+		}
+	}
+
+	template <class PixelType>
+	Histogram::Histogram(const BasicImage<PixelType>& image, const int numBins)
+		: m_numBins{ std::max(numBins, 1) }
+	{
+		m_total = CountBins(image, m_numBins, 1, m_counts);
+	}
+
+	Histogram::Histogram(std::vector<std::uint64_t> counts, const int numBins)
+		: m_counts(std::move(counts))
+		, m_numBins{ std::max(numBins, 1) }
+	{
+		m_counts.resize((static_cast<std::size_t>(m_numBins) * 3), 0);
+
+		for (int i = 0; i < m_numBins; ++i)
+		{
+			m_total += m_counts[i];
+		}
+	}
+
+	double Histogram::quantile(const int channel, const double fraction) const noexcept
+	{
+		if (m_total == 0)
+		{
+			return 0.0;
+		}
+
+		const std::span<const std::uint64_t> bins = counts(channel);
+		const double target = (std::clamp(fraction, 0.0, 1.0) * static_cast<double>(m_total));
+		double cumulative = 0.0;
+		int last = 0;
+
+		for (int i = 0; i < m_numBins; ++i)
+		{
+			if (bins[i] == 0)
+			{
+				continue;
+			}
+
+			const double count = static_cast<double>(bins[i]);
+
+			if (target <= (cumulative + count))
+			{
+				return ((i + (target - cumulative) / count) / m_numBins);
+			}
+
+			cumulative += count;
+			last = i;
+		}
+
+		return (static_cast<double>(last + 1) / m_numBins);
+	}
+
+	template <class PixelType>
+	Histogram SampleHistogram(const BasicImage<PixelType>& image, const int maxSamples, const int numBins)
+	{
+		const double numPixels = (static_cast<double>(image.width()) * image.height());
+		const int step = ((maxSamples <= 0) ? 1 : std::max(static_cast<int>(std::ceil(std::sqrt(numPixels / maxSamples))), 1));
+
+		std::vector<std::uint64_t> counts;
+		CountBins(image, std::max(numBins, 1), step, counts);
+		return Histogram{ std::move(counts), numBins };
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> EqualizeHistogram(const BasicImage<PixelType>& image)
+	{
+		if (image.isEmpty())
+		{
+			return{};
+		}
+
+		if constexpr (std::is_same_v<PixelType, Color8>)
+		{
+			const Histogram histogram{ image, 256 };
+			std::array<std::array<std::uint8_t, 256>, 3> tables;
+
+			for (int c = 0; c < 3; ++c)
+			{
+				const std::span<const std::uint64_t> bins = histogram.counts(c);
+
+				// 最も暗い値が 0, 最も明るい値が 255 になるよう、最初の空でないビンの数を差し引く
+				const std::uint64_t first = *std::find_if(bins.begin(), bins.end(), [](const std::uint64_t n) { return (n != 0); });
+				const std::uint64_t range = (histogram.total() - first);
+				std::uint64_t cumulative = 0;
+
+				for (int i = 0; i < 256; ++i)
+				{
+					cumulative += bins[i];
+					tables[c][i] = ((range == 0) ? static_cast<std::uint8_t>(i)
+						: static_cast<std::uint8_t>(((cumulative - std::min(cumulative, first)) * 255 + range / 2) / range));
+				}
+			}
+
+			return ApplyTables(image, tables);
+		}
+		else
+		{
+			using Type = decltype(PixelType::r);
+			const Histogram histogram{ image, EqualizeBins };
+
+			// 各成分の、ビンの境界での累積分布（EqualizeBins + 1 個）
+			std::vector<Type> tables((EqualizeBins + 1) * 3);
+
+			for (int c = 0; c < 3; ++c)
+			{
+				const std::span<const std::uint64_t> bins = histogram.counts(c);
+				Type* const table = (tables.data() + static_cast<std::size_t>(c) * (EqualizeBins + 1));
+				std::uint64_t cumulative = 0;
+
+				for (int i = 0; i < EqualizeBins; ++i)
+				{
+					table[i] = static_cast<Type>(static_cast<double>(cumulative) / histogram.total());
+					cumulative += bins[i];
+				}
+
+				table[EqualizeBins] = 1;
+			}
+
+			BasicImage<PixelType> result{ image.width(), image.height(), Uninitialized, image.layout() };
+
+			const auto map = [](const Type value, const Type* table)
+			{
+				const Type scaled = (value * EqualizeBins);
+				const Type clamped = ((0 < scaled) ? ((scaled < EqualizeBins) ? scaled : static_cast<Type>(EqualizeBins)) : 0);
+				const int i = std::min(static_cast<int>(clamped), (EqualizeBins - 1));
+				return (table[i] + (clamped - static_cast<Type>(i)) * (table[i + 1] - table[i]));
+			};
+
+			ParallelForBands(image.height(), ParallelOptions{}, [&](const int y0, const int y1)
+			{
+				for (int y = y0; y < y1; ++y)
+				{
+					const PixelType* const src = image[y];
+					PixelType* const dst = result[y];
+
+					for (int x = 0; x < image.width(); ++x)
+					{
+						dst[x] = PixelType{ map(src[x].r, tables.data()),
+							map(src[x].g, (tables.data() + (EqualizeBins + 1))),
+							map(src[x].b, (tables.data() + 2 * (EqualizeBins + 1))) };
+					}
+				}
+			});
+
+			return result;
+		}
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> AutoLevels(const BasicImage<PixelType>& image, double clipFraction)
+	{
+		if (image.isEmpty())
+		{
+			return{};
+		}
+
+		clipFraction = std::clamp(clipFraction, 0.0, 0.5);
+
+		if constexpr (std::is_same_v<PixelType, Color8>)
+		{
+			const Histogram histogram{ image, 256 };
+			const std::uint64_t clipCount = static_cast<std::uint64_t>(clipFraction * static_cast<double>(histogram.total()));
+			std::array<std::array<std::uint8_t, 256>, 3> tables;
+
+			for (int c = 0; c < 3; ++c)
+			{
+				const std::span<const std::uint64_t> bins = histogram.counts(c);
+
+				// 切り捨てる数を超えた最初の値と最後の値
+				int low = 0, high = 255;
+
+				for (std::uint64_t cumulative = 0; (low < 255) && ((cumulative += bins[low]) <= clipCount); ++low) {}
+
+				for (std::uint64_t cumulative = 0; (0 < high) && ((cumulative += bins[high]) <= clipCount); --high) {}
+
+				for (int i = 0; i < 256; ++i)
+				{
+					tables[c][i] = ((high <= low) ? static_cast<std::uint8_t>(i)
+						: static_cast<std::uint8_t>(std::clamp(((i - low) * 255 + (high - low) / 2) / (high - low), 0, 255)));
+				}
+			}
+
+			return ApplyTables(image, tables);
+		}
+		else
+		{
+			using Type = decltype(PixelType::r);
+			const Histogram histogram{ image, EqualizeBins };
+			Type offsets[3], scales[3];
+
+			for (int c = 0; c < 3; ++c)
+			{
+				const double low = histogram.quantile(c, clipFraction);
+				const double high = histogram.quantile(c, (1.0 - clipFraction));
+				offsets[c] = static_cast<Type>((low < high) ? low : 0.0);
+				scales[c] = static_cast<Type>((low < high) ? (1.0 / (high - low)) : 1.0);
+			}
+
+			BasicImage<PixelType> result{ image.width(), image.height(), Uninitialized, image.layout() };
+
+			const int width = image.width();
+
+			const auto map = [](const Type value, const Type offset, const Type scale)
+			{
+				const Type v = ((value - offset) * scale);
+				return ((0 < v) ? ((v < 1) ? v : static_cast<Type>(1)) : static_cast<Type>(0));
+			};
+
+			ParallelForBands(image.height(), ParallelOptions{}, [&](const int y0, const int y1)
+			{
+				for (int y = y0; y < y1; ++y)
+				{
+					const PixelType* const src = image[y];
+					PixelType* const dst = result[y];
+
+					MINI_IVDEP
+					for (int x = 0; x < width; ++x)
+					{
+						dst[x] = PixelType{ map(src[x].r, offsets[0], scales[0]),
+							map(src[x].g, offsets[1], scales[1]),
+							map(src[x].b, offsets[2], scales[2]) };
+					}
+				}
+			});
+
+			return result;
+		}
+	}
+
+	template Histogram::Histogram(const Image&, int);
+	template Histogram::Histogram(const ImageF&, int);
+	template Histogram::Histogram(const Image8&, int);
+
+	template Histogram SampleHistogram<Color>(const Image&, int, int);
+	template Histogram SampleHistogram<ColorF>(const ImageF&, int, int);
+	template Histogram SampleHistogram<Color8>(const Image8&, int, int);
+
+	template Image EqualizeHistogram<Color>(const Image&);
+	template ImageF EqualizeHistogram<ColorF>(const ImageF&);
+	template Image8 EqualizeHistogram<Color8>(const Image8&);
+
+	template Image AutoLevels<Color>(const Image&, double);
+	template ImageF AutoLevels<ColorF>(const ImageF&, double);
+	template Image8 AutoLevels<Color8>(const Image8&, double);
+}
@@ -0,0 +1,144 @@
+﻿#pragma once
+#include <cstdint>		// std::uint64_t
+#include <span>			// std::span
+#include <vector>		// std::vector
+#include "Image.hpp"	// mini::BasicImage
+
+namespace mini
+{
+	/// @brief 成分ごとのヒストグラム
+	/// @remark 各成分の値 0.0 ～ 1.0 を等しい幅のビンに分け、それぞれのビンに入るピクセルの数を数えます。
+	/// 範囲外の値は、最初または最後のビンに数えます。成分は 0: 赤, 1: 緑, 2: 青 の順です。
+	class Histogram
+	{
+	public:
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		Histogram() = default;
+
+		/// @brief 画像のすべてのピクセルから、ヒストグラムを作成します。
+		/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+		/// @param image 元の画像
+		/// @param numBins ビンの数（1 以上）
+		/// @remark 画像を行の帯に分けて並列に数えます。各スレッドはキャッシュラインの境界に揃えた自分専用のビンに数え、最後にまとめて合計します。
+		template <class PixelType>
+		[[nodiscard]]
+		explicit Histogram(const BasicImage<PixelType>& image, int numBins = 256);
+
+		/// @brief 数え上げの結果から、ヒストグラムを作成します。
+		/// @param counts 成分ごとに numBins 個ずつ、赤、緑、青の順に並べたビンの配列（3 * numBins 要素）
+		/// @param numBins ビンの数（1 以上）
+		/// @remark 数えたピクセルの数は、赤成分のビンの合計とします。
+		[[nodiscard]]
+		Histogram(std::vector<std::uint64_t> counts, int numBins);
+
+		/// @brief ビンの数を返します。
+		/// @return ビンの数
+		[[nodiscard]]
+		int numBins() const noexcept
+		{
+			return m_numBins;
+		}
+
+		/// @brief 数えたピクセルの数を返します。
+		/// @return 数えたピクセルの数
+		[[nodiscard]]
+		std::uint64_t total() const noexcept
+		{
+			return m_total;
+		}
+
+		/// @brief ヒストグラムが空であるかを返します。
+		/// @return 1 つもピクセルを数えていない場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isEmpty() const noexcept
+		{
+			return (m_total == 0);
+		}
+
+		/// @brief 成分のビンの配列を返します。
+		/// @param channel 成分（0: 赤, 1: 緑, 2: 青）
+		/// @return ビンの配列
+		[[nodiscard]]
+		std::span<const std::uint64_t> counts(int channel) const noexcept
+		{
+			return{ (m_counts.data() + static_cast<std::size_t>(channel) * m_numBins), static_cast<std::size_t>(m_numBins) };
+		}
+
+		/// @brief 赤成分のビンの配列を返します。
+		/// @return ビンの配列
+		[[nodiscard]]
+		std::span<const std::uint64_t> red() const noexcept
+		{
+			return counts(0);
+		}
+
+		/// @brief 緑成分のビンの配列を返します。
+		/// @return ビンの配列
+		[[nodiscard]]
+		std::span<const std::uint64_t> green() const noexcept
+		{
+			return counts(1);
+		}
+
+		/// @brief 青成分のビンの配列を返します。
+		/// @return ビンの配列
+		[[nodiscard]]
+		std::span<const std::uint64_t> blue() const noexcept
+		{
+			return counts(2);
+		}
+
+		/// @brief 成分の値のうち、小さいほうから指定した割合の位置にある値を返します。
+		/// @param channel 成分（0: 赤, 1: 緑, 2: 青）
+		/// @param fraction 割合（0.0 ～ 1.0）
+		/// @return 値（0.0 ～ 1.0）。ビンの中では値が均等に分布しているとみなして補間します。ヒストグラムが空の場合は 0.0
+		[[nodiscard]]
+		double quantile(int channel, double fraction) const noexcept;
+
+	private:
+
+		/// @brief ビンの数え上げの結果（成分ごとに numBins 個ずつ、赤、緑、青の順）
+		std::vector<std::uint64_t> m_counts;
+
+		/// @brief ビンの数
+		int m_numBins = 0;
+
+		/// @brief 数えたピクセルの数
+		std::uint64_t m_total = 0;
+	};
+
+	/// @brief 画像の一部のピクセルだけから、近似的なヒストグラムを作成します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @param maxSamples 数えるピクセルの数の目安
+	/// @param numBins ビンの数（1 以上）
+	/// @return 近似的なヒストグラム。ピクセル数が `maxSamples` 以下の場合は、すべてのピクセルを数えます
+	/// @remark プレビュー向けです。画像を縦横同じ間隔の格子に分け、各マスから 1 ピクセルずつ選びます。
+	/// 規則的な模様との干渉を避けるため、選ぶ位置は行ごとにずらします。
+	template <class PixelType>
+	[[nodiscard]]
+	Histogram SampleHistogram(const BasicImage<PixelType>& image, int maxSamples, int numBins = 256);
+
+	/// @brief ヒストグラムを平坦化した画像を返します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @return 成分ごとに、値をその累積分布（0.0 ～ 1.0）に置き換えた画像
+	/// @remark 変換は、ヒストグラムから作った変換表を引いて行います。`Color8` の場合は 256 個のビンの変換表を使い、
+	/// `Color`, `ColorF` の場合は 4096 個のビンの境界の累積分布を、ビンの中で線形に補間します。
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> EqualizeHistogram(const BasicImage<PixelType>& image);
+
+	/// @brief 成分ごとに、値の範囲を 0.0 ～ 1.0 に引き伸ばした画像を返します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @param clipFraction 両端で切り捨てる（0.0 または 1.0 にする）ピクセルの割合
+	/// @return 変換した画像
+	/// @remark 成分ごとに、ヒストグラムの `clipFraction` と `1 - clipFraction` の位置の値を 0.0 と 1.0 に移します。
+	/// `Color8` の場合は変換表を引き、`Color`, `ColorF` の場合は 1 次式をそのまま計算します。
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> AutoLevels(const BasicImage<PixelType>& image, double clipFraction = 0.005);
+}
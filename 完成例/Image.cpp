@@ -1,33 +1,133 @@
 ﻿#include <vector>				// std::vector
 #include <string_view>			// std::string_view
-#include <algorithm>			// std::clamp
+#include <algorithm>			// std::min, std::max, std::clamp
+#include <atomic>				// std::atomic
 #include <cmath>				// std::abs
-#include <cstdint>				// std::uint8_t
-#include "Image.hpp"			// mini::Image
+#include <cstdint>				// std::int64_t, std::uint64_t, INT32_MIN
+#include <cstring>				// std::memcpy
+#include <cstddef>				// std::byte
+#include <span>					// std::span, std::as_bytes
+#include <type_traits>			// std::is_same_v
+#include "Image.hpp"			// mini::BasicImage
 #include "BMPHeader.hpp"		// mini::BMPHeader
-#include "BinaryFileWriter.hpp"	// mini::BinaryFileWriter
+#include "PixelCodec.hpp"		// mini::DecodeBGR24Row, mini::EncodeBGR24Row, mini::DecodeBGRA32Row, mini::EncodeBGRA32Row
+#include "BinaryFileWriter.hpp"	// mini::BinaryFileWriter, mini::WriteMode
 #include "BinaryFileReader.hpp" // mini::BinaryFileReader
+#include "MappedFileReader.hpp" // mini::MappedFileReader
+#include "Parallel.hpp"			// mini::ParallelOptions, mini::ParallelForBands
 
 namespace mini
 {
-	Image::Image(std::string_view fileName)
+	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+	namespace
 	{
-		*this = LoadBMP(fileName);
+		/// @brief 1 行分のデータのサイズ（バイト）を返します。
+		/// @param width 画像の幅（ピクセル）
+		/// @param bitCount 1 ピクセルあたりのビット数（24 または 32）
+		/// @return 1 行分のデータのサイズ（バイト）
+		[[nodiscard]]
+		constexpr std::size_t GetRowSize(const int width, const int bitCount = 24) noexcept
+		{
+			return ((static_cast<std::size_t>(width) * (bitCount / 8) + 3) / 4) * 4; // 4 バイト境界に合わせる
+		}
+
+		/// @brief 保存時の 1 ピクセルあたりのビット数。不透明度付きの画像は 32 ビット、それ以外は 24 ビットで保存する
+		template <class PixelType>
+		constexpr std::uint16_t BitCountOf = (std::is_same_v<PixelType, ColorA8> ? 32 : 24);
+
+		/// @brief ファイルの 1 行分のデータを、1 ピクセルあたりのビット数に応じて色の配列に変換します。
+		template <class PixelType>
+		void DecodeRow(const std::span<const std::byte> src, const std::span<PixelType> dst, const int bitCount) noexcept
+		{
+			if (bitCount == 32)
+			{
+				DecodeBGRA32Row(src, dst);
+			}
+			else
+			{
+				DecodeBGR24Row(src, dst);
+			}
+		}
+
+		/// @brief 色の配列を、保存時の形式の 1 行分のデータに変換します。
+		template <class PixelType>
+		void EncodeRow(const std::span<const PixelType> src, const std::span<std::byte> dst) noexcept
+		{
+			if constexpr (std::is_same_v<PixelType, ColorA8>)
+			{
+				EncodeBGRA32Row(src, dst);
+			}
+			else
+			{
+				EncodeBGR24Row(src, dst);
+			}
+		}
+
+		/// @brief BMP ファイルのヘッダーが、読み込みに対応している形式であるかを返します。
+		/// @param header BMP ファイルのヘッダー
+		/// @param fileSize ファイルのサイズ（バイト）
+		/// @return 対応している形式で、画素データがファイルに収まっている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool IsSupportedBMP(const BMPHeader& header, const std::uint64_t fileSize) noexcept
+		{
+			// BMP 形式でない場合、または 24 ビットカラーでない場合は失敗（これ以外にもチェックを強化できる）
+			if ((header.bfType != 0x4D42) || ((header.biBitCount != 24) && (header.biBitCount != 32)))
+			{
+				return false;
+			}
+
+			// 32 ビットカラーは、圧縮なし（BI_RGB）の BGRA の並びのみに対応する
+			if ((header.biBitCount == 32) && (header.biCompression != 0))
+			{
+				return false;
+			}
+
+			// サイズが不正な場合は失敗
+			if ((header.biWidth <= 0) || (header.biHeight == 0) || (header.biHeight == INT32_MIN))
+			{
+				return false;
+			}
+
+			// 画素データがファイルに収まっていない場合は失敗
+			const std::uint64_t rowSize = GetRowSize(header.biWidth, header.biBitCount);
+			const std::uint64_t height = std::abs(header.biHeight);
+			return ((header.bfOffBits <= fileSize) && (height <= ((fileSize - header.bfOffBits) / rowSize)));
+		}
+
+		/// @brief 複数のデータをまとめてファイルに書き込みます。
+		/// @param writer 書き込み先
+		/// @param parts 書き込むデータの配列
+		/// @return すべて書き込めた場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool WriteAll(BinaryFileWriter& writer, const std::span<const std::span<const std::byte>> parts)
+		{
+			std::int64_t size = 0;
+
+			for (const auto& part : parts)
+			{
+				size += part.size();
+			}
+
+			return (writer.write(parts) == size);
+		}
 	}
 
-	bool Image::save(std::string_view fileName) const
+	template <class PixelType>
+	bool SaveBMP(const BasicImage<PixelType>& image, std::string_view fileName)
 	{
-		return SaveBMP(*this, fileName);
+		return SaveBMP(image.view(), fileName);
 	}
 
-	bool SaveBMP(const Image& image, std::string_view fileName)
+	template <class PixelType>
+	bool SaveBMP(const BasicImageView<const PixelType>& image, std::string_view fileName)
 	{
 		const int width = image.width();
 		const int height = image.height();
-		const int rowSize = ((width * 3 + 3) / 4) * 4; // 4 バイト境界に合わせる
-		const BMPHeader header = BMPHeader::Make(width, height);
+		const std::size_t rowSize = GetRowSize(width, BitCountOf<PixelType>);
+		const BMPHeader header = BMPHeader::Make(width, height, BitCountOf<PixelType>);
 
-		BinaryFileWriter writer{ fileName };
+		// 一時ファイルに書き出し、すべて書き込めた場合のみ置き換える
+		BinaryFileWriter writer{ fileName, WriteMode::Atomic };
 
 		// ファイルがオープンされていない場合は失敗
 		if (!writer)
@@ -35,39 +135,68 @@ namespace mini
 			return false;
 		}
 
-		// ヘッダーを書き込む
-		writer.write(header);
+		// 最終的なサイズはわかっているので、領域をあらかじめ確保する
+		writer.preallocate(BMPHeader::FileSize(width, height, BitCountOf<PixelType>));
 
-		// 1 行分のデータを格納するバッファ
-		std::vector<std::uint8_t> rowData(rowSize, 0);
+		// ヘッダーは最初の行データと一緒に書き込む
+		std::vector<std::span<const std::byte>> parts{ std::as_bytes(std::span{ &header, 1 }) };
 
-		for (int y = 0; y < height; ++y)
+		// 行の末尾のパディング（parts から参照するため、書き込みが終わるまで有効でなければならない）
+		const std::byte padding[3] = {};
+
+		if constexpr (std::is_same_v<PixelType, Color8> || std::is_same_v<PixelType, ColorA8>)
 		{
-			// BMP は下の行から格納するので、y は height - 1 - y でアクセスする
-			for (int x = 0; x < width; ++x)
+			// 8 ビットの画像はファイルと同じ並びなので、変換せずに各行とパディングを 1 回でまとめて書き込む
+			const std::span<const std::byte> paddingBytes = std::span{ padding }.first(rowSize - width * sizeof(PixelType));
+			parts.reserve(1 + (height * 2));
+
+			for (int y = 0; y < height; ++y)
 			{
-				const Color color = image[height - 1 - y][x];
+				// BMP は下の行から格納するので、y は height - 1 - y でアクセスする
+				parts.push_back(std::as_bytes(image.row(height - 1 - y)));
+				parts.push_back(paddingBytes);
+			}
+		}
+		else
+		{
+			// 一度に書き込む行数（バッファが大きくなりすぎないよう 1 MiB 程度に抑える）
+			const int chunkRows = static_cast<int>(std::clamp<std::size_t>(((1 << 20) / std::max<std::size_t>(rowSize, 1)), 1, std::max(height, 1)));
+			std::vector<std::byte> chunk(rowSize * chunkRows);
+
+			for (int c0 = 0; c0 < height; c0 += chunkRows)
+			{
+				const int c1 = std::min((c0 + chunkRows), height);
+
+				for (int y = c0; y < c1; ++y)
+				{
+					// BMP は下の行から格納するので、y は height - 1 - y でアクセスする
+					EncodeRow<PixelType>(image.row(height - 1 - y), std::span{ chunk }.subspan((rowSize * (y - c0)), rowSize));
+				}
 
-				// 各色成分を、保存のため 8 ビット整数（0 ～ 255）に変換する
-				const std::uint8_t r = static_cast<std::uint8_t>(std::clamp((color.r * 255.0 + 0.5), 0.0, 255.0));
-				const std::uint8_t g = static_cast<std::uint8_t>(std::clamp((color.g * 255.0 + 0.5), 0.0, 255.0));
-				const std::uint8_t b = static_cast<std::uint8_t>(std::clamp((color.b * 255.0 + 0.5), 0.0, 255.0));
+				parts.push_back(std::span{ chunk }.first(rowSize * (c1 - c0)));
 
-				rowData[x * 3 + 0] = b; // 青
-				rowData[x * 3 + 1] = g; // 緑
-				rowData[x * 3 + 2] = r; // 赤
+				if (!WriteAll(writer, parts))
+				{
+					return false;
+				}
+
+				parts.clear();
 			}
+		}
 
-			// 1 行分のデータを書き込む
-			writer.write(rowData.data(), rowSize);
+		if (!WriteAll(writer, parts))
+		{
+			return false;
 		}
 
-		return true;
+		return writer.commit();
 	}
 
-	Image LoadBMP(std::string_view fileName)
+	template <class PixelType>
+	BasicImage<PixelType> LoadBMP(std::string_view fileName)
 	{
-		BinaryFileReader reader{ fileName };
+		// ファイルをメモリにマップして、行バッファを介さずに直接デコードする
+		const MappedFileReader reader{ fileName };
 
 		// ファイルがオープンされていない場合は失敗
 		if (!reader)
@@ -75,57 +204,278 @@ namespace mini
 			return{};
 		}
 
-		BMPHeader header;
+		const std::span<const std::byte> file = reader.data();
 
-		// ヘッダーサイズ分のデータを読み込めない場合は失敗
-		if (reader.read(header) != sizeof(BMPHeader))
+		// ヘッダーサイズ分のデータがない場合は失敗
+		if (file.size() < sizeof(BMPHeader))
 		{
 			return{};
 		}
 
-		// BMP 形式でない場合、または 24 ビットカラーでない場合は失敗（これ以外にもチェックを強化できる）
-		if ((header.bfType != 0x4D42) || (header.biBitCount != 24))
+		BMPHeader header;
+		std::memcpy(&header, file.data(), sizeof(BMPHeader));
+
+		// 対応していない形式の場合は失敗
+		if (!IsSupportedBMP(header, file.size()))
 		{
 			return{};
 		}
 
 		const int width = header.biWidth;
 		const int height = std::abs(header.biHeight); // 負の場合は上の行から格納されている
-		const int rowSize = ((width * 3 + 3) / 4) * 4; // 4 バイト境界に合わせる
+		const std::size_t rowSize = GetRowSize(width, header.biBitCount);
+
+		const std::byte* pixels = (file.data() + header.bfOffBits);
 
-		Image image{ width, height };
-		std::vector<std::uint8_t> rowData(rowSize);
+		// すべてのピクセルを上書きするので、初期化しない
+		BasicImage<PixelType> image{ width, height, Uninitialized };
 
 		for (int y = 0; y < height; ++y)
 		{
-			// 1 行分のデータを読み込む
-			if (reader.read(rowData.data(), rowSize) != rowSize)
+			const std::byte* src = (pixels + (y * rowSize));
+
+			// 正の場合は下の行から、負の場合は上の行から格納されている
+			DecodeRow(std::span{ src, rowSize }, image.row((0 < header.biHeight) ? (height - 1 - y) : y), header.biBitCount);
+		}
+
+		return image;
+	}
+
+	template <class PixelType>
+	bool SaveBMP(const BasicImage<PixelType>& image, std::string_view fileName, const ParallelOptions& options)
+	{
+		return SaveBMP(image.view(), fileName, options);
+	}
+
+	template <class PixelType>
+	bool SaveBMP(const BasicImageView<const PixelType>& image, std::string_view fileName, const ParallelOptions& options)
+	{
+		const int width = image.width();
+		const int height = image.height();
+		const std::size_t rowSize = GetRowSize(width, BitCountOf<PixelType>);
+		const BMPHeader header = BMPHeader::Make(width, height, BitCountOf<PixelType>);
+
+		// 一時ファイルに書き出し、すべて書き込めた場合のみ置き換える
+		BinaryFileWriter writer{ fileName, WriteMode::Atomic };
+
+		// ファイルがオープンされていない場合は失敗
+		if (!writer)
+		{
+			return false;
+		}
+
+		// 最終的なサイズはわかっているので、領域をあらかじめ確保する
+		writer.preallocate(BMPHeader::FileSize(width, height, BitCountOf<PixelType>));
+
+		// ヘッダーを書き込む
+		if (writer.writeAt(0, &header, sizeof(BMPHeader)) != sizeof(BMPHeader))
+		{
+			return false;
+		}
+
+		std::atomic<bool> failed{ false };
+
+		// 各帯を別々のスレッドで変換し、位置を指定してファイルの該当箇所に直接書き込む
+		ParallelForBands(height, options, [&](const int y0, const int y1)
+		{
+			// 一度に書き込む行数（バッファが大きくなりすぎないよう 1 MiB 程度に抑える）
+			const int chunkRows = static_cast<int>(std::clamp<std::size_t>(((1 << 20) / std::max<std::size_t>(rowSize, 1)), 1, (y1 - y0)));
+			std::vector<std::byte> chunk(rowSize * chunkRows);
+
+			for (int c0 = y0; c0 < y1; c0 += chunkRows)
 			{
-				return{};
+				const int c1 = std::min((c0 + chunkRows), y1);
+
+				// BMP は下の行から格納するので、ファイル内では c1 - 1 行目が先頭になる
+				for (int y = c0; y < c1; ++y)
+				{
+					EncodeRow<PixelType>(image.row(y), std::span{ chunk }.subspan((rowSize * (c1 - 1 - y)), rowSize));
+				}
+
+				const std::int64_t offset = (header.bfOffBits + (rowSize * (height - c1)));
+				const std::int64_t size = (rowSize * (c1 - c0));
+
+				if (writer.writeAt(offset, chunk.data(), size) != size)
+				{
+					failed = true;
+					return;
+				}
 			}
+		});
+
+		// 失敗した場合は確定せず、一時ファイルを破棄する
+		if (failed)
+		{
+			return false;
+		}
 
-			for (int x = 0; x < width; ++x)
+		return writer.commit();
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> LoadBMP(std::string_view fileName, const ParallelOptions& options)
+	{
+		const BinaryFileReader reader{ fileName };
+
+		// ファイルがオープンされていない場合は失敗
+		if (!reader)
+		{
+			return{};
+		}
+
+		BMPHeader header;
+
+		// ヘッダーを読み込めない場合、または対応していない形式の場合は失敗
+		if ((reader.readAt(0, &header, sizeof(BMPHeader)) != sizeof(BMPHeader))
+			|| (!IsSupportedBMP(header, reader.size())))
+		{
+			return{};
+		}
+
+		const int width = header.biWidth;
+		const int height = std::abs(header.biHeight); // 負の場合は上の行から格納されている
+		const bool topDown = (header.biHeight < 0);
+		const std::size_t rowSize = GetRowSize(width, header.biBitCount);
+
+		// すべてのピクセルを上書きするので、初期化しない
+		BasicImage<PixelType> image{ width, height, Uninitialized };
+		std::atomic<bool> failed{ false };
+
+		// 各帯を別々のスレッドで、位置を指定してファイルの該当箇所から直接読み込んで変換する
+		ParallelForBands(height, options, [&](const int y0, const int y1)
+		{
+			// 一度に読み込む行数（バッファが大きくなりすぎないよう 1 MiB 程度に抑える）
+			const int chunkRows = static_cast<int>(std::clamp<std::size_t>(((1 << 20) / rowSize), 1, (y1 - y0)));
+			std::vector<std::byte> chunk(rowSize * chunkRows);
+
+			for (int c0 = y0; c0 < y1; c0 += chunkRows)
 			{
-				const std::uint8_t b = rowData[x * 3 + 0]; // 青
-				const std::uint8_t g = rowData[x * 3 + 1]; // 緑
-				const std::uint8_t r = rowData[x * 3 + 2]; // 赤
+				const int c1 = std::min((c0 + chunkRows), y1);
 
-				// 各色成分を、0.0 ～ 1.0 の範囲の実数に変換する
-				const Color color{ (r / 255.0), (g / 255.0), (b / 255.0) };
+				// 下の行から格納されている場合は、ファイル内では c1 - 1 行目が先頭になる
+				const int firstFileRow = (topDown ? c0 : (height - c1));
+				const std::int64_t offset = (header.bfOffBits + (rowSize * firstFileRow));
+				const std::int64_t size = (rowSize * (c1 - c0));
 
-				if (0 < header.biHeight)
+				if (reader.readAt(offset, chunk.data(), size) != size)
 				{
-					// 正の場合は下の行から格納されている
-					image[height - 1 - y][x] = color;
+					failed = true;
+					return;
 				}
-				else
+
+				for (int y = c0; y < c1; ++y)
 				{
-					// 負の場合は上の行から格納されている
-					image[y][x] = color;
+					const int chunkRow = (topDown ? (y - c0) : (c1 - 1 - y));
+					DecodeRow(std::span{ chunk }.subspan((rowSize * chunkRow), rowSize), image.row(y), header.biBitCount);
 				}
 			}
+		});
+
+		if (failed)
+		{
+			return{};
+		}
+
+		return image;
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> LoadBMP(std::string_view fileName, const Rect& roi)
+	{
+		const BinaryFileReader reader{ fileName };
+
+		// ファイルがオープンされていない場合は失敗
+		if (!reader)
+		{
+			return{};
+		}
+
+		BMPHeader header;
+
+		// ヘッダーを読み込めない場合、または対応していない形式の場合は失敗
+		if ((reader.readAt(0, &header, sizeof(BMPHeader)) != sizeof(BMPHeader))
+			|| (!IsSupportedBMP(header, reader.size())))
+		{
+			return{};
+		}
+
+		const int width = header.biWidth;
+		const int height = std::abs(header.biHeight); // 負の場合は上の行から格納されている
+		const bool topDown = (header.biHeight < 0);
+		const std::size_t rowSize = GetRowSize(width, header.biBitCount);
+
+		// 読み込む領域を画像の範囲に収める。重ならない場合は失敗
+		const Rect region = roi.intersection(Rect{ 0, 0, width, height });
+
+		if (region.isEmpty())
+		{
+			return{};
+		}
+
+		const std::size_t bytesPerPixel = (header.biBitCount / 8);
+		const std::size_t regionBytes = (region.w * bytesPerPixel);
+
+		// 領域の幅が行の半分に満たない場合は、行ごとに必要な列だけを読み込む。
+		// それ以外の場合は、複数行をまとめて読み込む（一度に 1 MiB 程度）
+		const bool columnsOnly = ((regionBytes * 2) < rowSize);
+		const int chunkRows = (columnsOnly ? 1 : static_cast<int>(std::clamp<std::size_t>(((1 << 20) / rowSize), 1, region.h)));
+		std::vector<std::byte> chunk(columnsOnly ? regionBytes : (rowSize * chunkRows));
+
+		// すべてのピクセルを上書きするので、初期化しない
+		BasicImage<PixelType> image{ region.w, region.h, Uninitialized };
+
+		for (int c0 = 0; c0 < region.h; c0 += chunkRows)
+		{
+			const int c1 = std::min((c0 + chunkRows), region.h);
+
+			// 下の行から格納されている場合は、ファイル内では c1 - 1 行目が先頭になる
+			const int firstFileRow = (topDown ? (region.y + c0) : (height - (region.y + c1)));
+			const std::int64_t offset = (header.bfOffBits + (rowSize * firstFileRow) + (columnsOnly ? (region.x * bytesPerPixel) : 0));
+			const std::int64_t size = (columnsOnly ? regionBytes : (rowSize * (c1 - c0)));
+
+			if (reader.readAt(offset, chunk.data(), size) != size)
+			{
+				return{};
+			}
+
+			for (int y = c0; y < c1; ++y)
+			{
+				const int chunkRow = (topDown ? (y - c0) : (c1 - 1 - y));
+				const std::size_t rowOffset = (columnsOnly ? 0 : ((rowSize * chunkRow) + (region.x * bytesPerPixel)));
+				DecodeRow(std::span{ chunk }.subspan(rowOffset, regionBytes), image.row(y), header.biBitCount);
+			}
 		}
 
 		return image;
 	}
+
+	// 対応するピクセルの型について、明示的にインスタンス化する
+	template bool SaveBMP<Color>(const Image&, std::string_view);
+	template bool SaveBMP<ColorF>(const ImageF&, std::string_view);
+	template bool SaveBMP<Color8>(const Image8&, std::string_view);
+	template bool SaveBMP<ColorA8>(const ImageA8&, std::string_view);
+	template bool SaveBMP<Color>(const ConstImageView&, std::string_view);
+	template bool SaveBMP<ColorF>(const ConstImageViewF&, std::string_view);
+	template bool SaveBMP<Color8>(const ConstImageView8&, std::string_view);
+	template bool SaveBMP<ColorA8>(const ConstImageViewA8&, std::string_view);
+	template Image LoadBMP<Color>(std::string_view);
+	template ImageF LoadBMP<ColorF>(std::string_view);
+	template Image8 LoadBMP<Color8>(std::string_view);
+	template ImageA8 LoadBMP<ColorA8>(std::string_view);
+	template bool SaveBMP<Color>(const Image&, std::string_view, const ParallelOptions&);
+	template bool SaveBMP<ColorF>(const ImageF&, std::string_view, const ParallelOptions&);
+	template bool SaveBMP<Color8>(const Image8&, std::string_view, const ParallelOptions&);
+	template bool SaveBMP<ColorA8>(const ImageA8&, std::string_view, const ParallelOptions&);
+	template bool SaveBMP<Color>(const ConstImageView&, std::string_view, const ParallelOptions&);
+	template bool SaveBMP<ColorF>(const ConstImageViewF&, std::string_view, const ParallelOptions&);
+	template bool SaveBMP<Color8>(const ConstImageView8&, std::string_view, const ParallelOptions&);
+	template bool SaveBMP<ColorA8>(const ConstImageViewA8&, std::string_view, const ParallelOptions&);
+	template Image LoadBMP<Color>(std::string_view, const ParallelOptions&);
+	template ImageF LoadBMP<ColorF>(std::string_view, const ParallelOptions&);
+	template Image8 LoadBMP<Color8>(std::string_view, const ParallelOptions&);
+	template ImageA8 LoadBMP<ColorA8>(std::string_view, const ParallelOptions&);
+	template Image LoadBMP<Color>(std::string_view, const Rect&);
+	template ImageF LoadBMP<ColorF>(std::string_view, const Rect&);
+	template Image8 LoadBMP<Color8>(std::string_view, const Rect&);
+	template ImageA8 LoadBMP<ColorA8>(std::string_view, const Rect&);
 }
@@ -1,44 +1,280 @@
 ﻿#pragma once
-#include <vector>		// std::vector
-#include <algorithm>	// std::fill
+#include <algorithm>	// std::fill_n
 #include <cassert>		// assert
+#include <cstddef>		// std::size_t
+#include <numeric>		// std::lcm
 #include <span>			// std::span
+#include <string_view>	// std::string_view
+#include <type_traits>	// std::is_const_v
+#include <memory>		// std::shared_ptr
+#include <memory_resource>	// std::pmr::memory_resource
+#include <utility>		// std::move, std::forward
 #include "Color.hpp"	// mini::Color
+#include "ColorF.hpp"	// mini::ColorF
+#include "Color8.hpp"	// mini::Color8
+#include "ColorA8.hpp"	// mini::ColorA8
+#include "PixelCast.hpp"	// mini::PixelCast
 #include "Point.hpp"	// mini::Point
+#include "Rect.hpp"		// mini::Rect
+#include "Parallel.hpp"	// mini::ParallelOptions, mini::ParallelForBands, mini::ExecutionPolicy
+#include "AlignedBuffer.hpp"	// mini::AlignedBuffer, mini::CacheLineSize, mini::Uninitialized
+#include "ImageIterator.hpp"	// mini::ImageIterator
+#include "ImageView.hpp"	// mini::BasicImageView
+#include "ImagePool.hpp"	// mini::ImagePool
+#include "ImageExpression.hpp"	// mini::ImageExpression
 
 namespace mini
 {
+	template <class PixelType>
+	class BasicImage;
+
+	/// @brief BMP 形式で画像を保存します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param image 保存する画像
+	/// @param fileName 保存先のファイル名
+	/// @return 保存に成功した場合 true, それ以外の場合は false
+	/// @remark `ColorA8` の画像は不透明度付きの 32 ビットカラー（BGRA）で、それ以外は 24 ビットカラーで保存します。
+	template <class PixelType>
+	bool SaveBMP(const BasicImage<PixelType>& image, std::string_view fileName);
+
+	/// @brief BMP 形式でビューが参照する画像を保存します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param view 保存する画像のビュー
+	/// @param fileName 保存先のファイル名
+	/// @return 保存に成功した場合 true, それ以外の場合は false
+	template <class PixelType>
+	bool SaveBMP(const BasicImageView<const PixelType>& view, std::string_view fileName);
+
+	/// @brief BMP 形式でビューが参照する画像を保存します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param view 保存する画像のビュー
+	/// @param fileName 保存先のファイル名
+	/// @return 保存に成功した場合 true, それ以外の場合は false
+	template <class PixelType> requires (!std::is_const_v<PixelType>)
+	bool SaveBMP(const BasicImageView<PixelType>& view, std::string_view fileName)
+	{
+		return SaveBMP(BasicImageView<const PixelType>{ view }, fileName);
+	}
+
+	/// @brief BMP 形式の画像を読み込みます。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param fileName 読み込むファイル名
+	/// @return 読み込んだ画像。読み込みに失敗した場合は空の画像を返します。
+	/// @remark 24 ビットカラーと、圧縮なしの 32 ビットカラー（BGRA）の BMP ファイルに対応します。
+	/// `ColorA8` 以外の型で 32 ビットカラーを読み込む場合、不透明度は無視します。24 ビットカラーを `ColorA8` で読み込む場合は不透明になります。
+	template <class PixelType = Color>
+	[[nodiscard]]
+	BasicImage<PixelType> LoadBMP(std::string_view fileName);
+
+	/// @brief BMP 形式で画像を保存します。画像を行の帯に分割し、各帯を別々のスレッドで変換して書き込みます。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param image 保存する画像
+	/// @param fileName 保存先のファイル名
+	/// @param options 並列処理の設定
+	/// @return 保存に成功した場合 true, それ以外の場合は false
+	template <class PixelType>
+	bool SaveBMP(const BasicImage<PixelType>& image, std::string_view fileName, const ParallelOptions& options);
+
+	/// @brief BMP 形式でビューが参照する画像を保存します。画像を行の帯に分割し、各帯を別々のスレッドで変換して書き込みます。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param view 保存する画像のビュー
+	/// @param fileName 保存先のファイル名
+	/// @param options 並列処理の設定
+	/// @return 保存に成功した場合 true, それ以外の場合は false
+	template <class PixelType>
+	bool SaveBMP(const BasicImageView<const PixelType>& view, std::string_view fileName, const ParallelOptions& options);
+
+	/// @brief BMP 形式でビューが参照する画像を保存します。画像を行の帯に分割し、各帯を別々のスレッドで変換して書き込みます。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param view 保存する画像のビュー
+	/// @param fileName 保存先のファイル名
+	/// @param options 並列処理の設定
+	/// @return 保存に成功した場合 true, それ以外の場合は false
+	template <class PixelType> requires (!std::is_const_v<PixelType>)
+	bool SaveBMP(const BasicImageView<PixelType>& view, std::string_view fileName, const ParallelOptions& options)
+	{
+		return SaveBMP(BasicImageView<const PixelType>{ view }, fileName, options);
+	}
+
+	/// @brief BMP 形式の画像を読み込みます。画像を行の帯に分割し、各帯を別々のスレッドで読み込んで変換します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param fileName 読み込むファイル名
+	/// @param options 並列処理の設定
+	/// @return 読み込んだ画像。読み込みに失敗した場合は空の画像を返します。
+	template <class PixelType = Color>
+	[[nodiscard]]
+	BasicImage<PixelType> LoadBMP(std::string_view fileName, const ParallelOptions& options);
+
+	/// @brief BMP 形式の画像の、指定した領域だけを読み込みます。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param fileName 読み込むファイル名
+	/// @param roi 読み込む領域（画像の範囲外の部分は無視されます）
+	/// @return 読み込んだ画像。読み込みに失敗した場合、または領域が画像と重ならない場合は空の画像を返します。
+	/// @remark ファイルのうち、領域を含む行の必要な列だけを読み込むため、大きな画像の一部を高速に取り出せます。
+	template <class PixelType = Color>
+	[[nodiscard]]
+	BasicImage<PixelType> LoadBMP(std::string_view fileName, const Rect& roi);
+
+	/// @brief 画像の各行の配置方法
+	enum class ImageLayout
+	{
+		/// @brief 行を隙間なく並べる（ストライドは幅と等しい）
+		Packed,
+
+		/// @brief 各行の先頭をキャッシュライン（64 バイト）境界に揃える
+		/// @remark 行ごとに SIMD のアラインされたロード・ストアが使え、行ごとに別々のスレッドで処理しても偽共有が起こりません。
+		Aligned,
+	};
+
 	/// @brief 画像データを表現するクラス
-	class Image
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	template <class PixelType>
+	class BasicImage
 	{
 	public:
 
+		/// @brief ピクセルの型
+		using value_type = PixelType;
+
 		/// @brief デフォルトコンストラクタ
 		[[nodiscard]]
-		Image() = default;
+		BasicImage() = default;
 
 		/// @brief 指定したサイズの画像を作成します
 		/// @param width 画像の幅（ピクセル）
 		/// @param height 画像の高さ（ピクセル）
 		/// @param fillColor 各ピクセルの初期色（デフォルトでは白）
+		/// @param layout 各行の配置方法
 		[[nodiscard]]
-		Image(int width, int height, const Color& fillColor = Color{ 1.0 })
+		BasicImage(int width, int height, const PixelType& fillColor = PixelCast<PixelType>(Color{ 1.0 }), ImageLayout layout = ImageLayout::Packed)
+			: BasicImage{ width, height, fillColor, layout, nullptr } {} // 移譲コンストラクタ
+
+		/// @brief 指定したサイズと行の配置方法で、白で塗りつぶした画像を作成します
+		/// @param width 画像の幅（ピクセル）
+		/// @param height 画像の高さ（ピクセル）
+		/// @param layout 各行の配置方法
+		[[nodiscard]]
+		BasicImage(int width, int height, ImageLayout layout)
+			: BasicImage{ width, height, PixelCast<PixelType>(Color{ 1.0 }), layout } {} // 移譲コンストラクタ
+
+		/// @brief プールのバッファを使って、指定したサイズの画像を作成します
+		/// @param pool バッファを確保するプール。画像が破棄されると、バッファはプールに戻ります
+		/// @param width 画像の幅（ピクセル）
+		/// @param height 画像の高さ（ピクセル）
+		/// @param fillColor 各ピクセルの初期色（デフォルトでは白）
+		/// @param layout 各行の配置方法
+		/// @remark 画像をコピーした場合、コピー先も同じプールのバッファを使います。
+		[[nodiscard]]
+		BasicImage(const ImagePool& pool, int width, int height, const PixelType& fillColor = PixelCast<PixelType>(Color{ 1.0 }), ImageLayout layout = ImageLayout::Packed)
+			: BasicImage{ width, height, fillColor, layout, pool.resource() } {} // 移譲コンストラクタ
+
+		/// @brief 指定したサイズの画像を、ピクセルを初期化せずに作成します
+		/// @param width 画像の幅（ピクセル）
+		/// @param height 画像の高さ（ピクセル）
+		/// @param layout 各行の配置方法
+		/// @remark ピクセルの値は不定です。すべてのピクセルを上書きする場合に、初期化の手間を省けます。
+		[[nodiscard]]
+		BasicImage(int width, int height, UninitializedTag, ImageLayout layout = ImageLayout::Packed)
+			: BasicImage{ width, height, Uninitialized, layout, nullptr } {} // 移譲コンストラクタ
+
+		/// @brief プールのバッファを使って、指定したサイズの画像を、ピクセルを初期化せずに作成します
+		/// @param pool バッファを確保するプール。画像が破棄されると、バッファはプールに戻ります
+		/// @param width 画像の幅（ピクセル）
+		/// @param height 画像の高さ（ピクセル）
+		/// @param layout 各行の配置方法
+		/// @remark ピクセルの値は不定です。再利用したバッファには、以前の画像の内容が残っています。
+		[[nodiscard]]
+		BasicImage(const ImagePool& pool, int width, int height, UninitializedTag, ImageLayout layout = ImageLayout::Packed)
+			: BasicImage{ width, height, Uninitialized, layout, pool.resource() } {} // 移譲コンストラクタ
+
+		/// @brief 指定したサイズの画像を作成し、行の帯ごとに別々のスレッドで塗りつぶします
+		/// @param width 画像の幅（ピクセル）
+		/// @param height 画像の高さ（ピクセル）
+		/// @param fillColor 各ピクセルの初期色
+		/// @param options 並列処理の設定
+		/// @param layout 各行の配置方法
+		/// @remark 並列化するのは塗りつぶしだけです。帯はスレッドプールが動的に割り振るため、
+		/// 後で同じ `options` で処理しても、各帯を同じスレッドが担当するとは限りません（NUMA ノードの配置は保証しません）。
+		[[nodiscard]]
+		BasicImage(int width, int height, const PixelType& fillColor, const ParallelOptions& options, ImageLayout layout = ImageLayout::Packed)
+			: BasicImage{ width, height, Uninitialized, layout, nullptr } // 移譲コンストラクタ
 		{
-			// サイズが不正な場合は空の画像を作成する
-			if ((width <= 0) || (height <= 0))
+			ParallelForBands(m_height, options, [&](const int y0, const int y1)
 			{
-				return;
-			}
+				// 行の末尾のパディングも含めて書き込む
+				std::fill_n((m_pixels.data() + offset(y0)), (offset(y1) - offset(y0)), fillColor);
+			});
+		}
 
-			m_width = width;
-			m_height = height;
-			m_pixels.resize((width * height), fillColor);
+		/// @brief 画像の式を評価して画像を作成します。
+		/// @tparam Expression 式の型
+		/// @param expression 評価する式（`a * 0.5 + b * 0.5` など）
+		/// @param policy 処理の実行方法
+		/// @param layout 各行の配置方法
+		/// @remark 式全体をピクセルごとに 1 回のループで計算するため、途中の画像を作りません。
+		template <ImageExpression Expression>
+		[[nodiscard]]
+		BasicImage(const Expression& expression, ExecutionPolicy policy = ExecutionPolicy::Sequenced, ImageLayout layout = ImageLayout::Packed)
+			: BasicImage{ expression.width(), expression.height(), Uninitialized, layout } // 移譲コンストラクタ
+		{
+			view().assign(expression, policy);
 		}
 
 		/// @brief BMP ファイルから読み込んで画像を作成します。
 		/// @param fileName ファイル名
 		[[nodiscard]]
-		explicit Image(std::string_view fileName);
+		explicit BasicImage(std::string_view fileName)
+			: BasicImage{ LoadBMP<PixelType>(fileName) } {}
+
+		/// @brief 別の形式の画像から変換して画像を作成します。行の配置方法は変換元と同じになります。
+		/// @tparam OtherPixelType 変換元の画像のピクセルの型
+		/// @param other 変換元の画像
+		template <class OtherPixelType>
+		[[nodiscard]]
+		explicit BasicImage(const BasicImage<OtherPixelType>& other)
+			: BasicImage{ other.width(), other.height(), Uninitialized, other.layout() } // 移譲コンストラクタ
+		{
+			for (int y = 0; y < m_height; ++y)
+			{
+				const OtherPixelType* src = other[y];
+				PixelType* dst = (*this)[y];
+
+				for (int x = 0; x < m_width; ++x)
+				{
+					dst[x] = PixelCast<PixelType>(src[x]);
+				}
+			}
+		}
+
+		/// @brief 画像の式を評価して代入します。
+		/// @tparam Expression 式の型
+		/// @param expression 評価する式
+		/// @return *this
+		template <ImageExpression Expression>
+		BasicImage& operator =(const Expression& expression)
+		{
+			assign(expression);
+			return *this;
+		}
+
+		/// @brief 画像の式を評価して代入します。
+		/// @tparam Expression 式の型
+		/// @param expression 評価する式
+		/// @param policy 処理の実行方法
+		/// @remark 大きさが同じ場合は、今のバッファにそのまま書き込みます（`a = a * 0.5 + b` のように、式が自分自身を参照していても構いません）。
+		/// 大きさが異なる場合は、新しい画像に評価してから置き換えます。
+		template <ImageExpression Expression>
+		void assign(const Expression& expression, ExecutionPolicy policy = ExecutionPolicy::Sequenced)
+		{
+			if ((expression.width() == m_width) && (expression.height() == m_height))
+			{
+				view().assign(expression, policy);
+			}
+			else
+			{
+				*this = BasicImage{ expression, policy, m_layout };
+			}
+		}
 
 		/// @brief 画像の幅（ピクセル）を返します。
 		/// @return 画像の幅（ピクセル）
@@ -57,11 +293,27 @@ namespace mini
 		}
 
 		/// @brief 画像のピクセル数を返します。
-		/// @return 画像のピクセル数
+		/// @return 画像のピクセル数（行の末尾のパディングは含まない）
 		[[nodiscard]]
 		int numPixels() const noexcept
 		{
-			return static_cast<int>(m_pixels.size());
+			return (m_width * m_height);
+		}
+
+		/// @brief 行の先頭から次の行の先頭までのピクセル数を返します。
+		/// @return 行の先頭から次の行の先頭までのピクセル数。`ImageLayout::Packed` の場合は幅と等しい
+		[[nodiscard]]
+		int stride() const noexcept
+		{
+			return m_stride;
+		}
+
+		/// @brief 各行の配置方法を返します。
+		/// @return 各行の配置方法
+		[[nodiscard]]
+		ImageLayout layout() const noexcept
+		{
+			return m_layout;
 		}
 
 		/// @brief 画像が空であるかを返します。
@@ -81,26 +333,29 @@ namespace mini
 		}
 
 		/// @brief 画像データの先頭ポインタを返します。
-		/// @return 画像データの先頭ポインタ
+		/// @return 画像データの先頭ポインタ。y 行目の先頭は `data() + y * stride()`
 		[[nodiscard]]
-		Color* data() noexcept
+		PixelType* data() noexcept
 		{
 			return m_pixels.data();
 		}
 
 		/// @brief 画像データの先頭ポインタを返します。
-		/// @return 画像データの先頭ポインタ
+		/// @return 画像データの先頭ポインタ。y 行目の先頭は `data() + y * stride()`
 		[[nodiscard]]
-		const Color* data() const noexcept
+		const PixelType* data() const noexcept
 		{
 			return m_pixels.data();
 		}
 
 		/// @brief 画像を指定した色で塗りつぶします。
 		/// @param fillColor 塗りつぶしの色
-		void fill(const Color& fillColor) noexcept
+		void fill(const PixelType& fillColor) noexcept
 		{
-			std::fill(m_pixels.begin(), m_pixels.end(), fillColor);
+			for (int y = 0; y < m_height; ++y)
+			{
+				std::fill_n((*this)[y], m_width, fillColor);
+			}
 		}
 
 		/// @brief 指定した位置が画像の範囲内であるかを返します。
@@ -116,89 +371,92 @@ namespace mini
 		/// @brief BMP 形式で画像を保存します。
 		/// @param fileName 保存先のファイル名
 		/// @return 保存に成功した場合 true, それ以外の場合は false
-		bool save(std::string_view fileName) const;
+		bool save(std::string_view fileName) const
+		{
+			return SaveBMP(*this, fileName);
+		}
 
 		/// @brief 指定した位置のピクセルの色を返します。範囲外の場合は黒を返します。
 		/// @param y 行番号
 		/// @param x 列番号
 		/// @return 指定した位置のピクセルの色
 		[[nodiscard]]
-		Color getPixel(int y, int x) const noexcept
+		PixelType getPixel(int y, int x) const noexcept
 		{
 			if (!inBounds(y, x))
 			{
-				return Color{ 0.0 }; // 範囲外の場合は黒を返す
+				return PixelType{}; // 範囲外の場合は黒を返す
 			}
 
-			return m_pixels[(y * m_width) + x];
+			return m_pixels[offset(y) + x];
 		}
 
 		/// @brief 指定した位置のピクセルの色を設定します。範囲外の場合は何もしません。
 		/// @param y 行番号
 		/// @param x 列番号
 		/// @param color 設定する色
-		void setPixel(int y, int x, const Color& color) noexcept
+		void setPixel(int y, int x, const PixelType& color) noexcept
 		{
 			if (!inBounds(y, x))
 			{
 				return; // 範囲外の場合は何もしない
 			}
 
-			m_pixels[(y * m_width) + x] = color;
+			m_pixels[offset(y) + x] = color;
 		}
 
 		/// @brief y 行目の先頭ピクセルへのポインタを返します。
 		/// @param y 行番号
 		/// @return y 行目の先頭ピクセルへのポインタ
 		[[nodiscard]]
-		Color* operator [](int y) noexcept
+		PixelType* operator [](int y) noexcept
 		{
 			assert((0 <= y) && (y < m_height));
-			return &m_pixels[y * m_width];
+			return (m_pixels.data() + offset(y));
 		}
 
 		/// @brief y 行目の先頭ピクセルへのポインタを返します。
 		/// @param y 行番号
 		/// @return y 行目の先頭ピクセルへのポインタ
 		[[nodiscard]]
-		const Color* operator [](int y) const noexcept
+		const PixelType* operator [](int y) const noexcept
 		{
 			assert((0 <= y) && (y < m_height));
-			return &m_pixels[y * m_width];
+			return (m_pixels.data() + offset(y));
 		}
 
 		/// @brief 指定した位置のピクセルの参照を返します。
 		/// @param p ピクセルの位置
 		/// @return 指定した位置のピクセルの参照
 		[[nodiscard]]
-		Color& operator [](const Point& p) noexcept
+		PixelType& operator [](const Point& p) noexcept
 		{
 			assert(inBounds(p.y, p.x));
-			return m_pixels[(p.y * m_width) + p.x];
+			return m_pixels[offset(p.y) + p.x];
 		}
 
 		/// @brief 指定した位置のピクセルの参照を返します。
 		/// @param p ピクセルの位置
 		/// @return 指定した位置のピクセルの参照
 		[[nodiscard]]
-		const Color& operator [](const Point& p) const noexcept
+		const PixelType& operator [](const Point& p) const noexcept
 		{
 			assert(inBounds(p.y, p.x));
-			return m_pixels[(p.y * m_width) + p.x];
+			return m_pixels[offset(p.y) + p.x];
 		}
 
-		/// @brief イテレータの型
-		using iterator = std::vector<Color>::iterator;
+		/// @brief イテレータの型（行の末尾のパディングは読み飛ばす）
+		using iterator = ImageIterator<PixelType>;
 		
-		/// @brief const イテレータの型
-		using const_iterator = std::vector<Color>::const_iterator;
+		/// @brief const イテレータの型（行の末尾のパディングは読み飛ばす）
+		using const_iterator = ImageIterator<const PixelType>;
 
 		/// @brief 先頭イテレータを返します。
 		/// @return 先頭イテレータ
 		[[nodiscard]]
 		iterator begin() noexcept
 		{
-			return m_pixels.begin();
+			return{ m_pixels.data(), m_width, m_stride };
 		}
 
 		/// @brief 先頭イテレータを返します。
@@ -206,7 +464,7 @@ namespace mini
 		[[nodiscard]]
 		const_iterator begin() const noexcept
 		{
-			return m_pixels.begin();
+			return cbegin();
 		}
 
 		/// @brief 終端イテレータを返します。
@@ -214,7 +472,7 @@ namespace mini
 		[[nodiscard]]
 		iterator end() noexcept
 		{
-			return m_pixels.end();
+			return{ (m_pixels.data() + offset(m_height)), m_width, m_stride };
 		}
 
 		/// @brief 終端イテレータを返します。
@@ -222,7 +480,7 @@ namespace mini
 		[[nodiscard]]
 		const_iterator end() const noexcept
 		{
-			return m_pixels.end();
+			return cend();
 		}
 
 		/// @brief 先頭 const イテレータを返します。
@@ -230,7 +488,7 @@ namespace mini
 		[[nodiscard]]
 		const_iterator cbegin() const noexcept
 		{
-			return m_pixels.cbegin();
+			return{ m_pixels.data(), m_width, m_stride };
 		}
 
 		/// @brief 終端 const イテレータを返します。
@@ -238,50 +496,204 @@ namespace mini
 		[[nodiscard]]
 		const_iterator cend() const noexcept
 		{
-			return m_pixels.cend();
+			return{ (m_pixels.data() + offset(m_height)), m_width, m_stride };
+		}
+
+		/// @brief 各ピクセルを、関数を適用した結果で置き換えます。
+		/// @tparam Function 関数の型
+		/// @param policy 処理の実行方法
+		/// @param function ピクセルの色を受け取り、新しい色を返す関数。並列に処理する場合は、複数のスレッドから同時に呼ばれます
+		template <class Function>
+		void transform(ExecutionPolicy policy, Function&& function)
+		{
+			view().transform(policy, std::forward<Function>(function));
+		}
+
+		/// @brief 各ピクセルについて、位置とピクセルの参照を渡して関数を呼び出します。
+		/// @tparam Function 関数の型
+		/// @param policy 処理の実行方法
+		/// @param function ピクセルの位置（`Point`）と参照を受け取る関数。並列に処理する場合は、複数のスレッドから同時に呼ばれます
+		template <class Function>
+		void forEachPixel(ExecutionPolicy policy, Function&& function)
+		{
+			view().forEachPixel(policy, std::forward<Function>(function));
+		}
+
+		/// @brief 各ピクセルについて、位置とピクセルの const 参照を渡して関数を呼び出します。
+		/// @tparam Function 関数の型
+		/// @param policy 処理の実行方法
+		/// @param function ピクセルの位置（`Point`）と const 参照を受け取る関数。並列に処理する場合は、複数のスレッドから同時に呼ばれます
+		template <class Function>
+		void forEachPixel(ExecutionPolicy policy, Function&& function) const
+		{
+			view().forEachPixel(policy, std::forward<Function>(function));
+		}
+
+		/// @brief 画像全体を参照するビューを返します。
+		/// @return 画像全体を参照するビュー
+		[[nodiscard]]
+		BasicImageView<PixelType> view() noexcept
+		{
+			return{ m_pixels.data(), m_width, m_height, m_stride };
+		}
+
+		/// @brief 画像全体を参照する読み取り専用のビューを返します。
+		/// @return 画像全体を参照する読み取り専用のビュー
+		[[nodiscard]]
+		BasicImageView<const PixelType> view() const noexcept
+		{
+			return{ m_pixels.data(), m_width, m_height, m_stride };
+		}
+
+		/// @brief 画像の指定した領域を参照するビューを返します。ピクセルはコピーされません。
+		/// @param topLeft 領域の左上の位置
+		/// @param size 領域の幅と高さ
+		/// @return 指定した領域を参照するビュー（画像の範囲外の部分は除かれる）。重ならない場合は空のビュー
+		[[nodiscard]]
+		BasicImageView<PixelType> subView(const Point& topLeft, const Point& size) noexcept
+		{
+			return view().subView(topLeft, size);
+		}
+
+		/// @brief 画像の指定した領域を参照する読み取り専用のビューを返します。ピクセルはコピーされません。
+		/// @param topLeft 領域の左上の位置
+		/// @param size 領域の幅と高さ
+		/// @return 指定した領域を参照するビュー（画像の範囲外の部分は除かれる）。重ならない場合は空のビュー
+		[[nodiscard]]
+		BasicImageView<const PixelType> subView(const Point& topLeft, const Point& size) const noexcept
+		{
+			return view().subView(topLeft, size);
 		}
 
 		/// @brief 指定した行のビューを返します。
 		/// @param y 行番号
 		/// @return 指定した行のビュー
 		[[nodiscard]]
-		std::span<Color> row(int y) noexcept
+		std::span<PixelType> row(int y) noexcept
 		{
 			assert((0 <= y) && (y < m_height));
-			return std::span<Color>{ &m_pixels[y * m_width], static_cast<std::size_t>(m_width) };
+			return std::span<PixelType>{ (m_pixels.data() + offset(y)), static_cast<std::size_t>(m_width) };
 		}
 
 		/// @brief 指定した行のビューを返します。
 		/// @param y 行番号
 		///	@return 指定した行のビュー
 		[[nodiscard]]
-		std::span<const Color> row(int y) const noexcept
+		std::span<const PixelType> row(int y) const noexcept
 		{
 			assert((0 <= y) && (y < m_height));
-			return std::span<const Color>{ &m_pixels[y * m_width], static_cast<std::size_t>(m_width) };
+			return std::span<const PixelType>{ (m_pixels.data() + offset(y)), static_cast<std::size_t>(m_width) };
 		}
 
 	private:
 
-		/// @brief 画像のピクセルデータ（行優先の一次元配列）
-		std::vector<Color> m_pixels;
+		/// @brief 指定したメモリリソースのバッファを使って、指定したサイズの画像を作成します
+		[[nodiscard]]
+		BasicImage(int width, int height, const PixelType& fillColor, ImageLayout layout, std::shared_ptr<std::pmr::memory_resource> resource)
+		{
+			// サイズが不正な場合は空の画像を作成する
+			if ((width <= 0) || (height <= 0))
+			{
+				return;
+			}
+
+			m_width = width;
+			m_height = height;
+			m_stride = GetStride(width, layout);
+			m_layout = layout;
+			m_pixels = AlignedBuffer<PixelType>((static_cast<std::size_t>(m_stride) * height), fillColor, std::move(resource));
+		}
+
+		/// @brief 指定したメモリリソースのバッファを使って、指定したサイズの画像を、ピクセルを初期化せずに作成します
+		[[nodiscard]]
+		BasicImage(int width, int height, UninitializedTag, ImageLayout layout, std::shared_ptr<std::pmr::memory_resource> resource)
+		{
+			// サイズが不正な場合は空の画像を作成する
+			if ((width <= 0) || (height <= 0))
+			{
+				return;
+			}
+
+			m_width = width;
+			m_height = height;
+			m_stride = GetStride(width, layout);
+			m_layout = layout;
+			m_pixels = AlignedBuffer<PixelType>((static_cast<std::size_t>(m_stride) * height), Uninitialized, std::move(resource));
+		}
+
+		/// @brief 画像のピクセルデータ（行優先の一次元配列。各行の末尾にはストライドまでのパディングを含む）
+		AlignedBuffer<PixelType> m_pixels;
 
 		/// @brief 画像の幅（ピクセル）
 		int m_width = 0;
 
 		/// @brief 画像の高さ（ピクセル）
 		int m_height = 0;
+
+		/// @brief 行の先頭から次の行の先頭までのピクセル数
+		int m_stride = 0;
+
+		/// @brief 各行の配置方法
+		ImageLayout m_layout = ImageLayout::Packed;
+
+		/// @brief y 行目の先頭の、画像データの先頭からの位置を返します。
+		[[nodiscard]]
+		std::size_t offset(int y) const noexcept
+		{
+			return (static_cast<std::size_t>(y) * m_stride);
+		}
+
+		/// @brief 行の配置方法に応じたストライドを返します。
+		/// @param width 画像の幅（ピクセル）
+		/// @param layout 各行の配置方法
+		/// @return 行の先頭から次の行の先頭までのピクセル数
+		[[nodiscard]]
+		static int GetStride(int width, ImageLayout layout) noexcept
+		{
+			if (layout == ImageLayout::Packed)
+			{
+				return width;
+			}
+
+			// 行のバイト数がキャッシュラインのサイズの倍数になる、最小のピクセル数の単位
+			constexpr int Unit = static_cast<int>(std::lcm(CacheLineSize, sizeof(PixelType)) / sizeof(PixelType));
+			return (((width + Unit - 1) / Unit) * Unit);
+		}
 	};
 
-	/// @brief BMP 形式で画像を保存します。
-	/// @param image 保存する画像
-	/// @param fileName 保存先のファイル名
-	/// @return 保存に成功した場合 true, それ以外の場合は false
-	bool SaveBMP(const Image& image, std::string_view fileName);
+	/// @brief 画像データを表現するクラス（各成分 double）
+	using Image = BasicImage<Color>;
 
-	/// @brief BMP 形式の画像を読み込みます。
-	/// @param fileName 読み込むファイル名
-	/// @return 読み込んだ画像。読み込みに失敗した場合は空の画像を返します。
-	[[nodiscard]]
-	Image LoadBMP(std::string_view fileName);
+	/// @brief 画像データを表現するクラス（各成分 float）
+	using ImageF = BasicImage<ColorF>;
+
+	/// @brief 画像データを表現するクラス（各成分 8 ビット整数）
+	using Image8 = BasicImage<Color8>;
+
+	/// @brief 不透明度付きの画像データを表現するクラス（各成分 8 ビット整数）
+	using ImageA8 = BasicImage<ColorA8>;
+
+	/// @brief `Image` の一部または全体を参照するビュー
+	using ImageView = BasicImageView<Color>;
+
+	/// @brief `Image` の一部または全体を参照する読み取り専用のビュー
+	using ConstImageView = BasicImageView<const Color>;
+
+	/// @brief `ImageF` の一部または全体を参照するビュー
+	using ImageViewF = BasicImageView<ColorF>;
+
+	/// @brief `ImageF` の一部または全体を参照する読み取り専用のビュー
+	using ConstImageViewF = BasicImageView<const ColorF>;
+
+	/// @brief `Image8` の一部または全体を参照するビュー
+	using ImageView8 = BasicImageView<Color8>;
+
+	/// @brief `Image8` の一部または全体を参照する読み取り専用のビュー
+	using ConstImageView8 = BasicImageView<const Color8>;
+
+	/// @brief `ImageA8` の一部または全体を参照するビュー
+	using ImageViewA8 = BasicImageView<ColorA8>;
+
+	/// @brief `ImageA8` の一部または全体を参照する読み取り専用のビュー
+	using ConstImageViewA8 = BasicImageView<const ColorA8>;
 }
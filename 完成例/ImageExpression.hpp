@@ -0,0 +1,314 @@
+﻿#pragma once
+#include <algorithm>	// std::min
+#include <concepts>		// std::derived_from
+#include <functional>	// std::plus, std::minus, std::multiplies, std::divides, std::negate
+#include <limits>		// std::numeric_limits
+#include <type_traits>	// std::remove_cvref_t, std::remove_const_t, std::invoke_result_t, std::is_invocable_v, std::true_type, std::false_type
+#include <utility>		// std::declval
+#include "ImageView.hpp"	// mini::BasicImageView
+
+namespace mini
+{
+	template <class PixelType>
+	class BasicImage;
+
+	/// @brief 画像の式の基底クラス
+	/// @remark 画像どうしの演算（`a * 0.5 + b * 0.5` など）は、結果を計算せずに式の木を作ります。
+	/// 式を画像やビューに代入したときに、ピクセルごとに式全体を 1 回のループで計算するため、途中の画像を作りません。
+	struct ImageExpressionBase {};
+
+	/// @brief 画像の式であるかを表すコンセプト
+	/// @remark 式は `width()`, `height()` と、y 行目の各列の値を `[x]` で返す `row(y)` を持ちます。
+	template <class Type>
+	concept ImageExpression = std::derived_from<std::remove_cvref_t<Type>, ImageExpressionBase>;
+
+	/// @brief 画像またはビューを参照する式
+	/// @tparam PixelType ピクセルの型
+	/// @remark 画像のピクセルデータを参照するだけなので、式を評価するまで画像を破棄してはいけません。
+	template <class PixelType>
+	class ImageTerm : public ImageExpressionBase
+	{
+	public:
+
+		/// @brief 式の値の型
+		using value_type = PixelType;
+
+		/// @brief 画像を参照する式を作成します。
+		/// @param view 参照する画像のビュー
+		[[nodiscard]]
+		explicit ImageTerm(const BasicImageView<const PixelType>& view) noexcept
+			: m_view{ view } {}
+
+		[[nodiscard]]
+		int width() const noexcept
+		{
+			return m_view.width();
+		}
+
+		[[nodiscard]]
+		int height() const noexcept
+		{
+			return m_view.height();
+		}
+
+		/// @brief y 行目の先頭ピクセルへのポインタを返します。
+		[[nodiscard]]
+		const PixelType* row(const int y) const noexcept
+		{
+			return m_view[y];
+		}
+
+	private:
+
+		BasicImageView<const PixelType> m_view;
+	};
+
+	/// @brief 定数（色や数値）を表す式。すべての位置で同じ値を返します。
+	/// @tparam Type 定数の型
+	template <class Type>
+	class ConstantTerm : public ImageExpressionBase
+	{
+	public:
+
+		/// @brief 式の値の型
+		using value_type = Type;
+
+		/// @brief 定数の行。すべての列で同じ値を返します。
+		struct Row
+		{
+			const Type& value;
+
+			[[nodiscard]]
+			const Type& operator [](int) const noexcept
+			{
+				return value;
+			}
+		};
+
+		[[nodiscard]]
+		explicit ConstantTerm(const Type& value) noexcept
+			: m_value{ value } {}
+
+		/// @brief 幅を返します。ほかの式の大きさを制限しないよう、int の最大値を返します。
+		[[nodiscard]]
+		int width() const noexcept
+		{
+			return std::numeric_limits<int>::max();
+		}
+
+		/// @brief 高さを返します。ほかの式の大きさを制限しないよう、int の最大値を返します。
+		[[nodiscard]]
+		int height() const noexcept
+		{
+			return std::numeric_limits<int>::max();
+		}
+
+		[[nodiscard]]
+		Row row(int) const noexcept
+		{
+			return{ m_value };
+		}
+
+	private:
+
+		Type m_value;
+	};
+
+	/// @brief 単項演算の式
+	/// @tparam Operation 演算の関数オブジェクトの型
+	/// @tparam Operand 演算する式の型
+	template <class Operation, class Operand>
+	class UnaryImageExpression : public ImageExpressionBase
+	{
+	public:
+
+		/// @brief 式の値の型
+		using value_type = std::remove_cvref_t<std::invoke_result_t<Operation, const typename Operand::value_type&>>;
+
+		/// @brief 式の行
+		struct Row
+		{
+			decltype(std::declval<const Operand&>().row(0)) operand;
+
+			[[nodiscard]]
+			value_type operator [](const int x) const noexcept
+			{
+				return Operation{}(operand[x]);
+			}
+		};
+
+		[[nodiscard]]
+		explicit UnaryImageExpression(const Operand& operand) noexcept
+			: m_operand{ operand } {}
+
+		[[nodiscard]]
+		int width() const noexcept
+		{
+			return m_operand.width();
+		}
+
+		[[nodiscard]]
+		int height() const noexcept
+		{
+			return m_operand.height();
+		}
+
+		[[nodiscard]]
+		Row row(const int y) const noexcept
+		{
+			return{ m_operand.row(y) };
+		}
+
+	private:
+
+		Operand m_operand;
+	};
+
+	/// @brief 二項演算の式
+	/// @tparam Operation 演算の関数オブジェクトの型
+	/// @tparam Left 左辺の式の型
+	/// @tparam Right 右辺の式の型
+	/// @remark 大きさは、左辺と右辺の共通部分（左上をそろえたときに重なる部分）です。
+	template <class Operation, class Left, class Right>
+	class BinaryImageExpression : public ImageExpressionBase
+	{
+	public:
+
+		/// @brief 式の値の型
+		using value_type = std::remove_cvref_t<std::invoke_result_t<Operation, const typename Left::value_type&, const typename Right::value_type&>>;
+
+		/// @brief 式の行
+		struct Row
+		{
+			decltype(std::declval<const Left&>().row(0)) left;
+
+			decltype(std::declval<const Right&>().row(0)) right;
+
+			[[nodiscard]]
+			value_type operator [](const int x) const noexcept
+			{
+				return Operation{}(left[x], right[x]);
+			}
+		};
+
+		[[nodiscard]]
+		BinaryImageExpression(const Left& left, const Right& right) noexcept
+			: m_left{ left }
+			, m_right{ right } {}
+
+		[[nodiscard]]
+		int width() const noexcept
+		{
+			return std::min(m_left.width(), m_right.width());
+		}
+
+		[[nodiscard]]
+		int height() const noexcept
+		{
+			return std::min(m_left.height(), m_right.height());
+		}
+
+		[[nodiscard]]
+		Row row(const int y) const noexcept
+		{
+			return{ m_left.row(y), m_right.row(y) };
+		}
+
+	private:
+
+		Left m_left;
+
+		Right m_right;
+	};
+
+	/// @brief 式の項に変換します（式はそのまま）。
+	template <ImageExpression Expression>
+	[[nodiscard]]
+	const Expression& ToImageTerm(const Expression& expression) noexcept
+	{
+		return expression;
+	}
+
+	/// @brief 式の項に変換します（画像は、画像を参照する項）。
+	template <class PixelType>
+	[[nodiscard]]
+	ImageTerm<PixelType> ToImageTerm(const BasicImage<PixelType>& image) noexcept
+	{
+		return ImageTerm<PixelType>{ image.view() };
+	}
+
+	/// @brief 式の項に変換します（ビューは、ビューを参照する項）。
+	template <class PixelType>
+	[[nodiscard]]
+	ImageTerm<std::remove_const_t<PixelType>> ToImageTerm(const BasicImageView<PixelType>& view) noexcept
+	{
+		return ImageTerm<std::remove_const_t<PixelType>>{ view };
+	}
+
+	/// @brief 式の項に変換します（それ以外は定数の項）。
+	template <class Type>
+	[[nodiscard]]
+	ConstantTerm<Type> ToImageTerm(const Type& value) noexcept
+	{
+		return ConstantTerm<Type>{ value };
+	}
+
+	/// @brief 画像またはビューの型であるかを表す型特性
+	template <class Type>
+	struct IsImageOrView : std::false_type {};
+
+	template <class PixelType>
+	struct IsImageOrView<BasicImage<PixelType>> : std::true_type {};
+
+	template <class PixelType>
+	struct IsImageOrView<BasicImageView<PixelType>> : std::true_type {};
+
+	/// @brief 画像、ビュー、式のいずれかであるかを表すコンセプト
+	template <class Type>
+	concept ImageOperand = ImageExpression<Type> || IsImageOrView<std::remove_cvref_t<Type>>::value;
+
+	/// @brief 式の項の型
+	template <class Type>
+	using ImageTermType = std::remove_cvref_t<decltype(ToImageTerm(std::declval<const Type&>()))>;
+
+	/// @brief 二項演算の式を作れるかを表すコンセプト（少なくとも一方が画像、ビュー、式で、値どうしの演算が定義されている）
+	template <class Operation, class Left, class Right>
+	concept ImageBinaryOperable = (ImageOperand<Left> || ImageOperand<Right>)
+		&& std::is_invocable_v<Operation, const typename ImageTermType<Left>::value_type&, const typename ImageTermType<Right>::value_type&>;
+
+	template <class Operand> requires ImageOperand<Operand>
+		&& std::is_invocable_v<std::negate<>, const typename ImageTermType<Operand>::value_type&>
+	[[nodiscard]]
+	auto operator -(const Operand& operand)
+	{
+		return UnaryImageExpression<std::negate<>, ImageTermType<Operand>>{ ToImageTerm(operand) };
+	}
+
+	template <class Left, class Right> requires ImageBinaryOperable<std::plus<>, Left, Right>
+	[[nodiscard]]
+	auto operator +(const Left& left, const Right& right)
+	{
+		return BinaryImageExpression<std::plus<>, ImageTermType<Left>, ImageTermType<Right>>{ ToImageTerm(left), ToImageTerm(right) };
+	}
+
+	template <class Left, class Right> requires ImageBinaryOperable<std::minus<>, Left, Right>
+	[[nodiscard]]
+	auto operator -(const Left& left, const Right& right)
+	{
+		return BinaryImageExpression<std::minus<>, ImageTermType<Left>, ImageTermType<Right>>{ ToImageTerm(left), ToImageTerm(right) };
+	}
+
+	template <class Left, class Right> requires ImageBinaryOperable<std::multiplies<>, Left, Right>
+	[[nodiscard]]
+	auto operator *(const Left& left, const Right& right)
+	{
+		return BinaryImageExpression<std::multiplies<>, ImageTermType<Left>, ImageTermType<Right>>{ ToImageTerm(left), ToImageTerm(right) };
+	}
+
+	template <class Left, class Right> requires ImageBinaryOperable<std::divides<>, Left, Right>
+	[[nodiscard]]
+	auto operator /(const Left& left, const Right& right)
+	{
+		return BinaryImageExpression<std::divides<>, ImageTermType<Left>, ImageTermType<Right>>{ ToImageTerm(left), ToImageTerm(right) };
+	}
+}
@@ -0,0 +1,204 @@
+﻿#pragma once
+#include <compare>		// std::strong_ordering, std::compare_three_way
+#include <cstddef>		// std::ptrdiff_t
+#include <iterator>		// std::random_access_iterator_tag
+#include <type_traits>	// std::remove_const_t
+
+namespace mini
+{
+	/// @brief 画像のピクセルを、左上から行ごとに順に走査するランダムアクセスイテレータ
+	/// @tparam PixelType ピクセルの型（const 修飾可）
+	/// @remark 行の末尾のパディング（幅とストライドの差）は読み飛ばします。
+	/// n 個先への移動や差は、行と列に分けて算術的に求めるため、走査するピクセル数によらず一定時間で済みます。
+	/// パディングのない画像（`ImageLayout::Packed`）では、ポインタの加減算だけで移動します。
+	template <class PixelType>
+	class ImageIterator
+	{
+	public:
+
+		using iterator_concept = std::random_access_iterator_tag;
+
+		using iterator_category = std::random_access_iterator_tag;
+
+		using value_type = std::remove_const_t<PixelType>;
+
+		using difference_type = std::ptrdiff_t;
+
+		using pointer = PixelType*;
+
+		using reference = PixelType&;
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		ImageIterator() = default;
+
+		/// @brief イテレータを作成します。
+		/// @param rowBegin 現在の行の先頭ピクセルへのポインタ
+		/// @param width 画像の幅（ピクセル）
+		/// @param stride 行の先頭から次の行の先頭までのピクセル数
+		[[nodiscard]]
+		ImageIterator(PixelType* rowBegin, const std::ptrdiff_t width, const std::ptrdiff_t stride) noexcept
+			: m_pos{ rowBegin }
+			, m_rowBegin{ rowBegin }
+			, m_width{ width }
+			, m_stride{ stride } {}
+
+		/// @brief 非 const のイテレータから変換します。
+		template <class Other> requires std::is_same_v<const Other, PixelType>
+		[[nodiscard]]
+		ImageIterator(const ImageIterator<Other>& other) noexcept
+			: m_pos{ other.m_pos }
+			, m_rowBegin{ other.m_rowBegin }
+			, m_width{ other.m_width }
+			, m_stride{ other.m_stride } {}
+
+		[[nodiscard]]
+		reference operator *() const noexcept
+		{
+			return *m_pos;
+		}
+
+		[[nodiscard]]
+		pointer operator ->() const noexcept
+		{
+			return m_pos;
+		}
+
+		[[nodiscard]]
+		reference operator [](const difference_type n) const noexcept
+		{
+			return *(*this + n);
+		}
+
+		ImageIterator& operator ++() noexcept
+		{
+			// 行の末尾に達したら、パディングを読み飛ばして次の行の先頭へ進む
+			if (++m_pos == (m_rowBegin + m_width))
+			{
+				m_rowBegin += m_stride;
+				m_pos = m_rowBegin;
+			}
+
+			return *this;
+		}
+
+		ImageIterator operator ++(int) noexcept
+		{
+			ImageIterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		ImageIterator& operator --() noexcept
+		{
+			// 行の先頭から戻る場合は、前の行の末尾のピクセルへ移る
+			if (m_pos == m_rowBegin)
+			{
+				m_rowBegin -= m_stride;
+				m_pos = (m_rowBegin + m_width);
+			}
+
+			--m_pos;
+			return *this;
+		}
+
+		ImageIterator operator --(int) noexcept
+		{
+			ImageIterator tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		ImageIterator& operator +=(const difference_type n) noexcept
+		{
+			// パディングがない場合は、ポインタの加算だけで済む
+			if (m_width == m_stride)
+			{
+				m_pos += n;
+				m_rowBegin = m_pos;
+				return *this;
+			}
+
+			// 移動先の列を、行の移動と行内の位置に分ける（負の移動にも対応するため、切り捨ての除算にする）
+			const difference_type column = ((m_pos - m_rowBegin) + n);
+			difference_type rows = (column / m_width);
+			difference_type rest = (column % m_width);
+
+			if (rest < 0)
+			{
+				--rows;
+				rest += m_width;
+			}
+
+			m_rowBegin += (rows * m_stride);
+			m_pos = (m_rowBegin + rest);
+			return *this;
+		}
+
+		ImageIterator& operator -=(const difference_type n) noexcept
+		{
+			return (*this += -n);
+		}
+
+		[[nodiscard]]
+		friend ImageIterator operator +(ImageIterator it, const difference_type n) noexcept
+		{
+			return (it += n);
+		}
+
+		[[nodiscard]]
+		friend ImageIterator operator +(const difference_type n, ImageIterator it) noexcept
+		{
+			return (it += n);
+		}
+
+		[[nodiscard]]
+		friend ImageIterator operator -(ImageIterator it, const difference_type n) noexcept
+		{
+			return (it -= n);
+		}
+
+		[[nodiscard]]
+		friend difference_type operator -(const ImageIterator& lhs, const ImageIterator& rhs) noexcept
+		{
+			if (lhs.m_width == lhs.m_stride)
+			{
+				return (lhs.m_pos - rhs.m_pos);
+			}
+
+			// 行の差と、行内の位置の差から求める
+			const difference_type rows = ((lhs.m_rowBegin - rhs.m_rowBegin) / lhs.m_stride);
+			return ((rows * lhs.m_width) + ((lhs.m_pos - lhs.m_rowBegin) - (rhs.m_pos - rhs.m_rowBegin)));
+		}
+
+		[[nodiscard]]
+		friend bool operator ==(const ImageIterator& lhs, const ImageIterator& rhs) noexcept
+		{
+			return (lhs.m_pos == rhs.m_pos);
+		}
+
+		/// @remark ストライドは幅以上なので、ピクセルの順序はアドレスの順序と一致します。
+		[[nodiscard]]
+		friend std::strong_ordering operator <=>(const ImageIterator& lhs, const ImageIterator& rhs) noexcept
+		{
+			return std::compare_three_way{}(lhs.m_pos, rhs.m_pos);
+		}
+
+	private:
+
+		template <class Other>
+		friend class ImageIterator;
+
+		/// @brief 現在のピクセル
+		PixelType* m_pos = nullptr;
+
+		/// @brief 現在の行の先頭
+		PixelType* m_rowBegin = nullptr;
+
+		/// @brief 画像の幅（ピクセル）
+		std::ptrdiff_t m_width = 0;
+
+		/// @brief 行の先頭から次の行の先頭までのピクセル数
+		std::ptrdiff_t m_stride = 0;
+	};
+}
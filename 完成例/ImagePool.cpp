@@ -0,0 +1,180 @@
+﻿#include <bit>				// std::bit_width
+#include <mutex>			// std::mutex, std::lock_guard
+#include <new>				// ::operator new, std::align_val_t
+#include <unordered_map>	// std::unordered_map
+#include <vector>			// std::vector
+#include "ImagePool.hpp"
+#include "AlignedAllocator.hpp"	// mini::CacheLineSize
+
+namespace mini
+{
+	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+	namespace
+	{
+		/// @brief 最小のバッファのサイズ（バイト）
+		constexpr std::size_t MinBlockSize = 4096;
+
+		/// @brief 確保するサイズが属する階級のサイズを返します。
+		/// @param bytes 確保するサイズ（バイト）
+		/// @return 階級のサイズ（バイト）。2 のべき乗を 4 分割した刻みに切り上げるため、無駄は最大 25%
+		[[nodiscard]]
+		std::size_t GetSizeClass(const std::size_t bytes) noexcept
+		{
+			if (bytes <= MinBlockSize)
+			{
+				return MinBlockSize;
+			}
+
+			const std::size_t step = (std::size_t{ 1 } << (std::bit_width(bytes - 1) - 3));
+			return (((bytes + step - 1) / step) * step);
+		}
+	}
+
+	class ImagePool::Impl : public std::pmr::memory_resource
+	{
+	public:
+
+		explicit Impl(const std::size_t maxCachedBytes)
+			: m_maxCachedBytes{ maxCachedBytes } {}
+
+		~Impl() override
+		{
+			clear();
+		}
+
+		[[nodiscard]]
+		ImagePoolStats stats() const
+		{
+			const std::lock_guard lock{ m_mutex };
+			return m_stats;
+		}
+
+		void resetStats()
+		{
+			const std::lock_guard lock{ m_mutex };
+			m_stats.hits = 0;
+			m_stats.misses = 0;
+		}
+
+		void clear()
+		{
+			std::unordered_map<std::size_t, std::vector<void*>> freeLists;
+			{
+				const std::lock_guard lock{ m_mutex };
+				freeLists.swap(m_freeLists);
+				m_stats.numCachedBuffers = 0;
+				m_stats.cachedBytes = 0;
+			}
+
+			// ロックの外で解放する
+			for (const auto& [sizeClass, blocks] : freeLists)
+			{
+				for (void* p : blocks)
+				{
+					::operator delete(p, std::align_val_t{ CacheLineSize });
+				}
+			}
+		}
+
+	private:
+
+		/// @brief 保持するバッファの合計サイズの上限（バイト）
+		std::size_t m_maxCachedBytes = 0;
+
+		/// @brief 階級ごとの、再利用できるバッファの一覧
+		std::unordered_map<std::size_t, std::vector<void*>> m_freeLists;
+
+		/// @brief 統計情報
+		ImagePoolStats m_stats;
+
+		/// @brief 状態を保護するミューテックス
+		mutable std::mutex m_mutex;
+
+		void* do_allocate(const std::size_t bytes, const std::size_t alignment) override
+		{
+			// キャッシュラインより大きいアライメントは扱わない
+			if (CacheLineSize < alignment)
+			{
+				return ::operator new(bytes, std::align_val_t{ alignment });
+			}
+
+			const std::size_t sizeClass = GetSizeClass(bytes);
+			{
+				const std::lock_guard lock{ m_mutex };
+
+				if (auto it = m_freeLists.find(sizeClass); (it != m_freeLists.end()) && (!it->second.empty()))
+				{
+					void* p = it->second.back();
+					it->second.pop_back();
+					++m_stats.hits;
+					--m_stats.numCachedBuffers;
+					m_stats.cachedBytes -= sizeClass;
+					return p;
+				}
+
+				++m_stats.misses;
+			}
+
+			// ロックの外で確保する
+			return ::operator new(sizeClass, std::align_val_t{ CacheLineSize });
+		}
+
+		void do_deallocate(void* p, const std::size_t bytes, const std::size_t alignment) override
+		{
+			if (CacheLineSize < alignment)
+			{
+				::operator delete(p, std::align_val_t{ alignment });
+				return;
+			}
+
+			const std::size_t sizeClass = GetSizeClass(bytes);
+			{
+				const std::lock_guard lock{ m_mutex };
+
+				// 上限に収まる場合はプールに戻す
+				if ((m_stats.cachedBytes + sizeClass) <= m_maxCachedBytes)
+				{
+					m_freeLists[sizeClass].push_back(p);
+					++m_stats.numCachedBuffers;
+					m_stats.cachedBytes += sizeClass;
+					return;
+				}
+			}
+
+			::operator delete(p, std::align_val_t{ CacheLineSize });
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return (this == &other);
+		}
+	};
+
+	ImagePool::ImagePool()
+		: ImagePool{ DefaultMaxCachedBytes } {} // 移譲コンストラクタ
+
+	ImagePool::ImagePool(const std::size_t maxCachedBytes)
+		: m_pImpl{ std::make_shared<Impl>(maxCachedBytes) } {}
+
+	ImagePool::~ImagePool() = default;
+
+	ImagePoolStats ImagePool::stats() const
+	{
+		return m_pImpl->stats();
+	}
+
+	void ImagePool::resetStats()
+	{
+		m_pImpl->resetStats();
+	}
+
+	void ImagePool::clear()
+	{
+		m_pImpl->clear();
+	}
+
+	std::shared_ptr<std::pmr::memory_resource> ImagePool::resource() const noexcept
+	{
+		return m_pImpl;
+	}
+}
@@ -0,0 +1,80 @@
+﻿#pragma once
+#include <memory>			// std::shared_ptr
+#include <cstddef>			// std::size_t
+#include <cstdint>			// std::uint64_t
+#include <memory_resource>	// std::pmr::memory_resource
+
+namespace mini
+{
+	/// @brief `ImagePool` の統計情報
+	struct ImagePoolStats
+	{
+		/// @brief プールに残っていたバッファを再利用した回数
+		std::uint64_t hits = 0;
+
+		/// @brief プールに適切なバッファがなく、新しく確保した回数
+		std::uint64_t misses = 0;
+
+		/// @brief プールに保持しているバッファの数
+		std::size_t numCachedBuffers = 0;
+
+		/// @brief プールに保持しているバッファの合計サイズ（バイト）
+		std::size_t cachedBytes = 0;
+
+		/// @brief 再利用できた割合を返します。
+		/// @return 再利用できた割合（0.0 ～ 1.0）。一度も確保していない場合は 0.0
+		[[nodiscard]]
+		constexpr double hitRate() const noexcept
+		{
+			const std::uint64_t total = (hits + misses);
+			return (total ? (static_cast<double>(hits) / total) : 0.0);
+		}
+	};
+
+	/// @brief 画像のピクセルデータのバッファを再利用するプール
+	/// @remark バッファはサイズの階級（2 のべき乗を 4 分割した刻み）ごとに保持され、同じ階級の確保要求に再利用されます。
+	/// プールから作成した画像が破棄されると、そのバッファはプールに戻ります。
+	/// コピーしたプールは状態を共有します。プールを破棄しても、プールから作成した画像は引き続き有効です。
+	/// 複数のスレッドから同時に使用できます。
+	class ImagePool
+	{
+	public:
+
+		/// @brief デフォルトの、保持するバッファの合計サイズの上限（バイト）
+		static constexpr std::size_t DefaultMaxCachedBytes = (std::size_t{ 256 } << 20);
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		ImagePool();
+
+		/// @brief プールを作成します。
+		/// @param maxCachedBytes 保持するバッファの合計サイズの上限（バイト）。超える分は、戻されたときに解放します
+		[[nodiscard]]
+		explicit ImagePool(std::size_t maxCachedBytes);
+
+		/// @brief デストラクタ
+		~ImagePool();
+
+		/// @brief 統計情報を返します。
+		/// @return 統計情報
+		[[nodiscard]]
+		ImagePoolStats stats() const;
+
+		/// @brief ヒット・ミスの回数を 0 に戻します。
+		void resetStats();
+
+		/// @brief 保持しているバッファをすべて解放します。
+		void clear();
+
+		/// @brief プールからメモリを確保するメモリリソースを返します。
+		/// @return プールと状態を共有するメモリリソース
+		[[nodiscard]]
+		std::shared_ptr<std::pmr::memory_resource> resource() const noexcept;
+
+	private:
+
+		class Impl;
+
+		std::shared_ptr<Impl> m_pImpl;
+	};
+}
@@ -0,0 +1,342 @@
+﻿#pragma once
+#include <algorithm>	// std::min
+#include <cassert>		// assert
+#include <cstddef>		// std::size_t
+#include <span>			// std::span
+#include <type_traits>	// std::remove_const_t, std::is_const_v, std::is_same_v
+#include "Point.hpp"	// mini::Point
+#include "Rect.hpp"		// mini::Rect
+#include "ImageIterator.hpp"	// mini::ImageIterator
+#include "Parallel.hpp"	// mini::ExecutionPolicy, mini::ForEachBand, MINI_IVDEP
+
+namespace mini
+{
+	/// @brief 画像の一部または全体を参照するビュー。ピクセルデータを所有しません。
+	/// @tparam PixelType ピクセルの型（const 修飾した場合は読み取り専用のビュー）
+	/// @remark 参照先の画像が破棄されたり、作り直されたりすると無効になります。
+	template <class PixelType>
+	class BasicImageView
+	{
+	public:
+
+		/// @brief ピクセルの型
+		using value_type = std::remove_const_t<PixelType>;
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		BasicImageView() = default;
+
+		/// @brief ビューを作成します。
+		/// @param data 左上のピクセルへのポインタ
+		/// @param width 幅（ピクセル）
+		/// @param height 高さ（ピクセル）
+		/// @param stride 行の先頭から次の行の先頭までのピクセル数
+		[[nodiscard]]
+		BasicImageView(PixelType* data, int width, int height, int stride) noexcept
+		{
+			// サイズが不正な場合は空のビューを作成する
+			if ((data == nullptr) || (width <= 0) || (height <= 0) || (stride < width))
+			{
+				return;
+			}
+
+			m_data = data;
+			m_width = width;
+			m_height = height;
+			m_stride = stride;
+		}
+
+		/// @brief 書き込み可能なビューから、読み取り専用のビューを作成します。
+		/// @param other 書き込み可能なビュー
+		template <class Other> requires std::is_same_v<const Other, PixelType>
+		[[nodiscard]]
+		BasicImageView(const BasicImageView<Other>& other) noexcept
+			: BasicImageView{ other.data(), other.width(), other.height(), other.stride() } {} // 移譲コンストラクタ
+
+		/// @brief 幅（ピクセル）を返します。
+		/// @return 幅（ピクセル）
+		[[nodiscard]]
+		int width() const noexcept
+		{
+			return m_width;
+		}
+
+		/// @brief 高さ（ピクセル）を返します。
+		/// @return 高さ（ピクセル）
+		[[nodiscard]]
+		int height() const noexcept
+		{
+			return m_height;
+		}
+
+		/// @brief 行の先頭から次の行の先頭までのピクセル数を返します。
+		/// @return 行の先頭から次の行の先頭までのピクセル数
+		[[nodiscard]]
+		int stride() const noexcept
+		{
+			return m_stride;
+		}
+
+		/// @brief ピクセル数を返します。
+		/// @return ピクセル数
+		[[nodiscard]]
+		int numPixels() const noexcept
+		{
+			return (m_width * m_height);
+		}
+
+		/// @brief ビューが空であるかを返します。
+		/// @return ビューが空である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isEmpty() const noexcept
+		{
+			return (m_data == nullptr);
+		}
+
+		/// @brief ビューが空でないかを返します。
+		/// @return ビューが空でない場合 true, それ以外の場合は false
+		[[nodiscard]]
+		explicit operator bool() const noexcept
+		{
+			return !isEmpty();
+		}
+
+		/// @brief 左上のピクセルへのポインタを返します。
+		/// @return 左上のピクセルへのポインタ。y 行目の先頭は `data() + y * stride()`
+		[[nodiscard]]
+		PixelType* data() const noexcept
+		{
+			return m_data;
+		}
+
+		/// @brief 指定した位置がビューの範囲内であるかを返します。
+		/// @param y 行番号
+		/// @param x 列番号
+		/// @return 指定した位置がビューの範囲内である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool inBounds(int y, int x) const noexcept
+		{
+			return ((0 <= y) && (y < m_height) && (0 <= x) && (x < m_width));
+		}
+
+		/// @brief 指定した位置のピクセルの色を返します。範囲外の場合は黒を返します。
+		/// @param y 行番号
+		/// @param x 列番号
+		/// @return 指定した位置のピクセルの色
+		[[nodiscard]]
+		value_type getPixel(int y, int x) const noexcept
+		{
+			if (!inBounds(y, x))
+			{
+				return value_type{}; // 範囲外の場合は黒を返す
+			}
+
+			return m_data[offset(y) + x];
+		}
+
+		/// @brief 指定した位置のピクセルの色を設定します。範囲外の場合は何もしません。
+		/// @param y 行番号
+		/// @param x 列番号
+		/// @param color 設定する色
+		void setPixel(int y, int x, const value_type& color) const noexcept requires (!std::is_const_v<PixelType>)
+		{
+			if (!inBounds(y, x))
+			{
+				return; // 範囲外の場合は何もしない
+			}
+
+			m_data[offset(y) + x] = color;
+		}
+
+		/// @brief y 行目の先頭ピクセルへのポインタを返します。
+		/// @param y 行番号
+		/// @return y 行目の先頭ピクセルへのポインタ
+		[[nodiscard]]
+		PixelType* operator [](int y) const noexcept
+		{
+			assert((0 <= y) && (y < m_height));
+			return (m_data + offset(y));
+		}
+
+		/// @brief 指定した位置のピクセルの参照を返します。
+		/// @param p ピクセルの位置
+		/// @return 指定した位置のピクセルの参照
+		[[nodiscard]]
+		PixelType& operator [](const Point& p) const noexcept
+		{
+			assert(inBounds(p.y, p.x));
+			return m_data[offset(p.y) + p.x];
+		}
+
+		/// @brief イテレータの型（行の末尾のパディングは読み飛ばす）
+		using iterator = ImageIterator<PixelType>;
+
+		/// @brief 先頭イテレータを返します。
+		/// @return 先頭イテレータ
+		[[nodiscard]]
+		iterator begin() const noexcept
+		{
+			return{ m_data, m_width, m_stride };
+		}
+
+		/// @brief 終端イテレータを返します。
+		/// @return 終端イテレータ
+		[[nodiscard]]
+		iterator end() const noexcept
+		{
+			return{ (m_data + offset(m_height)), m_width, m_stride };
+		}
+
+		/// @brief 指定した行のビューを返します。
+		/// @param y 行番号
+		/// @return 指定した行のビュー
+		[[nodiscard]]
+		std::span<PixelType> row(int y) const noexcept
+		{
+			assert((0 <= y) && (y < m_height));
+			return std::span<PixelType>{ (m_data + offset(y)), static_cast<std::size_t>(m_width) };
+		}
+
+		/// @brief 指定した領域を参照するビューを返します。
+		/// @param topLeft 領域の左上の位置
+		/// @param size 領域の幅と高さ
+		/// @return 指定した領域を参照するビュー（ビューの範囲外の部分は除かれる）。重ならない場合は空のビュー
+		[[nodiscard]]
+		BasicImageView subView(const Point& topLeft, const Point& size) const noexcept
+		{
+			const Rect region = Rect{ topLeft, size }.intersection(Rect{ 0, 0, m_width, m_height });
+
+			if (region.isEmpty())
+			{
+				return{};
+			}
+
+			return{ (m_data + offset(region.y) + region.x), region.w, region.h, m_stride };
+		}
+
+		/// @brief 各ピクセルを、関数を適用した結果で置き換えます。
+		/// @tparam Function 関数の型
+		/// @param policy 処理の実行方法
+		/// @param function ピクセルの色を受け取り、新しい色を返す関数。並列に処理する場合は、複数のスレッドから同時に呼ばれます
+		template <class Function>
+		void transform(const ExecutionPolicy policy, Function&& function) const requires (!std::is_const_v<PixelType>)
+		{
+			ForEachBand(policy, m_height, [&](const int y0, const int y1)
+			{
+				for (int y = y0; y < y1; ++y)
+				{
+					PixelType* const pixels = (*this)[y];
+
+					if (policy == ExecutionPolicy::ParallelUnsequenced)
+					{
+						MINI_IVDEP
+						for (int x = 0; x < m_width; ++x)
+						{
+							pixels[x] = function(pixels[x]);
+						}
+					}
+					else
+					{
+						for (int x = 0; x < m_width; ++x)
+						{
+							pixels[x] = function(pixels[x]);
+						}
+					}
+				}
+			});
+		}
+
+		/// @brief 画像の式（`ImageExpression.hpp`）を評価して、各ピクセルに代入します。
+		/// @tparam Expression 式の型
+		/// @param expression 代入する式
+		/// @param policy 処理の実行方法
+		/// @remark 式の木全体をピクセルごとに 1 回のループで計算するため、途中の画像を作りません。
+		/// ビューと式の大きさが異なる場合は、左上をそろえたときに重なる部分だけに代入します。
+		/// 式がこのビュー自身を同じ位置で参照するのは構いませんが、ずらした位置で参照する場合の結果は不定です。
+		template <class Expression>
+		void assign(const Expression& expression, const ExecutionPolicy policy = ExecutionPolicy::Sequenced) const requires (!std::is_const_v<PixelType>)
+		{
+			const int width = std::min(m_width, expression.width());
+			const int height = std::min(m_height, expression.height());
+
+			ForEachBand(policy, height, [&](const int y0, const int y1)
+			{
+				for (int y = y0; y < y1; ++y)
+				{
+					PixelType* const pixels = (*this)[y];
+					const auto row = expression.row(y);
+
+					if (policy == ExecutionPolicy::ParallelUnsequenced)
+					{
+						MINI_IVDEP
+						for (int x = 0; x < width; ++x)
+						{
+							pixels[x] = row[x];
+						}
+					}
+					else
+					{
+						for (int x = 0; x < width; ++x)
+						{
+							pixels[x] = row[x];
+						}
+					}
+				}
+			});
+		}
+
+		/// @brief 各ピクセルについて、位置とピクセルの参照を渡して関数を呼び出します。
+		/// @tparam Function 関数の型
+		/// @param policy 処理の実行方法
+		/// @param function ピクセルの位置（`Point`）と参照を受け取る関数。並列に処理する場合は、複数のスレッドから同時に呼ばれます
+		/// @remark 位置は、除算を使わずに 1 ずつ進めて求めます。
+		template <class Function>
+		void forEachPixel(const ExecutionPolicy policy, Function&& function) const
+		{
+			ForEachBand(policy, m_height, [&](const int y0, const int y1)
+			{
+				for (int y = y0; y < y1; ++y)
+				{
+					PixelType* const pixels = (*this)[y];
+
+					if (policy == ExecutionPolicy::ParallelUnsequenced)
+					{
+						MINI_IVDEP
+						for (int x = 0; x < m_width; ++x)
+						{
+							function(Point{ x, y }, pixels[x]);
+						}
+					}
+					else
+					{
+						for (Point p{ 0, y }; p.x < m_width; ++p.x)
+						{
+							function(p, pixels[p.x]);
+						}
+					}
+				}
+			});
+		}
+
+	private:
+
+		/// @brief 左上のピクセルへのポインタ
+		PixelType* m_data = nullptr;
+
+		/// @brief 幅（ピクセル）
+		int m_width = 0;
+
+		/// @brief 高さ（ピクセル）
+		int m_height = 0;
+
+		/// @brief 行の先頭から次の行の先頭までのピクセル数
+		int m_stride = 0;
+
+		/// @brief y 行目の先頭の、左上のピクセルからの位置を返します。
+		[[nodiscard]]
+		std::size_t offset(int y) const noexcept
+		{
+			return (static_cast<std::size_t>(y) * m_stride);
+		}
+	};
+}
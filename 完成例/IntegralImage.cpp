@@ -0,0 +1,88 @@
+﻿#include <algorithm>	// std::max
+#include "IntegralImage.hpp"
+#include "PixelCast.hpp"	// mini::PixelCast
+
+namespace mini
+{
+	template <class PixelType>
+	IntegralImage::IntegralImage(const BasicImage<PixelType>& image)
+	{
+		if (image.isEmpty())
+		{
+			return;
+		}
+
+		m_width = image.width();
+		m_height = image.height();
+
+		const std::size_t stride = (static_cast<std::size_t>(m_width) + 1);
+		m_sums.assign((stride * (m_height + 1)), Color{ 0.0 });
+		m_squaredSums.assign((stride * (m_height + 1)), Color{ 0.0 });
+
+		for (int y = 0; y < m_height; ++y)
+		{
+			const PixelType* const src = image[y];
+			const Color* const sumsAbove = (m_sums.data() + y * stride);
+			const Color* const squaredSumsAbove = (m_squaredSums.data() + y * stride);
+			Color* const sums = (m_sums.data() + (y + 1) * stride);
+			Color* const squaredSums = (m_squaredSums.data() + (y + 1) * stride);
+
+			// 行内の累積和に、1 つ上の行の値を足す
+			Color rowSum{ 0.0 };
+			Color rowSquaredSum{ 0.0 };
+
+			for (int x = 0; x < m_width; ++x)
+			{
+				const Color c = PixelCast<Color>(src[x]);
+				rowSum = (rowSum + c);
+				rowSquaredSum = (rowSquaredSum + Color{ (c.r * c.r), (c.g * c.g), (c.b * c.b) });
+				sums[x + 1] = (sumsAbove[x + 1] + rowSum);
+				squaredSums[x + 1] = (squaredSumsAbove[x + 1] + rowSquaredSum);
+			}
+		}
+	}
+
+	Color IntegralImage::sum(const Rect& rect) const noexcept
+	{
+		const Rect r = clip(rect);
+
+		if (r.isEmpty())
+		{
+			return Color{ 0.0 };
+		}
+
+		return sumOf(m_sums, r);
+	}
+
+	Color IntegralImage::mean(const Rect& rect) const noexcept
+	{
+		const Rect r = clip(rect);
+
+		if (r.isEmpty())
+		{
+			return Color{ 0.0 };
+		}
+
+		return (sumOf(m_sums, r) / static_cast<double>(r.area()));
+	}
+
+	Color IntegralImage::variance(const Rect& rect) const noexcept
+	{
+		const Rect r = clip(rect);
+
+		if (r.isEmpty())
+		{
+			return Color{ 0.0 };
+		}
+
+		// 分散 = 二乗の平均 - 平均の二乗（丸め誤差で負にならないようにする）
+		const double n = static_cast<double>(r.area());
+		const Color m = (sumOf(m_sums, r) / n);
+		const Color m2 = (sumOf(m_squaredSums, r) / n);
+		return{ std::max((m2.r - m.r * m.r), 0.0), std::max((m2.g - m.g * m.g), 0.0), std::max((m2.b - m.b * m.b), 0.0) };
+	}
+
+	template IntegralImage::IntegralImage(const Image&);
+	template IntegralImage::IntegralImage(const ImageF&);
+	template IntegralImage::IntegralImage(const Image8&);
+}
@@ -0,0 +1,102 @@
+﻿#pragma once
+#include <cstddef>		// std::size_t
+#include <vector>		// std::vector
+#include "Color.hpp"	// mini::Color
+#include "Rect.hpp"		// mini::Rect
+#include "Image.hpp"	// mini::BasicImage
+
+namespace mini
+{
+	/// @brief 積分画像（Summed-area table）
+	/// @remark 各位置について、それより左上の範囲の、成分ごとの値の合計と二乗の合計を保持します。
+	/// 作成には画像全体を 1 回走査するだけで済み、任意の長方形の合計・平均・分散を、長方形の大きさによらず一定時間で求められます。
+	/// 値は `Color`（各成分 0.0 ～ 1.0）に変換し、double で累積します。
+	class IntegralImage
+	{
+	public:
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		IntegralImage() = default;
+
+		/// @brief 画像から積分画像を作成します。
+		/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+		/// @param image 元の画像
+		template <class PixelType>
+		[[nodiscard]]
+		explicit IntegralImage(const BasicImage<PixelType>& image);
+
+		/// @brief 元の画像の幅（ピクセル）を返します。
+		/// @return 元の画像の幅（ピクセル）
+		[[nodiscard]]
+		int width() const noexcept
+		{
+			return m_width;
+		}
+
+		/// @brief 元の画像の高さ（ピクセル）を返します。
+		/// @return 元の画像の高さ（ピクセル）
+		[[nodiscard]]
+		int height() const noexcept
+		{
+			return m_height;
+		}
+
+		/// @brief 積分画像が空であるかを返します。
+		/// @return 積分画像が空である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isEmpty() const noexcept
+		{
+			return m_sums.empty();
+		}
+
+		/// @brief 長方形の範囲のピクセルの合計を返します。
+		/// @param rect 範囲（画像の範囲外の部分は無視されます）
+		/// @return 成分ごとの合計
+		[[nodiscard]]
+		Color sum(const Rect& rect) const noexcept;
+
+		/// @brief 長方形の範囲のピクセルの平均を返します。
+		/// @param rect 範囲（画像の範囲外の部分は無視されます）
+		/// @return 成分ごとの平均。範囲が画像と重ならない場合は黒
+		[[nodiscard]]
+		Color mean(const Rect& rect) const noexcept;
+
+		/// @brief 長方形の範囲のピクセルの分散を返します。
+		/// @param rect 範囲（画像の範囲外の部分は無視されます）
+		/// @return 成分ごとの分散。範囲が画像と重ならない場合は 0
+		[[nodiscard]]
+		Color variance(const Rect& rect) const noexcept;
+
+	private:
+
+		/// @brief 合計（(width + 1) * (height + 1) 要素。先頭の行と列は 0）
+		std::vector<Color> m_sums;
+
+		/// @brief 二乗の合計（(width + 1) * (height + 1) 要素。先頭の行と列は 0）
+		std::vector<Color> m_squaredSums;
+
+		/// @brief 元の画像の幅（ピクセル）
+		int m_width = 0;
+
+		/// @brief 元の画像の高さ（ピクセル）
+		int m_height = 0;
+
+		/// @brief 範囲を画像の範囲に制限します。
+		[[nodiscard]]
+		Rect clip(const Rect& rect) const noexcept
+		{
+			return rect.intersection(Rect{ 0, 0, m_width, m_height });
+		}
+
+		/// @brief テーブルから、長方形の範囲の合計を求めます（範囲は画像の範囲内であること）。
+		[[nodiscard]]
+		Color sumOf(const std::vector<Color>& table, const Rect& rect) const noexcept
+		{
+			const std::size_t stride = (static_cast<std::size_t>(m_width) + 1);
+			const std::size_t top = (rect.y * stride);
+			const std::size_t bottom = (rect.bottom() * stride);
+			return ((table[bottom + rect.right()] - table[top + rect.right()]) - (table[bottom + rect.x] - table[top + rect.x]));
+		}
+	};
+}
@@ -0,0 +1,101 @@
+﻿#include <algorithm>	// std::max, std::copy
+#include <cmath>		// std::abs
+#include <numeric>		// std::accumulate
+#include <utility>		// std::move
+#include "Kernel.hpp"
+
+namespace mini
+{
+	Kernel::Kernel(const int width, const int height, const double value)
+	{
+		// サイズが不正な場合は空の行列を作成する
+		if ((width <= 0) || (height <= 0))
+		{
+			return;
+		}
+
+		m_width = width;
+		m_height = height;
+		m_values.assign((static_cast<std::size_t>(width) * height), value);
+	}
+
+	Kernel::Kernel(const std::initializer_list<std::initializer_list<double>> rows)
+	{
+		std::size_t width = 0;
+
+		for (const auto& row : rows)
+		{
+			width = std::max(width, row.size());
+		}
+
+		*this = Kernel{ static_cast<int>(width), static_cast<int>(rows.size()) };
+
+		int y = 0;
+
+		for (const auto& row : rows)
+		{
+			std::copy(row.begin(), row.end(), (*this)[y++]);
+		}
+	}
+
+	double Kernel::sum() const noexcept
+	{
+		return std::accumulate(m_values.begin(), m_values.end(), 0.0);
+	}
+
+	bool Kernel::separate(std::vector<double>& column, std::vector<double>& row, const double tolerance) const
+	{
+		if (isEmpty())
+		{
+			return false;
+		}
+
+		// 絶対値が最大の要素を通る列と行を基準にする
+		std::size_t pivot = 0;
+
+		for (std::size_t i = 1; i < m_values.size(); ++i)
+		{
+			if (std::abs(m_values[pivot]) < std::abs(m_values[i]))
+			{
+				pivot = i;
+			}
+		}
+
+		const double maxValue = std::abs(m_values[pivot]);
+
+		if (maxValue == 0.0)
+		{
+			return false;
+		}
+
+		const int pivotY = static_cast<int>(pivot / m_width);
+		const int pivotX = static_cast<int>(pivot % m_width);
+		std::vector<double> c(m_height), r(m_width);
+
+		for (int y = 0; y < m_height; ++y)
+		{
+			c[y] = (*this)[y][pivotX];
+		}
+
+		for (int x = 0; x < m_width; ++x)
+		{
+			r[x] = ((*this)[pivotY][x] / m_values[pivot]);
+		}
+
+		// すべての要素が、列と行の積と一致するかを確かめる
+		for (int y = 0; y < m_height; ++y)
+		{
+			for (int x = 0; x < m_width; ++x)
+			{
+				if ((maxValue * tolerance) < std::abs((*this)[y][x] - c[y] * r[x]))
+				{
+					return false;
+				}
+			}
+		}
+
+		column = std::move(c);
+		row = std::move(r);
+		return true;
+	}
+}
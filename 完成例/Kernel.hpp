@@ -0,0 +1,135 @@
+﻿#pragma once
+#include <cassert>		// assert
+#include <cstddef>		// std::size_t
+#include <initializer_list>	// std::initializer_list
+#include <span>			// std::span
+#include <vector>		// std::vector
+#include "Point.hpp"	// mini::Point
+
+namespace mini
+{
+	/// @brief 畳み込みに使う重みの行列
+	/// @remark 中心（`anchor()`）は (width / 2, height / 2) です。
+	class Kernel
+	{
+	public:
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		Kernel() = default;
+
+		/// @brief 指定したサイズの行列を作成します。
+		/// @param width 幅
+		/// @param height 高さ
+		/// @param value 各要素の初期値
+		[[nodiscard]]
+		Kernel(int width, int height, double value = 0.0);
+
+		/// @brief 行ごとの値から行列を作成します。
+		/// @param rows 各行の値（`{ { 1, 2, 1 }, { 2, 4, 2 }, { 1, 2, 1 } }` など）。短い行の残りは 0
+		[[nodiscard]]
+		Kernel(std::initializer_list<std::initializer_list<double>> rows);
+
+		/// @brief 2 次元配列から行列を作成します。サイズはコンパイル時に決まります。
+		/// @tparam Height 高さ
+		/// @tparam Width 幅
+		/// @param values 2 次元配列
+		template <std::size_t Height, std::size_t Width>
+		[[nodiscard]]
+		explicit Kernel(const double (&values)[Height][Width])
+			: Kernel{ static_cast<int>(Width), static_cast<int>(Height) } // 移譲コンストラクタ
+		{
+			for (std::size_t y = 0; y < Height; ++y)
+			{
+				for (std::size_t x = 0; x < Width; ++x)
+				{
+					m_values[y * Width + x] = values[y][x];
+				}
+			}
+		}
+
+		/// @brief 幅を返します。
+		/// @return 幅
+		[[nodiscard]]
+		int width() const noexcept
+		{
+			return m_width;
+		}
+
+		/// @brief 高さを返します。
+		/// @return 高さ
+		[[nodiscard]]
+		int height() const noexcept
+		{
+			return m_height;
+		}
+
+		/// @brief 中心の位置を返します。
+		/// @return 中心の位置 (width / 2, height / 2)
+		[[nodiscard]]
+		Point anchor() const noexcept
+		{
+			return{ (m_width / 2), (m_height / 2) };
+		}
+
+		/// @brief 行列が空であるかを返します。
+		/// @return 行列が空である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isEmpty() const noexcept
+		{
+			return m_values.empty();
+		}
+
+		/// @brief y 行目の先頭の要素へのポインタを返します。
+		/// @param y 行番号
+		/// @return y 行目の先頭の要素へのポインタ
+		[[nodiscard]]
+		double* operator [](int y) noexcept
+		{
+			assert((0 <= y) && (y < m_height));
+			return (m_values.data() + static_cast<std::size_t>(y) * m_width);
+		}
+
+		/// @brief y 行目の先頭の要素へのポインタを返します。
+		/// @param y 行番号
+		/// @return y 行目の先頭の要素へのポインタ
+		[[nodiscard]]
+		const double* operator [](int y) const noexcept
+		{
+			assert((0 <= y) && (y < m_height));
+			return (m_values.data() + static_cast<std::size_t>(y) * m_width);
+		}
+
+		/// @brief すべての要素を行優先で返します。
+		/// @return すべての要素
+		[[nodiscard]]
+		std::span<const double> values() const noexcept
+		{
+			return m_values;
+		}
+
+		/// @brief 要素の合計を返します。
+		/// @return 要素の合計
+		[[nodiscard]]
+		double sum() const noexcept;
+
+		/// @brief 行列を、列ベクトルと行ベクトルの積（ランク 1）に分解します。
+		/// @param column 列ベクトルの格納先（要素数は高さ）
+		/// @param row 行ベクトルの格納先（要素数は幅）
+		/// @param tolerance 分解の誤差の許容範囲（要素の絶対値の最大値に対する比）
+		/// @return 分解できた場合 true, それ以外の場合は false
+		/// @remark 分解できる行列は、水平方向と垂直方向の 1 次元の畳み込みに分けて計算できます。
+		bool separate(std::vector<double>& column, std::vector<double>& row, double tolerance = 1e-9) const;
+
+	private:
+
+		/// @brief 要素（行優先）
+		std::vector<double> m_values;
+
+		/// @brief 幅
+		int m_width = 0;
+
+		/// @brief 高さ
+		int m_height = 0;
+	};
+}
@@ -1,12 +1,70 @@
 ﻿#include <print>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <vector>
 #include "Point.hpp"
 #include "BinaryFileWriter.hpp"
 #include "BinaryFileReader.hpp"
 #include "Color.hpp"
 #include "Image.hpp"
+#include "Filter.hpp"
 
 using namespace mini;
 
+// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+namespace
+{
+	/// @brief 比較用の素朴なガウスぼかし（2 次元の重みを 1 タップずつ getPixel で読む）
+	Image NaiveGaussianBlur(const Image& image, const double sigma)
+	{
+		const int radius = std::max(1, static_cast<int>(std::ceil(3.0 * sigma)));
+		const int size = (2 * radius + 1);
+		std::vector<double> kernel(size * size);
+		double weightSum = 0.0;
+
+		for (int ky = -radius; ky <= radius; ++ky)
+		{
+			for (int kx = -radius; kx <= radius; ++kx)
+			{
+				kernel[(ky + radius) * size + (kx + radius)] = std::exp(-(kx * kx + ky * ky) / (2.0 * sigma * sigma));
+				weightSum += kernel[(ky + radius) * size + (kx + radius)];
+			}
+		}
+
+		Image result(image.width(), image.height());
+
+		for (int y = 0; y < image.height(); ++y)
+		{
+			for (int x = 0; x < image.width(); ++x)
+			{
+				Color sum{ 0.0 };
+
+				for (int ky = -radius; ky <= radius; ++ky)
+				{
+					for (int kx = -radius; kx <= radius; ++kx)
+					{
+						sum = (sum + image.getPixel((y + ky), (x + kx)) * kernel[(ky + radius) * size + (kx + radius)]); // 範囲外は黒
+					}
+				}
+
+				result[y][x] = (sum / weightSum);
+			}
+		}
+
+		return result;
+	}
+
+	/// @brief 関数の実行時間（ミリ秒）を測ります。
+	template <class Function>
+	double MeasureMilliseconds(Function&& function)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		function();
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
 int main()
 {
 	std::println("こんにちは、セキュリティキャンプ！\n");
@@ -115,4 +173,27 @@ int main()
 		// input.bmp を output.bmp として保存するだけ
 		//Image{ "input.bmp" }.save("output.bmp");
 	}
+
+	std::println("---- Filter.hpp ----");
+	{
+		const Image image{ "test2.bmp" };
+		const double sigma = 3.0;
+		Image naive, blurred;
+
+		const double naiveTime = MeasureMilliseconds([&]() { naive = NaiveGaussianBlur(image, sigma); });
+		const double fastTime = MeasureMilliseconds([&]() { blurred = GaussianBlur(image, sigma, BorderMode::Zero); });
+
+		double maxError = 0.0;
+
+		for (int y = 0; y < image.height(); ++y)
+		{
+			for (int x = 0; x < image.width(); ++x)
+			{
+				maxError = std::max({ maxError, std::abs(naive[y][x].r - blurred[y][x].r),
+					std::abs(naive[y][x].g - blurred[y][x].g), std::abs(naive[y][x].b - blurred[y][x].b) });
+			}
+		}
+
+		std::println("GaussianBlur (sigma = {}): 素朴な実装 {:.1f} ms, GaussianBlur {:.1f} ms（誤差 {:.2e}）", sigma, naiveTime, fastTime, maxError);
+	}
 }
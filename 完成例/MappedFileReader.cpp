@@ -0,0 +1,282 @@
+﻿#include <filesystem>	// std::filesystem::absolute
+#include "MappedFileReader.hpp"
+
+#if defined(_WIN32)
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <Windows.h>
+#else
+	#include <fcntl.h>		// ::open
+	#include <unistd.h>		// ::close
+	#include <sys/mman.h>	// ::mmap, ::munmap, ::madvise
+	#include <sys/stat.h>	// ::fstat
+#endif
+
+namespace mini
+{
+	class MappedFileReader::Impl
+	{
+	public:
+
+		Impl() = default;
+
+		~Impl()
+		{
+			close();
+		}
+
+		[[nodiscard]]
+		bool isOpen() const noexcept
+		{
+			return m_isOpen;
+		}
+
+		bool open(const std::string_view path)
+		{
+			// すでにオープンされている場合はクローズする
+			if (m_isOpen)
+			{
+				close();
+			}
+
+			const std::filesystem::path filePath{ path };
+
+			// ファイルをオープンしてメモリにマップする。失敗した場合は false を返す
+			if (!map(filePath))
+			{
+				unmap();
+				return false;
+			}
+
+			// ファイルの絶対パスを取得して記録する
+			m_fullPath = std::filesystem::absolute(filePath).string();
+			m_isOpen = true;
+
+			return true;
+		}
+
+		void close()
+		{
+			unmap();
+
+			// 記録していたファイルの絶対パスをクリアする
+			m_fullPath.clear();
+			m_isOpen = false;
+		}
+
+		[[nodiscard]]
+		std::int64_t size() const noexcept
+		{
+			return m_size;
+		}
+
+		[[nodiscard]]
+		std::span<const std::byte> data() const noexcept
+		{
+			return{ m_data, static_cast<std::size_t>(m_size) };
+		}
+
+		[[nodiscard]]
+		const std::string& fullPath() const noexcept
+		{
+			return m_fullPath;
+		}
+
+	private:
+
+		/// @brief マップされたファイルの先頭
+		const std::byte* m_data = nullptr;
+
+		/// @brief ファイルのサイズ（バイト）
+		std::int64_t m_size = 0;
+
+		/// @brief ファイルの絶対パス
+		std::string m_fullPath;
+
+		/// @brief ファイルがオープンされているか
+		bool m_isOpen = false;
+
+	#if defined(_WIN32)
+
+		/// @brief ファイルのハンドル
+		HANDLE m_file = INVALID_HANDLE_VALUE;
+
+		/// @brief ファイルマッピングオブジェクトのハンドル
+		HANDLE m_mapping = nullptr;
+
+		[[nodiscard]]
+		bool map(const std::filesystem::path& path)
+		{
+			m_file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+				OPEN_EXISTING, (FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN), nullptr);
+
+			if (m_file == INVALID_HANDLE_VALUE)
+			{
+				return false;
+			}
+
+			LARGE_INTEGER fileSize;
+
+			if (!::GetFileSizeEx(m_file, &fileSize))
+			{
+				return false;
+			}
+
+			m_size = fileSize.QuadPart;
+
+			// 空のファイルはマップできないので、空のビューのまま成功とする
+			if (m_size == 0)
+			{
+				return true;
+			}
+
+			m_mapping = ::CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+			if (m_mapping == nullptr)
+			{
+				return false;
+			}
+
+			m_data = static_cast<const std::byte*>(::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+
+			return (m_data != nullptr);
+		}
+
+		void unmap() noexcept
+		{
+			if (m_data)
+			{
+				::UnmapViewOfFile(m_data);
+				m_data = nullptr;
+			}
+
+			if (m_mapping)
+			{
+				::CloseHandle(m_mapping);
+				m_mapping = nullptr;
+			}
+
+			if (m_file != INVALID_HANDLE_VALUE)
+			{
+				::CloseHandle(m_file);
+				m_file = INVALID_HANDLE_VALUE;
+			}
+
+			m_size = 0;
+		}
+
+	#else
+
+		/// @brief ファイルディスクリプタ
+		int m_fd = -1;
+
+		[[nodiscard]]
+		bool map(const std::filesystem::path& path)
+		{
+			m_fd = ::open(path.c_str(), O_RDONLY);
+
+			if (m_fd == -1)
+			{
+				return false;
+			}
+
+			struct stat st;
+
+			if (::fstat(m_fd, &st) != 0)
+			{
+				return false;
+			}
+
+			m_size = st.st_size;
+
+			// 空のファイルはマップできないので、空のビューのまま成功とする
+			if (m_size == 0)
+			{
+				return true;
+			}
+
+			void* p = ::mmap(nullptr, static_cast<std::size_t>(m_size), PROT_READ, MAP_PRIVATE, m_fd, 0);
+
+			if (p == MAP_FAILED)
+			{
+				return false;
+			}
+
+			// 先頭から順に読まれることを OS に伝えて、先読みを促す
+			::madvise(p, static_cast<std::size_t>(m_size), MADV_SEQUENTIAL);
+
+			m_data = static_cast<const std::byte*>(p);
+
+			return true;
+		}
+
+		void unmap() noexcept
+		{
+			if (m_data)
+			{
+				::munmap(const_cast<std::byte*>(m_data), static_cast<std::size_t>(m_size));
+				m_data = nullptr;
+			}
+
+			if (m_fd != -1)
+			{
+				::close(m_fd);
+				m_fd = -1;
+			}
+
+			m_size = 0;
+		}
+
+	#endif
+	};
+
+	MappedFileReader::MappedFileReader()
+		: m_pImpl{ std::make_shared<Impl>() } {}
+
+	MappedFileReader::MappedFileReader(const std::string_view path)
+		: MappedFileReader{} // 移譲コンストラクタ
+	{
+		m_pImpl->open(path);
+	}
+
+	MappedFileReader::~MappedFileReader() = default;
+
+	bool MappedFileReader::isOpen() const noexcept
+	{
+		return m_pImpl->isOpen();
+	}
+
+	MappedFileReader::operator bool() const noexcept
+	{
+		return m_pImpl->isOpen();
+	}
+
+	bool MappedFileReader::open(const std::string_view path)
+	{
+		return m_pImpl->open(path);
+	}
+
+	void MappedFileReader::close()
+	{
+		m_pImpl->close();
+	}
+
+	std::int64_t MappedFileReader::size() const noexcept
+	{
+		return m_pImpl->size();
+	}
+
+	std::span<const std::byte> MappedFileReader::data() const noexcept
+	{
+		return m_pImpl->data();
+	}
+
+	const std::string& MappedFileReader::fullPath() const noexcept
+	{
+		return m_pImpl->fullPath();
+	}
+}
@@ -0,0 +1,69 @@
+﻿#pragma once
+#include <memory>		// std::shared_ptr
+#include <cstdint>		// std::int64_t
+#include <cstddef>		// std::byte
+#include <span>			// std::span
+#include <string_view>	// std::string_view
+#include <string>		// std::string
+
+namespace mini
+{
+	/// @brief ファイルをメモリにマップして読み込むクラス
+	/// @remark ファイルの内容はコピーされず、`data()` が返すビューから直接参照できます。
+	class MappedFileReader
+	{
+	public:
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		MappedFileReader();
+
+		/// @brief ファイルをオープンしてメモリにマップします。
+		/// @param path ファイルパス
+		[[nodiscard]]
+		explicit MappedFileReader(std::string_view path);
+
+		/// @brief デストラクタ
+		~MappedFileReader();
+
+		/// @brief ファイルがオープンされているかを返します。
+		/// @return オープンされている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		/// @brief ファイルがオープンされているかを返します。
+		/// @return オープンされている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief ファイルをオープンしてメモリにマップします。すでにオープンされている場合はクローズしてから再オープンします。
+		/// @param path ファイルパス
+		/// @return オープンに成功した場合 true, それ以外の場合は false
+		bool open(std::string_view path);
+
+		/// @brief マップを解除してファイルをクローズします。
+		void close();
+
+		/// @brief ファイルのサイズ（バイト）を返します。
+		/// @return ファイルのサイズ（バイト）。ファイルがオープンされていない場合は 0
+		[[nodiscard]]
+		std::int64_t size() const noexcept;
+
+		/// @brief マップされたファイルの内容を返します。
+		/// @return ファイルの内容のビュー。ファイルがオープンされていない場合は空のビュー
+		/// @remark ビューはクローズするまで有効です。
+		[[nodiscard]]
+		std::span<const std::byte> data() const noexcept;
+
+		/// @brief ファイルの絶対パスを返します。
+		/// @return ファイルの絶対パス。ファイルがオープンされていない場合は空文字列
+		[[nodiscard]]
+		const std::string& fullPath() const noexcept;
+
+	private:
+
+		class Impl;
+
+		std::shared_ptr<Impl> m_pImpl;
+	};
+}
@@ -0,0 +1,100 @@
+﻿#pragma once
+#include <algorithm>	// std::min, std::max
+#include "ThreadPool.hpp"	// mini::ThreadPool, mini::GetDefaultThreadPool
+
+// 直後のループの反復間に依存関係がないことをコンパイラに伝え、ベクトル化を促す
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define MINI_IVDEP __pragma(loop(ivdep))
+#elif defined(__clang__)
+	#define MINI_IVDEP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+	#define MINI_IVDEP _Pragma("GCC ivdep")
+#else
+	#define MINI_IVDEP
+#endif
+
+namespace mini
+{
+	/// @brief 処理の実行方法
+	enum class ExecutionPolicy
+	{
+		/// @brief 呼び出し元のスレッドで、順番に処理する
+		Sequenced,
+
+		/// @brief 行の帯に分割し、複数のスレッドで並列に処理する
+		Parallel,
+
+		/// @brief 行の帯に分割し、複数のスレッドで並列に処理する。各行の中の処理の順序も問わない（ベクトル化を許可する）
+		ParallelUnsequenced,
+	};
+
+	/// @brief 並列処理の設定
+	struct ParallelOptions
+	{
+		/// @brief 分割する帯の最大数。0 の場合は共有のスレッドプールの同時実行数
+		int numThreads = 0;
+
+		/// @brief 1 つのスレッドに割り当てる最小の行数
+		int minRowsPerBand = 16;
+	};
+
+	/// @brief 行の範囲 [0, numRows) を複数の帯に分割し、各帯を共有のスレッドプールで並列に処理します。
+	/// @tparam Function 帯を処理する関数の型
+	/// @param numRows 行数
+	/// @param options 並列処理の設定
+	/// @param function 帯を処理する関数。帯の先頭の行番号と終端の行番号（含まない）を受け取ります
+	/// @remark 呼び出し元のスレッドも処理に加わります。すべての帯の処理が終わるまで戻りません。
+	template <class Function>
+	void ParallelForBands(const int numRows, const ParallelOptions& options, Function&& function)
+	{
+		if (numRows <= 0)
+		{
+			return;
+		}
+
+		ThreadPool pool = GetDefaultThreadPool();
+		const int numThreads = ((0 < options.numThreads) ? options.numThreads : pool.concurrency());
+		const int minRowsPerBand = std::max(options.minRowsPerBand, 1);
+		const int numBands = std::min(numThreads, ((numRows + minRowsPerBand - 1) / minRowsPerBand));
+
+		// 分割しない場合は、そのまま呼び出し元のスレッドで処理する
+		if (numBands <= 1)
+		{
+			function(0, numRows);
+			return;
+		}
+
+		// 帯 i は [numRows * i / numBands, numRows * (i + 1) / numBands) を担当する
+		const auto bandBegin = [=](const int i) { return static_cast<int>(static_cast<long long>(numRows) * i / numBands); };
+
+		pool.parallelFor(0, numBands, [&](const int b0, const int b1)
+		{
+			for (int i = b0; i < b1; ++i)
+			{
+				function(bandBegin(i), bandBegin(i + 1));
+			}
+		});
+	}
+
+	/// @brief 行の範囲 [0, numRows) を、指定した実行方法で処理します。
+	/// @tparam Function 帯を処理する関数の型
+	/// @param policy 処理の実行方法。`ExecutionPolicy::Sequenced` の場合は、全体を 1 つの帯として呼び出し元のスレッドで処理します
+	/// @param numRows 行数
+	/// @param function 帯を処理する関数。帯の先頭の行番号と終端の行番号（含まない）を受け取ります
+	template <class Function>
+	void ForEachBand(const ExecutionPolicy policy, const int numRows, Function&& function)
+	{
+		if (numRows <= 0)
+		{
+			return;
+		}
+
+		if (policy == ExecutionPolicy::Sequenced)
+		{
+			function(0, numRows);
+			return;
+		}
+
+		ParallelForBands(numRows, ParallelOptions{}, function);
+	}
+}
@@ -0,0 +1,47 @@
+﻿#pragma once
+#include <algorithm>	// std::clamp
+#include <cmath>		// std::lround
+#include <cstdint>		// std::uint8_t
+#include <type_traits>	// std::conditional_t, std::is_same_v
+#include "Color.hpp"	// mini::Color
+#include "ColorF.hpp"	// mini::ColorF
+#include "Color8.hpp"	// mini::Color8
+
+namespace mini
+{
+	/// @brief フィルタの計算で、ピクセルの各成分を累積する数値の型（`Color` は double, それ以外は float）
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	template <class PixelType>
+	using AccumulatorType = std::conditional_t<std::is_same_v<PixelType, Color>, double, float>;
+
+	/// @brief ピクセルの各成分を、赤、緑、青の順に数値の配列に書き込みます。
+	/// @param pixel ピクセル
+	/// @param dst 書き込み先（3 要素）
+	/// @remark `Color8` の成分は 0 ～ 255 のまま書き込みます。
+	/// 行全体をこの形式の配列にしてから積和を計算すると、成分の並びや型によらずベクトル化しやすいループになります。
+	template <class PixelType, class Type>
+	void ToChannels(const PixelType& pixel, Type* dst) noexcept
+	{
+		dst[0] = static_cast<Type>(pixel.r);
+		dst[1] = static_cast<Type>(pixel.g);
+		dst[2] = static_cast<Type>(pixel.b);
+	}
+
+	/// @brief 赤、緑、青の順に並んだ数値から、ピクセルを作成します。
+	/// @param src 数値の配列（3 要素）
+	/// @return ピクセル。`Color8` の場合は、各成分を四捨五入して 0 ～ 255 の範囲に丸めます
+	template <class PixelType, class Type>
+	[[nodiscard]]
+	PixelType FromChannels(const Type* src) noexcept
+	{
+		if constexpr (std::is_same_v<PixelType, Color8>)
+		{
+			const auto toUint8 = [](const Type v) { return static_cast<std::uint8_t>(std::clamp<long>(std::lround(v), 0, 255)); };
+			return{ toUint8(src[0]), toUint8(src[1]), toUint8(src[2]) };
+		}
+		else
+		{
+			return{ src[0], src[1], src[2] };
+		}
+	}
+}
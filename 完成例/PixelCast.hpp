@@ -0,0 +1,40 @@
+﻿#pragma once
+#include <type_traits>	// std::is_same_v
+#include "Color.hpp"	// mini::Color
+#include "ColorF.hpp"	// mini::ColorF
+#include "Color8.hpp"	// mini::Color8
+#include "ColorA8.hpp"	// mini::ColorA8
+
+namespace mini
+{
+	/// @brief 色を別の形式の色に変換します。
+	/// @tparam To 変換先の色の型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @tparam From 変換元の色の型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param from 変換元の色
+	/// @return 変換した色
+	template <class To, class From>
+	[[nodiscard]]
+	constexpr To PixelCast(const From& from) noexcept
+	{
+		if constexpr (std::is_same_v<To, From>)
+		{
+			return from;
+		}
+		else if constexpr (std::is_same_v<To, Color>)
+		{
+			return from.toColor();
+		}
+		else if constexpr (std::is_same_v<To, ColorF> && (std::is_same_v<From, Color8> || std::is_same_v<From, ColorA8>))
+		{
+			return from.toColorF();
+		}
+		else if constexpr (std::is_same_v<To, Color8> && std::is_same_v<From, ColorA8>)
+		{
+			return from.toColor8();
+		}
+		else
+		{
+			return To{ from };
+		}
+	}
+}
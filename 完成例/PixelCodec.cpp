@@ -0,0 +1,413 @@
+﻿#include <algorithm>		// std::clamp
+#include <cassert>			// assert
+#include <cstdint>			// std::uint8_t
+#include <cstring>			// std::memcpy
+#include "PixelCodec.hpp"
+#include "CPUFeatures.hpp"	// mini::GetCPUFeatures, MINI_TARGET
+
+#if MINI_ARCH_X86
+	#include <immintrin.h>
+#endif
+
+namespace mini
+{
+	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+	namespace
+	{
+		/// @brief 1 ピクセルを 0.0 ～ 1.0 の範囲の実数に変換します。
+		void DecodePixel(const std::byte* src, Color& dst) noexcept
+		{
+			const std::uint8_t b = std::to_integer<std::uint8_t>(src[0]); // 青
+			const std::uint8_t g = std::to_integer<std::uint8_t>(src[1]); // 緑
+			const std::uint8_t r = std::to_integer<std::uint8_t>(src[2]); // 赤
+
+			// 各色成分を、0.0 ～ 1.0 の範囲の実数に変換する
+			dst = Color{ (r / 255.0), (g / 255.0), (b / 255.0) };
+		}
+
+		/// @brief 1 ピクセルを 8 ビット整数（0 ～ 255）に変換します。
+		void EncodePixel(const Color& color, std::byte* dst) noexcept
+		{
+			// 各色成分を、保存のため 8 ビット整数（0 ～ 255）に変換する
+			const std::uint8_t r = static_cast<std::uint8_t>(std::clamp((color.r * 255.0 + 0.5), 0.0, 255.0));
+			const std::uint8_t g = static_cast<std::uint8_t>(std::clamp((color.g * 255.0 + 0.5), 0.0, 255.0));
+			const std::uint8_t b = static_cast<std::uint8_t>(std::clamp((color.b * 255.0 + 0.5), 0.0, 255.0));
+
+			dst[0] = std::byte{ b }; // 青
+			dst[1] = std::byte{ g }; // 緑
+			dst[2] = std::byte{ r }; // 赤
+		}
+
+		void DecodeScalar(const std::span<const std::byte> src, const std::span<Color> dst, std::size_t x) noexcept
+		{
+			for (; x < dst.size(); ++x)
+			{
+				DecodePixel(&src[x * 3], dst[x]);
+			}
+		}
+
+		void EncodeScalar(const std::span<const Color> src, const std::span<std::byte> dst, std::size_t x) noexcept
+		{
+			for (; x < src.size(); ++x)
+			{
+				EncodePixel(src[x], &dst[x * 3]);
+			}
+		}
+
+	#if MINI_ARCH_X86
+
+		// SIMD 版の変換は、4 ピクセル（12 バイト、12 成分）を単位とする。
+		// 16 バイト単位で読み書きするため、それが配列の範囲に収まる間だけ SIMD で処理し、残りはスカラーで処理する。
+
+		/// @brief 12 バイトの BGR と RGB の並びを入れ替えるシャッフル（後ろの 4 バイトは 0 にする）
+		MINI_TARGET("sse4.1")
+		inline __m128i SwapRB() noexcept
+		{
+			return _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, -1, -1, -1, -1);
+		}
+
+		/// @brief 4 ピクセル分の BGR を読み込み、RGB の順の 32 ビット整数 12 個（4 個ずつ 3 つ）に展開します。
+		MINI_TARGET("sse4.1")
+		inline void Load4(const std::byte* src, __m128i& i0, __m128i& i1, __m128i& i2) noexcept
+		{
+			const __m128i rgb = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), SwapRB());
+			i0 = _mm_cvtepu8_epi32(rgb);
+			i1 = _mm_cvtepu8_epi32(_mm_srli_si128(rgb, 4));
+			i2 = _mm_cvtepu8_epi32(_mm_srli_si128(rgb, 8));
+		}
+
+		/// @brief RGB の順の 32 ビット整数 12 個（0 ～ 255）を、4 ピクセル分の BGR として書き出します。
+		MINI_TARGET("sse4.1")
+		inline void Store4(std::byte* dst, const __m128i i0, const __m128i i1, const __m128i i2) noexcept
+		{
+			const __m128i u16a = _mm_packus_epi32(i0, i1);
+			const __m128i u16b = _mm_packus_epi32(i2, _mm_setzero_si128());
+			const __m128i bgr = _mm_shuffle_epi8(_mm_packus_epi16(u16a, u16b), SwapRB());
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), bgr);
+		}
+
+		MINI_TARGET("sse4.1")
+		void DecodeSSE41(const std::span<const std::byte> src, const std::span<Color> dst) noexcept
+		{
+			const __m128d scale = _mm_set1_pd(255.0);
+			double* out = reinterpret_cast<double*>(dst.data());
+			std::size_t x = 0;
+
+			for (; ((x + 4) <= dst.size()) && ((x * 3 + 16) <= src.size()); x += 4)
+			{
+				__m128i i[3];
+				Load4(&src[x * 3], i[0], i[1], i[2]);
+
+				for (int k = 0; k < 3; ++k)
+				{
+					_mm_storeu_pd((out + x * 3 + k * 4 + 0), _mm_div_pd(_mm_cvtepi32_pd(i[k]), scale));
+					_mm_storeu_pd((out + x * 3 + k * 4 + 2), _mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(i[k], 8)), scale));
+				}
+			}
+
+			DecodeScalar(src, dst, x);
+		}
+
+		MINI_TARGET("sse4.1")
+		void EncodeSSE41(const std::span<const Color> src, const std::span<std::byte> dst) noexcept
+		{
+			const __m128d scale = _mm_set1_pd(255.0);
+			const __m128d half = _mm_set1_pd(0.5);
+			const __m128d zero = _mm_setzero_pd();
+			const double* in = reinterpret_cast<const double*>(src.data());
+			std::size_t x = 0;
+
+			for (; ((x + 4) <= src.size()) && ((x * 3 + 16) <= dst.size()); x += 4)
+			{
+				__m128i i[3];
+
+				for (int k = 0; k < 3; ++k)
+				{
+					__m128d lo = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(in + x * 3 + k * 4 + 0), scale), half);
+					__m128d hi = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(in + x * 3 + k * 4 + 2), scale), half);
+					lo = _mm_min_pd(_mm_max_pd(lo, zero), scale);
+					hi = _mm_min_pd(_mm_max_pd(hi, zero), scale);
+					i[k] = _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+				}
+
+				Store4(&dst[x * 3], i[0], i[1], i[2]);
+			}
+
+			EncodeScalar(src, dst, x);
+		}
+
+		MINI_TARGET("avx2")
+		void DecodeAVX2(const std::span<const std::byte> src, const std::span<Color> dst) noexcept
+		{
+			const __m256d scale = _mm256_set1_pd(255.0);
+			double* out = reinterpret_cast<double*>(dst.data());
+			std::size_t x = 0;
+
+			for (; ((x + 4) <= dst.size()) && ((x * 3 + 16) <= src.size()); x += 4)
+			{
+				__m128i i[3];
+				Load4(&src[x * 3], i[0], i[1], i[2]);
+
+				for (int k = 0; k < 3; ++k)
+				{
+					_mm256_storeu_pd((out + x * 3 + k * 4), _mm256_div_pd(_mm256_cvtepi32_pd(i[k]), scale));
+				}
+			}
+
+			DecodeScalar(src, dst, x);
+		}
+
+		MINI_TARGET("avx2")
+		void EncodeAVX2(const std::span<const Color> src, const std::span<std::byte> dst) noexcept
+		{
+			const __m256d scale = _mm256_set1_pd(255.0);
+			const __m256d half = _mm256_set1_pd(0.5);
+			const __m256d zero = _mm256_setzero_pd();
+			const double* in = reinterpret_cast<const double*>(src.data());
+			std::size_t x = 0;
+
+			for (; ((x + 4) <= src.size()) && ((x * 3 + 16) <= dst.size()); x += 4)
+			{
+				__m128i i[3];
+
+				for (int k = 0; k < 3; ++k)
+				{
+					__m256d v = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(in + x * 3 + k * 4), scale), half);
+					v = _mm256_min_pd(_mm256_max_pd(v, zero), scale);
+					i[k] = _mm256_cvttpd_epi32(v);
+				}
+
+				Store4(&dst[x * 3], i[0], i[1], i[2]);
+			}
+
+			EncodeScalar(src, dst, x);
+		}
+
+		MINI_TARGET("avx512f")
+		void DecodeAVX512(const std::span<const std::byte> src, const std::span<Color> dst) noexcept
+		{
+			const __m512d scale = _mm512_set1_pd(255.0);
+			double* out = reinterpret_cast<double*>(dst.data());
+			std::size_t x = 0;
+
+			// 8 ピクセル（24 成分）ずつ処理する
+			for (; ((x + 8) <= dst.size()) && ((x * 3 + 28) <= src.size()); x += 8)
+			{
+				__m128i i[6];
+				Load4(&src[x * 3], i[0], i[1], i[2]);
+				Load4(&src[x * 3 + 12], i[3], i[4], i[5]);
+
+				for (int k = 0; k < 3; ++k)
+				{
+					const __m256i i8 = _mm256_inserti128_si256(_mm256_castsi128_si256(i[k * 2]), i[k * 2 + 1], 1);
+					_mm512_storeu_pd((out + x * 3 + k * 8), _mm512_div_pd(_mm512_cvtepi32_pd(i8), scale));
+				}
+			}
+
+			DecodeAVX2(src.subspan(x * 3), dst.subspan(x));
+		}
+
+		MINI_TARGET("avx512f")
+		void EncodeAVX512(const std::span<const Color> src, const std::span<std::byte> dst) noexcept
+		{
+			const __m512d scale = _mm512_set1_pd(255.0);
+			const __m512d half = _mm512_set1_pd(0.5);
+			const __m512d zero = _mm512_setzero_pd();
+			const double* in = reinterpret_cast<const double*>(src.data());
+			std::size_t x = 0;
+
+			// 8 ピクセル（24 成分）ずつ処理する
+			for (; ((x + 8) <= src.size()) && ((x * 3 + 28) <= dst.size()); x += 8)
+			{
+				__m128i i[6];
+
+				for (int k = 0; k < 3; ++k)
+				{
+					__m512d v = _mm512_add_pd(_mm512_mul_pd(_mm512_loadu_pd(in + x * 3 + k * 8), scale), half);
+					v = _mm512_min_pd(_mm512_max_pd(v, zero), scale);
+					const __m256i i8 = _mm512_cvttpd_epi32(v);
+					i[k * 2] = _mm256_castsi256_si128(i8);
+					i[k * 2 + 1] = _mm256_extracti128_si256(i8, 1);
+				}
+
+				Store4(&dst[x * 3], i[0], i[1], i[2]);
+				Store4(&dst[x * 3 + 12], i[3], i[4], i[5]);
+			}
+
+			EncodeAVX2(src.subspan(x), dst.subspan(x * 3));
+		}
+
+	#endif
+
+		void DecodeDefault(const std::span<const std::byte> src, const std::span<Color> dst) noexcept
+		{
+			DecodeScalar(src, dst, 0);
+		}
+
+		void EncodeDefault(const std::span<const Color> src, const std::span<std::byte> dst) noexcept
+		{
+			EncodeScalar(src, dst, 0);
+		}
+
+		using DecodeFunction = void(*)(std::span<const std::byte>, std::span<Color>) noexcept;
+
+		using EncodeFunction = void(*)(std::span<const Color>, std::span<std::byte>) noexcept;
+
+		/// @brief 実行中の CPU で使える最速の変換関数を選びます。
+		[[nodiscard]]
+		DecodeFunction SelectDecode() noexcept
+		{
+		#if MINI_ARCH_X86
+			const CPUFeatures& features = GetCPUFeatures();
+
+			if (features.avx512f)
+			{
+				return DecodeAVX512;
+			}
+			else if (features.avx2)
+			{
+				return DecodeAVX2;
+			}
+			else if (features.sse41)
+			{
+				return DecodeSSE41;
+			}
+		#endif
+			return DecodeDefault;
+		}
+
+		/// @brief 実行中の CPU で使える最速の変換関数を選びます。
+		[[nodiscard]]
+		EncodeFunction SelectEncode() noexcept
+		{
+		#if MINI_ARCH_X86
+			const CPUFeatures& features = GetCPUFeatures();
+
+			if (features.avx512f)
+			{
+				return EncodeAVX512;
+			}
+			else if (features.avx2)
+			{
+				return EncodeAVX2;
+			}
+			else if (features.sse41)
+			{
+				return EncodeSSE41;
+			}
+		#endif
+			return EncodeDefault;
+		}
+	}
+
+	void DecodeBGR24Row(const std::span<const std::byte> src, const std::span<Color> dst) noexcept
+	{
+		assert((dst.size() * 3) <= src.size());
+
+		static const DecodeFunction decode = SelectDecode();
+		decode(src, dst);
+	}
+
+	void EncodeBGR24Row(const std::span<const Color> src, const std::span<std::byte> dst) noexcept
+	{
+		assert((src.size() * 3) <= dst.size());
+
+		static const EncodeFunction encode = SelectEncode();
+		encode(src, dst);
+	}
+
+	void DecodeBGR24Row(const std::span<const std::byte> src, const std::span<ColorF> dst) noexcept
+	{
+		assert((dst.size() * 3) <= src.size());
+
+		for (std::size_t x = 0; x < dst.size(); ++x)
+		{
+			dst[x] = Color8{ std::to_integer<std::uint8_t>(src[x * 3 + 2]),
+				std::to_integer<std::uint8_t>(src[x * 3 + 1]),
+				std::to_integer<std::uint8_t>(src[x * 3 + 0]) }.toColorF();
+		}
+	}
+
+	void EncodeBGR24Row(const std::span<const ColorF> src, const std::span<std::byte> dst) noexcept
+	{
+		assert((src.size() * 3) <= dst.size());
+
+		for (std::size_t x = 0; x < src.size(); ++x)
+		{
+			const Color8 color{ src[x] };
+			dst[x * 3 + 0] = std::byte{ color.b }; // 青
+			dst[x * 3 + 1] = std::byte{ color.g }; // 緑
+			dst[x * 3 + 2] = std::byte{ color.r }; // 赤
+		}
+	}
+
+	void DecodeBGR24Row(const std::span<const std::byte> src, const std::span<Color8> dst) noexcept
+	{
+		assert((dst.size() * 3) <= src.size());
+		std::memcpy(dst.data(), src.data(), (dst.size() * 3));
+	}
+
+	void EncodeBGR24Row(const std::span<const Color8> src, const std::span<std::byte> dst) noexcept
+	{
+		assert((src.size() * 3) <= dst.size());
+		std::memcpy(dst.data(), src.data(), (src.size() * 3));
+	}
+
+	void DecodeBGR24Row(const std::span<const std::byte> src, const std::span<ColorA8> dst) noexcept
+	{
+		assert((dst.size() * 3) <= src.size());
+
+		for (std::size_t x = 0; x < dst.size(); ++x)
+		{
+			dst[x] = ColorA8{ std::to_integer<std::uint8_t>(src[x * 3 + 2]),
+				std::to_integer<std::uint8_t>(src[x * 3 + 1]),
+				std::to_integer<std::uint8_t>(src[x * 3 + 0]) };
+		}
+	}
+
+	void DecodeBGRA32Row(const std::span<const std::byte> src, const std::span<Color> dst) noexcept
+	{
+		assert((dst.size() * 4) <= src.size());
+
+		for (std::size_t x = 0; x < dst.size(); ++x)
+		{
+			DecodePixel(&src[x * 4], dst[x]);
+		}
+	}
+
+	void DecodeBGRA32Row(const std::span<const std::byte> src, const std::span<ColorF> dst) noexcept
+	{
+		assert((dst.size() * 4) <= src.size());
+
+		for (std::size_t x = 0; x < dst.size(); ++x)
+		{
+			dst[x] = Color8{ std::to_integer<std::uint8_t>(src[x * 4 + 2]),
+				std::to_integer<std::uint8_t>(src[x * 4 + 1]),
+				std::to_integer<std::uint8_t>(src[x * 4 + 0]) }.toColorF();
+		}
+	}
+
+	void DecodeBGRA32Row(const std::span<const std::byte> src, const std::span<Color8> dst) noexcept
+	{
+		assert((dst.size() * 4) <= src.size());
+
+		for (std::size_t x = 0; x < dst.size(); ++x)
+		{
+			dst[x] = Color8{ std::to_integer<std::uint8_t>(src[x * 4 + 2]),
+				std::to_integer<std::uint8_t>(src[x * 4 + 1]),
+				std::to_integer<std::uint8_t>(src[x * 4 + 0]) };
+		}
+	}
+
+	void DecodeBGRA32Row(const std::span<const std::byte> src, const std::span<ColorA8> dst) noexcept
+	{
+		assert((dst.size() * 4) <= src.size());
+		std::memcpy(dst.data(), src.data(), (dst.size() * 4));
+	}
+
+	void EncodeBGRA32Row(const std::span<const ColorA8> src, const std::span<std::byte> dst) noexcept
+	{
+		assert((src.size() * 4) <= dst.size());
+		std::memcpy(dst.data(), src.data(), (src.size() * 4));
+	}
+}
@@ -0,0 +1,79 @@
+﻿#pragma once
+#include <cstddef>		// std::byte
+#include <span>			// std::span
+#include "Color.hpp"	// mini::Color
+#include "ColorF.hpp"	// mini::ColorF
+#include "Color8.hpp"	// mini::Color8
+#include "ColorA8.hpp"	// mini::ColorA8
+
+namespace mini
+{
+	/// @brief BGR 各 8 ビットで格納された 1 行分のデータを、色の配列に変換します。
+	/// @param src 変換元のデータ（`dst.size() * 3` バイト以上）
+	/// @param dst 変換結果の格納先
+	void DecodeBGR24Row(std::span<const std::byte> src, std::span<Color> dst) noexcept;
+
+	/// @brief 色の配列を、BGR 各 8 ビットで格納された 1 行分のデータに変換します。
+	/// @param src 変換元の色の配列
+	/// @param dst 変換結果の格納先（`src.size() * 3` バイト以上）
+	/// @remark 各色成分は 0.0 ～ 1.0 の範囲に丸められます。
+	void EncodeBGR24Row(std::span<const Color> src, std::span<std::byte> dst) noexcept;
+
+	/// @brief BGR 各 8 ビットで格納された 1 行分のデータを、色の配列に変換します。
+	/// @param src 変換元のデータ（`dst.size() * 3` バイト以上）
+	/// @param dst 変換結果の格納先
+	void DecodeBGR24Row(std::span<const std::byte> src, std::span<ColorF> dst) noexcept;
+
+	/// @brief 色の配列を、BGR 各 8 ビットで格納された 1 行分のデータに変換します。
+	/// @param src 変換元の色の配列
+	/// @param dst 変換結果の格納先（`src.size() * 3` バイト以上）
+	/// @remark 各色成分は 0.0 ～ 1.0 の範囲に丸められます。
+	void EncodeBGR24Row(std::span<const ColorF> src, std::span<std::byte> dst) noexcept;
+
+	/// @brief BGR 各 8 ビットで格納された 1 行分のデータを、色の配列にコピーします。
+	/// @param src コピー元のデータ（`dst.size() * 3` バイト以上）
+	/// @param dst コピー先
+	/// @remark `Color8` はファイルと同じ並びなので、変換せずにそのままコピーします。
+	void DecodeBGR24Row(std::span<const std::byte> src, std::span<Color8> dst) noexcept;
+
+	/// @brief 色の配列を、BGR 各 8 ビットで格納された 1 行分のデータにコピーします。
+	/// @param src コピー元の色の配列
+	/// @param dst コピー先（`src.size() * 3` バイト以上）
+	/// @remark `Color8` はファイルと同じ並びなので、変換せずにそのままコピーします。
+	void EncodeBGR24Row(std::span<const Color8> src, std::span<std::byte> dst) noexcept;
+
+	/// @brief BGR 各 8 ビットで格納された 1 行分のデータを、不透明な色の配列に変換します。
+	/// @param src 変換元のデータ（`dst.size() * 3` バイト以上）
+	/// @param dst 変換結果の格納先
+	void DecodeBGR24Row(std::span<const std::byte> src, std::span<ColorA8> dst) noexcept;
+
+	/// @brief BGRA 各 8 ビットで格納された 1 行分のデータを、色の配列に変換します。
+	/// @param src 変換元のデータ（`dst.size() * 4` バイト以上）
+	/// @param dst 変換結果の格納先
+	/// @remark 不透明度は無視します。
+	void DecodeBGRA32Row(std::span<const std::byte> src, std::span<Color> dst) noexcept;
+
+	/// @brief BGRA 各 8 ビットで格納された 1 行分のデータを、色の配列に変換します。
+	/// @param src 変換元のデータ（`dst.size() * 4` バイト以上）
+	/// @param dst 変換結果の格納先
+	/// @remark 不透明度は無視します。
+	void DecodeBGRA32Row(std::span<const std::byte> src, std::span<ColorF> dst) noexcept;
+
+	/// @brief BGRA 各 8 ビットで格納された 1 行分のデータを、色の配列に変換します。
+	/// @param src 変換元のデータ（`dst.size() * 4` バイト以上）
+	/// @param dst 変換結果の格納先
+	/// @remark 不透明度は無視します。
+	void DecodeBGRA32Row(std::span<const std::byte> src, std::span<Color8> dst) noexcept;
+
+	/// @brief BGRA 各 8 ビットで格納された 1 行分のデータを、色の配列にコピーします。
+	/// @param src コピー元のデータ（`dst.size() * 4` バイト以上）
+	/// @param dst コピー先
+	/// @remark `ColorA8` はファイルと同じ並びなので、変換せずにそのままコピーします。
+	void DecodeBGRA32Row(std::span<const std::byte> src, std::span<ColorA8> dst) noexcept;
+
+	/// @brief 色の配列を、BGRA 各 8 ビットで格納された 1 行分のデータにコピーします。
+	/// @param src コピー元の色の配列
+	/// @param dst コピー先（`src.size() * 4` バイト以上）
+	/// @remark `ColorA8` はファイルと同じ並びなので、変換せずにそのままコピーします。
+	void EncodeBGRA32Row(std::span<const ColorA8> src, std::span<std::byte> dst) noexcept;
+}
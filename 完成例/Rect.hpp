@@ -0,0 +1,186 @@
+﻿#pragma once
+#include <cstdint>		// std::int64_t
+#include <algorithm>	// std::min, std::max
+#include <format>		// std::formatter
+#include <string_view>	// std::string_view
+#include <iostream>		// std::ostream, std::istream
+#include "Point.hpp"	// mini::Point
+
+namespace mini
+{
+	/// @brief 長方形の領域を表現するクラス
+	struct Rect
+	{
+		/// @brief 左上の X 座標
+		int x = 0;
+
+		/// @brief 左上の Y 座標
+		int y = 0;
+
+		/// @brief 幅
+		int w = 0;
+
+		/// @brief 高さ
+		int h = 0;
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		Rect() = default;
+
+		/// @brief 長方形を作成します。
+		/// @param _x 左上の X 座標
+		/// @param _y 左上の Y 座標
+		/// @param _w 幅
+		/// @param _h 高さ
+		[[nodiscard]]
+		constexpr Rect(int _x, int _y, int _w, int _h) noexcept
+			: x{ _x }
+			, y{ _y }
+			, w{ _w }
+			, h{ _h } {}
+
+		/// @brief 長方形を作成します。
+		/// @param pos 左上の座標
+		/// @param size 幅と高さ
+		[[nodiscard]]
+		constexpr Rect(const Point& pos, const Point& size) noexcept
+			: x{ pos.x }
+			, y{ pos.y }
+			, w{ size.x }
+			, h{ size.y } {}
+
+		/// @brief 左上の座標を返します。
+		/// @return 左上の座標
+		[[nodiscard]]
+		constexpr Point pos() const noexcept
+		{
+			return{ x, y };
+		}
+
+		/// @brief 幅と高さを返します。
+		/// @return 幅と高さ
+		[[nodiscard]]
+		constexpr Point size() const noexcept
+		{
+			return{ w, h };
+		}
+
+		/// @brief 右端の X 座標を返します。
+		/// @return 右端の X 座標（領域に含まれない）
+		[[nodiscard]]
+		constexpr int right() const noexcept
+		{
+			return (x + w);
+		}
+
+		/// @brief 下端の Y 座標を返します。
+		/// @return 下端の Y 座標（領域に含まれない）
+		[[nodiscard]]
+		constexpr int bottom() const noexcept
+		{
+			return (y + h);
+		}
+
+		/// @brief 面積を返します。
+		/// @return 面積
+		[[nodiscard]]
+		constexpr std::int64_t area() const noexcept
+		{
+			return (static_cast<std::int64_t>(w) * h);
+		}
+
+		/// @brief 領域が空であるかを返します。
+		/// @return 幅または高さが 0 以下である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		constexpr bool isEmpty() const noexcept
+		{
+			return ((w <= 0) || (h <= 0));
+		}
+
+		/// @brief 指定した点が領域に含まれるかを返します。
+		/// @param p 点の座標
+		/// @return 含まれる場合 true, それ以外の場合は false
+		[[nodiscard]]
+		constexpr bool contains(const Point& p) const noexcept
+		{
+			return ((x <= p.x) && (p.x < right()) && (y <= p.y) && (p.y < bottom()));
+		}
+
+		/// @brief 指定した長方形が領域に含まれるかを返します。
+		/// @param other 長方形
+		/// @return 含まれる場合 true, それ以外の場合は false
+		[[nodiscard]]
+		constexpr bool contains(const Rect& other) const noexcept
+		{
+			return ((x <= other.x) && (other.right() <= right()) && (y <= other.y) && (other.bottom() <= bottom()));
+		}
+
+		/// @brief 指定した長方形と重なるかを返します。
+		/// @param other 長方形
+		/// @return 重なる場合 true, それ以外の場合は false
+		[[nodiscard]]
+		constexpr bool intersects(const Rect& other) const noexcept
+		{
+			return (!intersection(other).isEmpty());
+		}
+
+		/// @brief 指定した長方形と重なる領域を返します。
+		/// @param other 長方形
+		/// @return 重なる領域。重ならない場合は空の長方形
+		[[nodiscard]]
+		constexpr Rect intersection(const Rect& other) const noexcept
+		{
+			const int left = std::max(x, other.x);
+			const int top = std::max(y, other.y);
+			const int right_ = std::min(right(), other.right());
+			const int bottom_ = std::min(bottom(), other.bottom());
+
+			if ((right_ <= left) || (bottom_ <= top))
+			{
+				return{};
+			}
+
+			return{ left, top, (right_ - left), (bottom_ - top) };
+		}
+
+		/// @brief 位置をずらした長方形を返します。
+		/// @param offset 移動量
+		/// @return 位置をずらした長方形
+		[[nodiscard]]
+		constexpr Rect movedBy(const Point& offset) const noexcept
+		{
+			return{ (x + offset.x), (y + offset.y), w, h };
+		}
+
+		[[nodiscard]]
+		friend constexpr bool operator ==(const Rect& lhs, const Rect& rhs) noexcept = default;
+
+		/// @brief 出力ストリームに書き込みます。
+		/// @param os 出力ストリーム
+		/// @param value 書き込む値
+		/// @return 出力ストリーム
+		friend std::ostream& operator <<(std::ostream& os, const Rect& value)
+		{
+			return os << '(' << value.x << ", " << value.y << ", " << value.w << ", " << value.h << ')';
+		}
+
+		/// @brief 入力ストリームから読み込みます。
+		/// @param is 入力ストリーム
+		/// @param value 読み込んだ値の格納先
+		/// @return 入力ストリーム
+		friend std::istream& operator >>(std::istream& is, Rect& value)
+		{
+			char _; // 区切り文字用
+			return is >> _ >> value.x >> _ >> value.y >> _ >> value.w >> _ >> value.h >> _;
+		}
+	};
+}
+
+template <>
+struct std::formatter<mini::Rect> : std::formatter<std::string_view>
+{
+	auto format(const mini::Rect& value, auto& ctx) const
+	{
+		return std::format_to(ctx.out(), "({}, {}, {}, {})", value.x, value.y, value.w, value.h);
+	}
+};
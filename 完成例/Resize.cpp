@@ -0,0 +1,336 @@
+﻿#include <algorithm>	// std::min, std::max, std::fill_n
+#include <cmath>		// std::abs, std::ceil, std::floor, std::sin
+#include <cstddef>		// std::size_t
+#include <numbers>		// std::numbers::pi
+#include <vector>		// std::vector
+#include "Resize.hpp"
+#include "PixelAccumulator.hpp"	// mini::AccumulatorType, mini::ToChannels, mini::FromChannels
+
+namespace mini
+{
+	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+	namespace
+	{
+		/// @brief フィルタの半径を返します。
+		[[nodiscard]]
+		double FilterRadius(const ResizeFilter filter) noexcept
+		{
+			switch (filter)
+			{
+			case ResizeFilter::Box:
+				return 0.5;
+			case ResizeFilter::Bilinear:
+				return 1.0;
+			case ResizeFilter::Bicubic:
+				return 2.0;
+			default:
+				return 3.0;
+			}
+		}
+
+		/// @brief 正規化された sinc 関数
+		[[nodiscard]]
+		double Sinc(const double x) noexcept
+		{
+			if (x == 0.0)
+			{
+				return 1.0;
+			}
+
+			return (std::sin(std::numbers::pi * x) / (std::numbers::pi * x));
+		}
+
+		/// @brief 中心からの距離 x におけるフィルタの値を返します。
+		[[nodiscard]]
+		double FilterValue(const ResizeFilter filter, const double x) noexcept
+		{
+			const double t = std::abs(x);
+
+			switch (filter)
+			{
+			case ResizeFilter::Box:
+				// 隣り合う出力ピクセルで重複して数えないよう、半開区間 [-0.5, 0.5) にする
+				return (((-0.5 <= x) && (x < 0.5)) ? 1.0 : 0.0);
+			case ResizeFilter::Bilinear:
+				return ((t < 1.0) ? (1.0 - t) : 0.0);
+			case ResizeFilter::Bicubic:
+			{
+				constexpr double a = -0.5;
+
+				if (t < 1.0)
+				{
+					return (((a + 2.0) * t - (a + 3.0)) * t * t + 1.0);
+				}
+				else if (t < 2.0)
+				{
+					return (((a * t - 5.0 * a) * t + 8.0 * a) * t - 4.0 * a);
+				}
+
+				return 0.0;
+			}
+			default:
+				return ((t < 3.0) ? (Sinc(t) * Sinc(t / 3.0)) : 0.0);
+			}
+		}
+
+		/// @brief 1 次元の拡大・縮小の重み
+		template <class Type>
+		struct ResizeWeights
+		{
+			/// @brief 出力の各位置が参照する、入力の最初の位置
+			std::vector<int> starts;
+
+			/// @brief 出力の位置ごとの重みの数（すべての位置で同じ。足りない分は 0）
+			int numTaps = 0;
+
+			/// @brief 重み（出力の位置 i の重みは `weights[i * numTaps]` から）
+			std::vector<Type> weights;
+		};
+
+		/// @brief 入力の大きさ srcSize を outSize に拡大・縮小するときの重みを計算します。
+		template <class Type>
+		[[nodiscard]]
+		ResizeWeights<Type> ComputeWeights(const int srcSize, const int outSize, const ResizeFilter filter)
+		{
+			const double scale = (static_cast<double>(outSize) / srcSize);
+
+			// 縮小時は、フィルタを縮小率に合わせて広げる
+			const double filterScale = std::min(scale, 1.0);
+			const double support = (FilterRadius(filter) / filterScale);
+
+			ResizeWeights<Type> result;
+			result.numTaps = std::min(srcSize, (static_cast<int>(std::ceil(2.0 * support)) + 1));
+			result.starts.resize(outSize);
+			result.weights.assign((static_cast<std::size_t>(outSize) * result.numTaps), Type{ 0 });
+
+			std::vector<double> taps;
+
+			for (int i = 0; i < outSize; ++i)
+			{
+				// 出力ピクセルの中心に対応する、入力の位置
+				const double center = ((i + 0.5) / scale - 0.5);
+				const int left = static_cast<int>(std::ceil(center - support));
+				const int right = static_cast<int>(std::floor(center + support));
+
+				// 範囲外の位置の重みは、最も近い端の位置に加える
+				const int start = std::clamp(left, 0, (srcSize - result.numTaps));
+				taps.assign(result.numTaps, 0.0);
+				double sum = 0.0;
+
+				for (int j = left; j <= right; ++j)
+				{
+					const double weight = FilterValue(filter, ((j - center) * filterScale));
+
+					if (weight == 0.0)
+					{
+						continue;
+					}
+
+					const int index = std::clamp((std::clamp(j, 0, (srcSize - 1)) - start), 0, (result.numTaps - 1));
+					taps[index] += weight;
+					sum += weight;
+				}
+
+				result.starts[i] = start;
+
+				for (int k = 0; k < result.numTaps; ++k)
+				{
+					result.weights[static_cast<std::size_t>(i) * result.numTaps + k] = static_cast<Type>((sum != 0.0) ? (taps[k] / sum) : 0.0);
+				}
+			}
+
+			return result;
+		}
+
+		/// @brief 入力の 1 行を、成分の数値の配列に変換します。
+		template <class PixelType, class Type>
+		void LoadRow(const PixelType* src, const int width, Type* dst) noexcept
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				ToChannels(src[x], (dst + x * 3));
+			}
+		}
+
+		/// @brief 成分の数値の配列を、出力の 1 行に書き込みます。
+		template <class PixelType, class Type>
+		void StoreRow(const Type* src, const int width, PixelType* dst) noexcept
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				dst[x] = FromChannels<PixelType>(src + x * 3);
+			}
+		}
+
+		/// @brief 縦横とも Factor 分の 1 に縮小します（Factor x Factor ピクセルのブロックの平均）。
+		template <int Factor, class PixelType>
+		void DownscaleBox(const BasicImage<PixelType>& src, BasicImage<PixelType>& dst)
+		{
+			using Type = AccumulatorType<PixelType>;
+			const int srcWidth = src.width();
+			const int width = dst.width();
+
+			ParallelForBands(dst.height(), ParallelOptions{}, [&](const int y0, const int y1)
+			{
+				std::vector<Type> row(static_cast<std::size_t>(srcWidth) * 3);
+				std::vector<Type> rowSum(static_cast<std::size_t>(srcWidth) * 3);
+				std::vector<Type> out(static_cast<std::size_t>(width) * 3);
+				const int n = (srcWidth * 3);
+				constexpr Type Scale = (Type{ 1 } / (Factor * Factor));
+
+				for (int y = y0; y < y1; ++y)
+				{
+					// Factor 行を縦に足し合わせる
+					std::fill_n(rowSum.data(), n, Type{ 0 });
+
+					for (int k = 0; k < Factor; ++k)
+					{
+						LoadRow(src[y * Factor + k], srcWidth, row.data());
+
+						MINI_IVDEP
+						for (int i = 0; i < n; ++i)
+						{
+							rowSum[i] += row[i];
+						}
+					}
+
+					// Factor 列ずつ横に足し合わせる
+					for (int x = 0; x < width; ++x)
+					{
+						const Type* const in = (rowSum.data() + x * Factor * 3);
+
+						for (int c = 0; c < 3; ++c)
+						{
+							Type sum = 0;
+
+							for (int k = 0; k < Factor; ++k)
+							{
+								sum += in[k * 3 + c];
+							}
+
+							out[x * 3 + c] = (sum * Scale);
+						}
+					}
+
+					StoreRow(out.data(), width, dst[y]);
+				}
+			});
+		}
+	}
+
+	template <class PixelType>
+	BasicImage<PixelType> Resize(const BasicImage<PixelType>& image, const int width, const int height, const ResizeFilter filter)
+	{
+		if (image.isEmpty() || (width <= 0) || (height <= 0))
+		{
+			return{};
+		}
+
+		if ((width == image.width()) && (height == image.height()))
+		{
+			return image;
+		}
+
+		BasicImage<PixelType> result{ width, height, Uninitialized, image.layout() };
+
+		// 1/2, 1/4 ちょうどの縮小
+		if (filter == ResizeFilter::Box)
+		{
+			if (((width * 2) == image.width()) && ((height * 2) == image.height()))
+			{
+				DownscaleBox<2>(image, result);
+				return result;
+			}
+			else if (((width * 4) == image.width()) && ((height * 4) == image.height()))
+			{
+				DownscaleBox<4>(image, result);
+				return result;
+			}
+		}
+
+		using Type = AccumulatorType<PixelType>;
+		const ResizeWeights<Type> horizontal = ComputeWeights<Type>(image.width(), width, filter);
+		const ResizeWeights<Type> vertical = ComputeWeights<Type>(image.height(), height, filter);
+		const int n = (width * 3);
+
+		ParallelForBands(height, ParallelOptions{}, [&](const int y0, const int y1)
+		{
+			// 水平方向にフィルタをかけた直近の入力の行（垂直方向の重みの数だけ）をリングバッファに保持する
+			std::vector<Type> row(static_cast<std::size_t>(image.width()) * 3);
+			std::vector<Type> ring(static_cast<std::size_t>(vertical.numTaps) * n);
+			std::vector<Type> sum(n);
+
+			// 入力の行 sy に対応するリングバッファの行
+			const auto ringRow = [&](const int sy)
+			{
+				return (ring.data() + static_cast<std::size_t>(sy % vertical.numTaps) * n);
+			};
+
+			// 入力の行 sy に水平方向のフィルタをかけて、リングバッファに書き込む
+			const auto filterRow = [&](const int sy)
+			{
+				LoadRow(image[sy], image.width(), row.data());
+				Type* const out = ringRow(sy);
+
+				for (int x = 0; x < width; ++x)
+				{
+					const Type* const in = (row.data() + horizontal.starts[x] * 3);
+					const Type* const weights = (horizontal.weights.data() + static_cast<std::size_t>(x) * horizontal.numTaps);
+					Type r = 0, g = 0, b = 0;
+
+					for (int k = 0; k < horizontal.numTaps; ++k)
+					{
+						r += (weights[k] * in[k * 3 + 0]);
+						g += (weights[k] * in[k * 3 + 1]);
+						b += (weights[k] * in[k * 3 + 2]);
+					}
+
+					out[x * 3 + 0] = r;
+					out[x * 3 + 1] = g;
+					out[x * 3 + 2] = b;
+				}
+			};
+
+			// 次にフィルタをかける入力の行（starts は単調増加なので、各入力の行は帯の中で高々 1 回だけフィルタをかければよい）
+			int nextSrcY = vertical.starts[y0];
+
+			for (int y = y0; y < y1; ++y)
+			{
+				const int srcY0 = vertical.starts[y];
+				const int srcY1 = (srcY0 + vertical.numTaps);
+
+				// この行の出力が参照する入力の行のうち、まだフィルタをかけていない行だけを処理する
+				for (int sy = std::max(nextSrcY, srcY0); sy < srcY1; ++sy)
+				{
+					filterRow(sy);
+				}
+
+				nextSrcY = std::max(nextSrcY, srcY1);
+
+				// 垂直方向のフィルタ
+				const Type* const weights = (vertical.weights.data() + static_cast<std::size_t>(y) * vertical.numTaps);
+				std::fill_n(sum.data(), n, Type{ 0 });
+
+				for (int k = 0; k < vertical.numTaps; ++k)
+				{
+					const Type weight = weights[k];
+					const Type* const in = ringRow(srcY0 + k);
+
+					MINI_IVDEP
+					for (int i = 0; i < n; ++i)
+					{
+						sum[i] += (weight * in[i]);
+					}
+				}
+
+				StoreRow(sum.data(), width, result[y]);
+			}
+		});
+
+		return result;
+	}
+
+	template Image Resize<Color>(const Image&, int, int, ResizeFilter);
+	template ImageF Resize<ColorF>(const ImageF&, int, int, ResizeFilter);
+	template Image8 Resize<Color8>(const Image8&, int, int, ResizeFilter);
+}
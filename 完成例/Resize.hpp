@@ -0,0 +1,36 @@
+﻿#pragma once
+#include "Image.hpp"	// mini::BasicImage
+
+namespace mini
+{
+	/// @brief 画像の拡大・縮小に使うフィルタ
+	enum class ResizeFilter
+	{
+		/// @brief 元の画像の、出力ピクセルが覆う範囲の平均（拡大時は最近傍と同じ）
+		/// @remark 縦横とも 1/2 または 1/4 ちょうどの縮小では、ブロックの平均を直接求める高速な処理を使います（ミップマップの作成など）。
+		Box,
+
+		/// @brief 双線形補間（半径 1）
+		Bilinear,
+
+		/// @brief 双三次補間（Keys, a = -0.5, 半径 2）
+		Bicubic,
+
+		/// @brief Lanczos 補間（半径 3）
+		Lanczos3,
+	};
+
+	/// @brief 画像を指定したサイズに拡大・縮小します。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8` のいずれか）
+	/// @param image 元の画像
+	/// @param width 結果の画像の幅（ピクセル）
+	/// @param height 結果の画像の高さ（ピクセル）
+	/// @param filter 使用するフィルタ
+	/// @return 拡大・縮小した画像。元の画像が空の場合、またはサイズが不正な場合は空の画像を返します。
+	/// @remark 列ごと・行ごとのフィルタの重みを最初に 1 回だけ計算し、水平方向と垂直方向に分けて計算します。
+	/// 縮小時はフィルタの幅を縮小率に合わせて広げるため、エイリアシングが起こりにくくなります。範囲外のピクセルは、最も近い端のピクセルとみなします。
+	/// 結果の画像を行の帯に分けて並列に処理します。
+	template <class PixelType>
+	[[nodiscard]]
+	BasicImage<PixelType> Resize(const BasicImage<PixelType>& image, int width, int height, ResizeFilter filter = ResizeFilter::Bilinear);
+}
@@ -0,0 +1,539 @@
+﻿#include <algorithm>		// std::min, std::max, std::clamp, std::fill, std::fill_n
+#include <cassert>			// assert
+#include <cmath>			// std::abs
+#include <cstdint>			// std::int32_t, std::int64_t, std::uint64_t
+#include <type_traits>		// std::is_same_v
+#include <utility>			// std::move
+#include <vector>			// std::vector
+#include "Segmentation.hpp"
+#include "Parallel.hpp"		// mini::ParallelOptions, mini::ParallelForBands
+#include "ThreadPool.hpp"	// mini::GetDefaultThreadPool
+
+namespace mini
+{
+	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+	namespace
+	{
+		/// @brief ピクセルの色が、基準の色に近いかを判定するクラス
+		template <class PixelType>
+		class ColorMatcher
+		{
+		public:
+
+			[[nodiscard]]
+			ColorMatcher(const PixelType& target, const double tolerance) noexcept
+				: m_target{ target }
+				, m_tolerance{ tolerance }
+				// 8 ビット整数の場合は、差が tolerance * 255 以下になる最大の整数と比較する
+				, m_toleranceInt{ static_cast<int>(tolerance * 255.0 + 1e-9) } {}
+
+			[[nodiscard]]
+			bool operator ()(const PixelType& color) const noexcept
+			{
+				if constexpr (std::is_same_v<PixelType, Color8>)
+				{
+					return ((std::abs(color.r - m_target.r) <= m_toleranceInt)
+						&& (std::abs(color.g - m_target.g) <= m_toleranceInt)
+						&& (std::abs(color.b - m_target.b) <= m_toleranceInt));
+				}
+				else if constexpr (std::is_same_v<PixelType, ColorA8>)
+				{
+					return ((std::abs(color.r - m_target.r) <= m_toleranceInt)
+						&& (std::abs(color.g - m_target.g) <= m_toleranceInt)
+						&& (std::abs(color.b - m_target.b) <= m_toleranceInt)
+						&& (std::abs(color.a - m_target.a) <= m_toleranceInt));
+				}
+				else
+				{
+					return ((std::abs(color.r - m_target.r) <= m_tolerance)
+						&& (std::abs(color.g - m_target.g) <= m_tolerance)
+						&& (std::abs(color.b - m_target.b) <= m_tolerance));
+				}
+			}
+
+		private:
+
+			PixelType m_target;
+
+			double m_tolerance;
+
+			int m_toleranceInt;
+		};
+
+		/// @brief 1 ピクセル 1 ビットで、処理済みのピクセルを記録するクラス
+		class VisitedBits
+		{
+		public:
+
+			[[nodiscard]]
+			explicit VisitedBits(const std::size_t size)
+				: m_words((size + 63) / 64) {}
+
+			[[nodiscard]]
+			bool test(const std::size_t index) const noexcept
+			{
+				return ((m_words[index / 64] >> (index % 64)) & 1);
+			}
+
+			/// @brief [begin, end) の範囲のビットを立てます。
+			void set(const std::size_t begin, const std::size_t end) noexcept
+			{
+				if (end <= begin)
+				{
+					return;
+				}
+
+				const std::size_t firstWord = (begin / 64);
+				const std::size_t lastWord = ((end - 1) / 64);
+				const std::uint64_t firstMask = (~std::uint64_t{ 0 } << (begin % 64));
+				const std::uint64_t lastMask = (~std::uint64_t{ 0 } >> (63 - ((end - 1) % 64)));
+
+				if (firstWord == lastWord)
+				{
+					m_words[firstWord] |= (firstMask & lastMask);
+					return;
+				}
+
+				m_words[firstWord] |= firstMask;
+				std::fill((m_words.begin() + firstWord + 1), (m_words.begin() + lastWord), ~std::uint64_t{ 0 });
+				m_words[lastWord] |= lastMask;
+			}
+
+		private:
+
+			std::vector<std::uint64_t> m_words;
+		};
+
+		/// @brief ピクセルが前景（黒以外）であるかを返します。
+		template <class PixelType>
+		[[nodiscard]]
+		bool IsForeground(const PixelType& color) noexcept
+		{
+			if constexpr (std::is_same_v<PixelType, Color8> || std::is_same_v<PixelType, ColorA8>)
+			{
+				return ((color.r | color.g | color.b) != 0);
+			}
+			else
+			{
+				return ((color.r != 0) || (color.g != 0) || (color.b != 0));
+			}
+		}
+
+		/// @brief 1 行の中で前景が連続する範囲 [x0, x1)
+		struct Run
+		{
+			int x0;
+
+			int x1;
+		};
+
+		/// @brief 行の帯ごとのランの一覧
+		struct BandRuns
+		{
+			/// @brief 帯の先頭の行
+			int y0 = 0;
+
+			/// @brief 帯の終端の行（含まない）
+			int y1 = 0;
+
+			/// @brief 帯のすべてのラン（上の行から、左から順）
+			std::vector<Run> runs;
+
+			/// @brief 各行の最初のランのインデックス（行数 + 1 要素）
+			std::vector<std::int32_t> rowStarts;
+
+			/// @brief 帯の最初のランの、全体での通し番号
+			std::int32_t offset = 0;
+		};
+
+		/// @brief Union-Find の根を返します。経路の途中の要素は、1 つおきに根に近づけます（path halving）。
+		[[nodiscard]]
+		std::int32_t FindRoot(std::int32_t* parent, std::int32_t i) noexcept
+		{
+			while (parent[i] != i)
+			{
+				parent[i] = parent[parent[i]];
+				i = parent[i];
+			}
+
+			return i;
+		}
+
+		/// @brief 2 つの要素を含む集合をまとめます。
+		/// @remark 番号の小さいほうを根にするため、どの要素の親も自分より小さい番号になる。
+		void Unite(std::int32_t* parent, const std::int32_t a, const std::int32_t b) noexcept
+		{
+			const std::int32_t rootA = FindRoot(parent, a);
+			const std::int32_t rootB = FindRoot(parent, b);
+
+			if (rootA < rootB)
+			{
+				parent[rootB] = rootA;
+			}
+			else if (rootB < rootA)
+			{
+				parent[rootA] = rootB;
+			}
+		}
+
+		/// @brief 隣り合う 2 行のランのうち、つながっているものをまとめます。
+		/// @param upper 上の行のラン
+		/// @param upperBase 上の行の最初のランの通し番号
+		/// @param lower 下の行のラン
+		/// @param lowerBase 下の行の最初のランの通し番号
+		/// @param reach 4 近傍の場合は 0, 8 近傍の場合は 1
+		void UniteRows(std::int32_t* parent, const std::span<const Run> upper, const std::int32_t upperBase,
+			const std::span<const Run> lower, const std::int32_t lowerBase, const int reach) noexcept
+		{
+			// どちらも左から順に並んでいるので、先に終わるほうを進めながら重なりを調べる
+			std::size_t i = 0, k = 0;
+
+			while ((i < upper.size()) && (k < lower.size()))
+			{
+				const Run& a = upper[i];
+				const Run& b = lower[k];
+
+				if ((a.x0 < (b.x1 + reach)) && (b.x0 < (a.x1 + reach)))
+				{
+					Unite(parent, static_cast<std::int32_t>(upperBase + i), static_cast<std::int32_t>(lowerBase + k));
+				}
+
+				if (a.x1 < b.x1)
+				{
+					++i;
+				}
+				else
+				{
+					++k;
+				}
+			}
+		}
+
+		/// @brief 帯の中の 1 行分のランを返します。
+		[[nodiscard]]
+		std::span<const Run> RowRuns(const BandRuns& band, const int y) noexcept
+		{
+			const int i = (y - band.y0);
+			return std::span{ band.runs }.subspan(band.rowStarts[i], (band.rowStarts[i + 1] - band.rowStarts[i]));
+		}
+
+		/// @brief 連結成分の情報を集計するための値
+		struct ComponentAccumulator
+		{
+			std::int64_t area = 0;
+
+			std::int64_t sumX = 0;
+
+			std::int64_t sumY = 0;
+
+			int minX = 0, minY = 0, maxX = 0, maxY = 0;
+		};
+	}
+
+	template <class PixelType>
+	std::int64_t FloodFill(BasicImage<PixelType>& image, const Point& seed, const PixelType& color, const double tolerance, const Connectivity connectivity)
+	{
+		const int width = image.width();
+		const int height = image.height();
+
+		if (!image.inBounds(seed.y, seed.x))
+		{
+			return 0;
+		}
+
+		const ColorMatcher<PixelType> matches{ image[seed.y][seed.x], tolerance };
+		const int reach = ((connectivity == Connectivity::Eight) ? 1 : 0);
+		VisitedBits visited{ (static_cast<std::size_t>(width) * height) };
+		std::vector<Point> stack{ seed };
+		std::int64_t numFilled = 0;
+
+		while (!stack.empty())
+		{
+			const Point p = stack.back();
+			stack.pop_back();
+
+			PixelType* row = image[p.y];
+			const std::size_t rowOffset = (static_cast<std::size_t>(p.y) * width);
+
+			// 同じピクセルが複数回積まれることがあるので、処理済みであれば飛ばす
+			if (visited.test(rowOffset + p.x))
+			{
+				continue;
+			}
+
+			// 左右に、塗りつぶす範囲 [x0, x1) を広げる
+			int x0 = p.x;
+			int x1 = (p.x + 1);
+
+			while ((0 < x0) && (!visited.test(rowOffset + x0 - 1)) && matches(row[x0 - 1]))
+			{
+				--x0;
+			}
+
+			while ((x1 < width) && (!visited.test(rowOffset + x1)) && matches(row[x1]))
+			{
+				++x1;
+			}
+
+			std::fill_n((row + x0), (x1 - x0), color);
+			visited.set((rowOffset + x0), (rowOffset + x1));
+			numFilled += (x1 - x0);
+
+			// 上下の行で、範囲に接する（8 近傍の場合は斜めも含む）各スパンの左端を積む
+			for (const int ny : { (p.y - 1), (p.y + 1) })
+			{
+				if ((ny < 0) || (height <= ny))
+				{
+					continue;
+				}
+
+				const PixelType* neighbor = image[ny];
+				const std::size_t neighborOffset = (static_cast<std::size_t>(ny) * width);
+				const int end = std::min((x1 + reach), width);
+
+				for (int x = std::max((x0 - reach), 0); x < end;)
+				{
+					if (visited.test(neighborOffset + x) || (!matches(neighbor[x])))
+					{
+						++x;
+						continue;
+					}
+
+					stack.push_back(Point{ x, ny });
+
+					while ((x < end) && (!visited.test(neighborOffset + x)) && matches(neighbor[x]))
+					{
+						++x;
+					}
+				}
+			}
+		}
+
+		return numFilled;
+	}
+
+	ConnectedComponents::ConnectedComponents(const int width, const int height, AlignedBuffer<std::int32_t> labels, std::vector<ComponentStats> components)
+		: m_labels{ std::move(labels) }
+		, m_components{ std::move(components) }
+		, m_width{ width }
+		, m_height{ height }
+	{
+		assert(m_labels.size() == (static_cast<std::size_t>(width) * height));
+	}
+
+	std::int32_t ConnectedComponents::label(const int y, const int x) const noexcept
+	{
+		assert((0 <= y) && (y < m_height) && (0 <= x) && (x < m_width));
+		return m_labels.data()[static_cast<std::size_t>(y) * m_width + x];
+	}
+
+	std::span<const std::int32_t> ConnectedComponents::row(const int y) const noexcept
+	{
+		assert((0 <= y) && (y < m_height));
+		return{ (m_labels.data() + static_cast<std::size_t>(y) * m_width), static_cast<std::size_t>(m_width) };
+	}
+
+	const ComponentStats& ConnectedComponents::component(const std::int32_t label) const noexcept
+	{
+		assert((1 <= label) && (label <= numComponents()));
+		return m_components[label - 1];
+	}
+
+	template <class PixelType>
+	ConnectedComponents LabelConnectedComponents(const BasicImage<PixelType>& mask, const Connectivity connectivity)
+	{
+		const int width = mask.width();
+		const int height = mask.height();
+
+		if (mask.isEmpty())
+		{
+			return{};
+		}
+
+		const int reach = ((connectivity == Connectivity::Eight) ? 1 : 0);
+
+		// 行の帯に分割する（負荷が偏らないよう、スレッド数より多めに分ける）
+		const int numBands = std::clamp((height / 64), 1, (GetDefaultThreadPool().concurrency() * 4));
+		std::vector<BandRuns> bands(numBands);
+
+		for (int b = 0; b < numBands; ++b)
+		{
+			bands[b].y0 = static_cast<int>(static_cast<std::int64_t>(height) * b / numBands);
+			bands[b].y1 = static_cast<int>(static_cast<std::int64_t>(height) * (b + 1) / numBands);
+		}
+
+		ParallelOptions options;
+		options.minRowsPerBand = 1;
+
+		// 1. 帯ごとに、各行のランを抽出する
+		ParallelForBands(numBands, options, [&](const int b0, const int b1)
+		{
+			for (int b = b0; b < b1; ++b)
+			{
+				BandRuns& band = bands[b];
+				band.rowStarts.reserve(band.y1 - band.y0 + 1);
+
+				for (int y = band.y0; y < band.y1; ++y)
+				{
+					const PixelType* row = mask[y];
+					band.rowStarts.push_back(static_cast<std::int32_t>(band.runs.size()));
+
+					for (int x = 0; x < width;)
+					{
+						while ((x < width) && (!IsForeground(row[x])))
+						{
+							++x;
+						}
+
+						if (x == width)
+						{
+							break;
+						}
+
+						const int x0 = x;
+
+						while ((x < width) && IsForeground(row[x]))
+						{
+							++x;
+						}
+
+						band.runs.push_back({ x0, x });
+					}
+				}
+
+				band.rowStarts.push_back(static_cast<std::int32_t>(band.runs.size()));
+			}
+		});
+
+		// ランに全体での通し番号を付ける（上の行から、左から順）
+		std::int64_t numRuns = 0;
+
+		for (BandRuns& band : bands)
+		{
+			band.offset = static_cast<std::int32_t>(numRuns);
+			numRuns += band.runs.size();
+		}
+
+		std::vector<std::int32_t> parent(numRuns);
+
+		// 2. 帯ごとに、隣り合う行のつながっているランをまとめる（各帯は parent の別々の範囲だけを書き換える）
+		ParallelForBands(numBands, options, [&](const int b0, const int b1)
+		{
+			for (int b = b0; b < b1; ++b)
+			{
+				const BandRuns& band = bands[b];
+
+				for (std::size_t i = 0; i < band.runs.size(); ++i)
+				{
+					parent[band.offset + i] = static_cast<std::int32_t>(band.offset + i);
+				}
+
+				for (int y = (band.y0 + 1); y < band.y1; ++y)
+				{
+					UniteRows(parent.data(), RowRuns(band, (y - 1)), (band.offset + band.rowStarts[y - 1 - band.y0]),
+						RowRuns(band, y), (band.offset + band.rowStarts[y - band.y0]), reach);
+				}
+			}
+		});
+
+		// 3. 帯の境界の行どうしをまとめる
+		for (int b = 1; b < numBands; ++b)
+		{
+			const BandRuns& upper = bands[b - 1];
+			const BandRuns& lower = bands[b];
+			UniteRows(parent.data(), RowRuns(upper, (upper.y1 - 1)), (upper.offset + upper.rowStarts[upper.y1 - 1 - upper.y0]),
+				RowRuns(lower, lower.y0), lower.offset, reach);
+		}
+
+		// 4. 根が最初に現れる順にラベルを付ける。親は常に自分より前にあるので、前から順に 1 回走査するだけで根までたどれる
+		std::vector<std::int32_t> runLabels(numRuns);
+		std::int32_t numComponents = 0;
+
+		for (std::int64_t i = 0; i < numRuns; ++i)
+		{
+			runLabels[i] = ((parent[i] == i) ? ++numComponents : runLabels[parent[i]]);
+		}
+
+		// 5. 帯ごとに、ラベル画像を書き込む
+		AlignedBuffer<std::int32_t> labels{ (static_cast<std::size_t>(width) * height), Uninitialized };
+
+		ParallelForBands(numBands, options, [&](const int b0, const int b1)
+		{
+			for (int b = b0; b < b1; ++b)
+			{
+				const BandRuns& band = bands[b];
+
+				for (int y = band.y0; y < band.y1; ++y)
+				{
+					std::int32_t* row = (labels.data() + static_cast<std::size_t>(y) * width);
+					int x = 0;
+
+					for (std::int32_t i = band.rowStarts[y - band.y0]; i < band.rowStarts[y - band.y0 + 1]; ++i)
+					{
+						const Run& run = band.runs[i];
+						std::fill_n((row + x), (run.x0 - x), 0);
+						std::fill_n((row + run.x0), (run.x1 - run.x0), runLabels[band.offset + i]);
+						x = run.x1;
+					}
+
+					std::fill_n((row + x), (width - x), 0);
+				}
+			}
+		});
+
+		// 6. ランごとに、連結成分の面積、外接長方形、座標の合計を集計する
+		std::vector<ComponentAccumulator> accumulators(numComponents);
+
+		for (const BandRuns& band : bands)
+		{
+			for (int y = band.y0; y < band.y1; ++y)
+			{
+				for (std::int32_t i = band.rowStarts[y - band.y0]; i < band.rowStarts[y - band.y0 + 1]; ++i)
+				{
+					const Run& run = band.runs[i];
+					ComponentAccumulator& acc = accumulators[runLabels[band.offset + i] - 1];
+					const std::int64_t length = (run.x1 - run.x0);
+
+					if (acc.area == 0)
+					{
+						acc.minX = run.x0;
+						acc.maxX = (run.x1 - 1);
+						acc.minY = y;
+					}
+
+					acc.area += length;
+					acc.sumX += ((run.x0 + run.x1 - 1) * length / 2); // x0 ～ x1 - 1 の合計
+					acc.sumY += (y * length);
+					acc.minX = std::min(acc.minX, run.x0);
+					acc.maxX = std::max(acc.maxX, (run.x1 - 1));
+					acc.maxY = y;
+				}
+			}
+		}
+
+		std::vector<ComponentStats> components(numComponents);
+
+		for (std::int32_t i = 0; i < numComponents; ++i)
+		{
+			const ComponentAccumulator& acc = accumulators[i];
+			components[i].boundingBox = Rect{ acc.minX, acc.minY, (acc.maxX - acc.minX + 1), (acc.maxY - acc.minY + 1) };
+			components[i].area = acc.area;
+
+			// 平均を四捨五入する（座標は 0 以上なので、整数の割り算で切り捨てられる）
+			components[i].centroid = Point{ static_cast<int>((acc.sumX * 2 + acc.area) / (acc.area * 2)),
+				static_cast<int>((acc.sumY * 2 + acc.area) / (acc.area * 2)) };
+		}
+
+		return{ width, height, std::move(labels), std::move(components) };
+	}
+
+	// 対応するピクセルの型について、明示的にインスタンス化する
+	template std::int64_t FloodFill<Color>(Image&, const Point&, const Color&, double, Connectivity);
+	template std::int64_t FloodFill<ColorF>(ImageF&, const Point&, const ColorF&, double, Connectivity);
+	template std::int64_t FloodFill<Color8>(Image8&, const Point&, const Color8&, double, Connectivity);
+	template std::int64_t FloodFill<ColorA8>(ImageA8&, const Point&, const ColorA8&, double, Connectivity);
+	template ConnectedComponents LabelConnectedComponents<Color>(const Image&, Connectivity);
+	template ConnectedComponents LabelConnectedComponents<ColorF>(const ImageF&, Connectivity);
+	template ConnectedComponents LabelConnectedComponents<Color8>(const Image8&, Connectivity);
+	template ConnectedComponents LabelConnectedComponents<ColorA8>(const ImageA8&, Connectivity);
+}
@@ -0,0 +1,141 @@
+﻿#pragma once
+#include <cstdint>		// std::int32_t, std::int64_t
+#include <span>			// std::span
+#include <vector>		// std::vector
+#include "Image.hpp"	// mini::BasicImage
+#include "Point.hpp"	// mini::Point
+#include "Rect.hpp"		// mini::Rect
+#include "AlignedBuffer.hpp"	// mini::AlignedBuffer
+
+namespace mini
+{
+	/// @brief ピクセルのつながり方
+	enum class Connectivity
+	{
+		/// @brief 上下左右の 4 近傍
+		Four,
+
+		/// @brief 斜めを含む 8 近傍
+		Eight,
+	};
+
+	/// @brief 開始位置とつながっている、色の近いピクセルを塗りつぶします（塗りつぶしツール）。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param image 塗りつぶす画像
+	/// @param seed 開始位置
+	/// @param color 塗りつぶす色
+	/// @param tolerance 許容する色の差（0.0 ～ 1.0）。各成分の差がすべてこの値以下のピクセルを、開始位置と同じ色とみなします
+	/// @param connectivity ピクセルのつながり方
+	/// @return 塗りつぶしたピクセル数。開始位置が画像の範囲外の場合は 0
+	/// @remark 再帰の代わりに明示的なスタックを使い、1 行の連続した範囲（スパン）をまとめて処理します。
+	/// 塗りつぶし済みのピクセルは 1 ピクセル 1 ビットの表で管理するため、塗る色が元の色に近い場合でも終了します。
+	template <class PixelType>
+	std::int64_t FloodFill(BasicImage<PixelType>& image, const Point& seed, const PixelType& color, double tolerance = 0.0, Connectivity connectivity = Connectivity::Four);
+
+	/// @brief 連結成分の情報
+	struct ComponentStats
+	{
+		/// @brief 連結成分を囲む最小の長方形
+		Rect boundingBox;
+
+		/// @brief 面積（ピクセル数）
+		std::int64_t area = 0;
+
+		/// @brief 重心（各ピクセルの座標の平均を、最も近い整数に丸めた位置）
+		Point centroid;
+	};
+
+	/// @brief 連結成分のラベル付けの結果を表現するクラス
+	class ConnectedComponents
+	{
+	public:
+
+		/// @brief デフォルトコンストラクタ
+		[[nodiscard]]
+		ConnectedComponents() = default;
+
+		/// @brief ラベル画像と連結成分の情報から作成します。
+		/// @param width 画像の幅（ピクセル）
+		/// @param height 画像の高さ（ピクセル）
+		/// @param labels 各ピクセルのラベル（`width * height` 要素）
+		/// @param components 各連結成分の情報（ラベル 1 の連結成分から順）
+		[[nodiscard]]
+		ConnectedComponents(int width, int height, AlignedBuffer<std::int32_t> labels, std::vector<ComponentStats> components);
+
+		/// @brief 画像の幅（ピクセル）を返します。
+		/// @return 画像の幅（ピクセル）
+		[[nodiscard]]
+		int width() const noexcept
+		{
+			return m_width;
+		}
+
+		/// @brief 画像の高さ（ピクセル）を返します。
+		/// @return 画像の高さ（ピクセル）
+		[[nodiscard]]
+		int height() const noexcept
+		{
+			return m_height;
+		}
+
+		/// @brief 連結成分の数を返します。
+		/// @return 連結成分の数
+		[[nodiscard]]
+		int numComponents() const noexcept
+		{
+			return static_cast<int>(m_components.size());
+		}
+
+		/// @brief ピクセルのラベルを返します。
+		/// @param y Y 座標
+		/// @param x X 座標
+		/// @return ラベル。背景の場合は 0, それ以外は 1 ～ `numComponents()`
+		[[nodiscard]]
+		std::int32_t label(int y, int x) const noexcept;
+
+		/// @brief 1 行分のラベルを返します。
+		/// @param y Y 座標
+		/// @return 1 行分のラベル
+		[[nodiscard]]
+		std::span<const std::int32_t> row(int y) const noexcept;
+
+		/// @brief 連結成分の情報を返します。
+		/// @param label ラベル（1 ～ `numComponents()`）
+		/// @return 連結成分の情報
+		[[nodiscard]]
+		const ComponentStats& component(std::int32_t label) const noexcept;
+
+		/// @brief すべての連結成分の情報を返します。
+		/// @return 連結成分の情報の配列（先頭がラベル 1）
+		[[nodiscard]]
+		std::span<const ComponentStats> components() const noexcept
+		{
+			return m_components;
+		}
+
+	private:
+
+		/// @brief 各ピクセルのラベル
+		AlignedBuffer<std::int32_t> m_labels;
+
+		/// @brief 各連結成分の情報
+		std::vector<ComponentStats> m_components;
+
+		/// @brief 画像の幅（ピクセル）
+		int m_width = 0;
+
+		/// @brief 画像の高さ（ピクセル）
+		int m_height = 0;
+	};
+
+	/// @brief 二値画像の連結成分にラベルを付けます。
+	/// @tparam PixelType ピクセルの型（`Color`, `ColorF`, `Color8`, `ColorA8` のいずれか）
+	/// @param mask 二値画像。黒（赤、緑、青の成分がすべて 0）以外のピクセルを前景とします
+	/// @param connectivity ピクセルのつながり方
+	/// @return ラベル画像と、各連結成分の面積、外接長方形、重心。ラベルは、連結成分が最初に現れる順（上の行から、左から）に 1 から付けます
+	/// @remark 各行の前景を連続した範囲（ラン）に分解し、ランどうしを Union-Find でまとめます。
+	/// ランの抽出とまとめる処理は行の帯ごとに別々のスレッドで行い、帯の境界だけを後でまとめるため、結果はスレッド数によりません。
+	template <class PixelType>
+	[[nodiscard]]
+	ConnectedComponents LabelConnectedComponents(const BasicImage<PixelType>& mask, Connectivity connectivity = Connectivity::Eight);
+}
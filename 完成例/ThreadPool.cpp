@@ -0,0 +1,451 @@
+﻿#include <algorithm>			// std::max, std::min
+#include <atomic>				// std::atomic
+#include <chrono>				// std::chrono::steady_clock
+#include <condition_variable>	// std::condition_variable
+#include <deque>				// std::deque
+#include <exception>			// std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <mutex>				// std::mutex, std::lock_guard, std::unique_lock
+#include <optional>				// std::optional
+#include <thread>				// std::thread
+#include "ThreadPool.hpp"
+#include "AlignedAllocator.hpp"	// mini::CacheLineSize
+
+namespace mini
+{
+	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+	namespace
+	{
+		/// @brief タスクの型
+		using Task = std::function<void()>;
+
+		/// @brief parallelFor の 1 回の呼び出しで共有する状態
+		struct ParallelForState
+		{
+			/// @brief 範囲の先頭
+			int begin = 0;
+
+			/// @brief 範囲の終端（含まない）
+			int end = 0;
+
+			/// @brief 分割した範囲の大きさ
+			int chunkSize = 1;
+
+			/// @brief 分割した範囲の数
+			int numChunks = 0;
+
+			/// @brief 範囲を処理する関数（呼び出し元が待っている間だけ有効）
+			const std::function<void(int, int)>* function = nullptr;
+
+			/// @brief 次に処理する範囲の番号
+			std::atomic<int> nextChunk{ 0 };
+
+			/// @brief 処理が終わっていない範囲の数
+			std::atomic<int> remaining{ 0 };
+
+			/// @brief 最初に送出された例外
+			std::exception_ptr exception;
+
+			std::mutex mutex;
+
+			std::condition_variable finished;
+
+			/// @brief 未処理の範囲がなくなるまで、範囲を 1 つずつ取り出して処理します。
+			void run()
+			{
+				for (int i = nextChunk++; i < numChunks; i = nextChunk++)
+				{
+					const int b = (begin + i * chunkSize);
+					const int e = std::min((b + chunkSize), end);
+
+					try
+					{
+						(*function)(b, e);
+					}
+					catch (...)
+					{
+						const std::lock_guard lock{ mutex };
+
+						if (!exception)
+						{
+							exception = std::current_exception();
+						}
+					}
+
+					// 最後の範囲を処理したスレッドが、待っている呼び出し元に知らせる
+					if (--remaining == 0)
+					{
+						const std::lock_guard lock{ mutex };
+						finished.notify_all();
+					}
+				}
+			}
+		};
+
+		/// @brief ワーカースレッドごとの状態（偽共有を避けるため、キャッシュライン境界に揃える）
+		struct alignas(CacheLineSize) Worker
+		{
+			/// @brief タスクのキュー。持ち主は末尾から、盗む側は先頭から取り出す
+			std::deque<Task> tasks;
+
+			/// @brief キューを保護するミューテックス
+			std::mutex mutex;
+
+			/// @brief 実行したタスクの数
+			std::atomic<std::uint64_t> tasksExecuted{ 0 };
+
+			/// @brief 盗んだタスクの数
+			std::atomic<std::uint64_t> tasksStolen{ 0 };
+
+			/// @brief タスクを実行していた時間（ナノ秒）
+			std::atomic<std::uint64_t> busyNanoseconds{ 0 };
+
+			/// @brief 待機していた時間（ナノ秒）
+			std::atomic<std::uint64_t> idleNanoseconds{ 0 };
+		};
+
+		/// @brief 現在のスレッドがワーカースレッドである場合、所属するスレッドプール
+		thread_local const void* t_currentPool = nullptr;
+
+		/// @brief 現在のスレッドがワーカースレッドである場合、その番号
+		thread_local int t_workerIndex = -1;
+
+		/// @brief 経過時間をナノ秒単位で返します。
+		[[nodiscard]]
+		std::uint64_t ElapsedNanoseconds(const std::chrono::steady_clock::time_point& start) noexcept
+		{
+			return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+		}
+	}
+
+	class ThreadPool::Impl
+	{
+	public:
+
+		explicit Impl(const int numWorkers)
+			: m_workers(numWorkers)
+		{
+			m_threads.reserve(numWorkers);
+
+			for (int i = 0; i < numWorkers; ++i)
+			{
+				m_threads.emplace_back([this, i]() { workerLoop(i); });
+			}
+		}
+
+		~Impl()
+		{
+			{
+				const std::lock_guard lock{ m_sleepMutex };
+				m_stopping = true;
+			}
+
+			m_wake.notify_all();
+
+			for (auto& thread : m_threads)
+			{
+				thread.join();
+			}
+		}
+
+		[[nodiscard]]
+		int numWorkers() const noexcept
+		{
+			return static_cast<int>(m_workers.size());
+		}
+
+		void parallelFor(const int begin, const int end, const std::function<void(int, int)>& function, const int grainSize)
+		{
+			if (end <= begin)
+			{
+				return;
+			}
+
+			const int count = (end - begin);
+			const int concurrency = (numWorkers() + 1);
+
+			// 各スレッドに数個ずつ行き渡る大きさに分割する（偏りがあっても、空いたスレッドが残りを引き受けられるように）
+			const int chunkSize = std::max(std::max(grainSize, 1), (count / (concurrency * 4)));
+			const int numChunks = ((count + chunkSize - 1) / chunkSize);
+
+			// 分割しない場合は、そのまま呼び出し元のスレッドで処理する
+			if ((numChunks <= 1) || m_workers.empty())
+			{
+				function(begin, end);
+				return;
+			}
+
+			auto state = std::make_shared<ParallelForState>();
+			state->begin = begin;
+			state->end = end;
+			state->chunkSize = chunkSize;
+			state->numChunks = numChunks;
+			state->function = &function;
+			state->remaining = numChunks;
+
+			// ワーカースレッドに手伝いを依頼する
+			const int numHelpers = std::min(numWorkers(), (numChunks - 1));
+
+			for (int i = 0; i < numHelpers; ++i)
+			{
+				push([state]() { state->run(); });
+			}
+
+			// 呼び出し元のスレッドも処理に加わる
+			state->run();
+
+			// ほかのスレッドが処理中の範囲が終わるまで待つ
+			{
+				std::unique_lock lock{ state->mutex };
+				state->finished.wait(lock, [&]() { return (state->remaining == 0); });
+			}
+
+			if (state->exception)
+			{
+				std::rethrow_exception(state->exception);
+			}
+		}
+
+		[[nodiscard]]
+		std::vector<ThreadPoolWorkerStats> workerStats() const
+		{
+			std::vector<ThreadPoolWorkerStats> stats(m_workers.size());
+
+			for (std::size_t i = 0; i < m_workers.size(); ++i)
+			{
+				const Worker& worker = m_workers[i];
+				stats[i].tasksExecuted = worker.tasksExecuted;
+				stats[i].tasksStolen = worker.tasksStolen;
+				stats[i].busySeconds = (worker.busyNanoseconds * 1e-9);
+				stats[i].idleSeconds = (worker.idleNanoseconds * 1e-9);
+			}
+
+			return stats;
+		}
+
+		void resetStats()
+		{
+			for (Worker& worker : m_workers)
+			{
+				worker.tasksExecuted = 0;
+				worker.tasksStolen = 0;
+				worker.busyNanoseconds = 0;
+				worker.idleNanoseconds = 0;
+			}
+		}
+
+	private:
+
+		/// @brief ワーカースレッドごとの状態
+		std::vector<Worker> m_workers;
+
+		/// @brief ワーカースレッド
+		std::vector<std::thread> m_threads;
+
+		/// @brief キューに入っているタスクの数
+		std::atomic<int> m_numPending{ 0 };
+
+		/// @brief 外部のスレッドからのタスクを、次に入れるキューの番号
+		std::atomic<unsigned> m_nextQueue{ 0 };
+
+		/// @brief 終了しようとしているか
+		bool m_stopping = false;
+
+		/// @brief 待機と起床を同期するミューテックス
+		std::mutex m_sleepMutex;
+
+		/// @brief タスクが追加されたことを知らせる条件変数
+		std::condition_variable m_wake;
+
+		/// @brief タスクをキューに追加します。
+		/// @remark ワーカースレッドから呼ばれた場合は自分のキューに、それ以外の場合は各キューに順番に追加します。
+		void push(Task task)
+		{
+			const int index = ((t_currentPool == this) ? t_workerIndex
+				: static_cast<int>(m_nextQueue++ % m_workers.size()));
+			{
+				const std::lock_guard lock{ m_workers[index].mutex };
+				m_workers[index].tasks.push_back(std::move(task));
+			}
+
+			++m_numPending;
+
+			// 待機中のワーカースレッドを 1 つ起こす（待機の直前に取り逃がさないよう、ミューテックスを通して同期する）
+			{
+				const std::lock_guard lock{ m_sleepMutex };
+			}
+
+			m_wake.notify_one();
+		}
+
+		/// @brief 自分のキューの末尾から、またはほかのキューの先頭からタスクを取り出します。
+		[[nodiscard]]
+		bool pop(const int index, Task& task)
+		{
+			// 自分のキューは、最後に追加したものから取り出す（キャッシュに残っている可能性が高い）
+			{
+				Worker& worker = m_workers[index];
+				const std::lock_guard lock{ worker.mutex };
+
+				if (!worker.tasks.empty())
+				{
+					task = std::move(worker.tasks.back());
+					worker.tasks.pop_back();
+					--m_numPending;
+					return true;
+				}
+			}
+
+			// ほかのキューからは、最も古いものを盗む
+			const int numWorkers_ = numWorkers();
+
+			for (int i = 1; i < numWorkers_; ++i)
+			{
+				Worker& victim = m_workers[(index + i) % numWorkers_];
+				const std::lock_guard lock{ victim.mutex };
+
+				if (!victim.tasks.empty())
+				{
+					task = std::move(victim.tasks.front());
+					victim.tasks.pop_front();
+					--m_numPending;
+					++m_workers[index].tasksStolen;
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		void workerLoop(const int index)
+		{
+			t_currentPool = this;
+			t_workerIndex = index;
+
+			Worker& worker = m_workers[index];
+
+			for (;;)
+			{
+				Task task;
+
+				if (pop(index, task))
+				{
+					const auto start = std::chrono::steady_clock::now();
+					task();
+					worker.busyNanoseconds += ElapsedNanoseconds(start);
+					++worker.tasksExecuted;
+					continue;
+				}
+
+				// タスクがない場合は、追加されるまで待機する
+				std::unique_lock lock{ m_sleepMutex };
+
+				if (m_stopping && (m_numPending == 0))
+				{
+					return;
+				}
+
+				const auto start = std::chrono::steady_clock::now();
+				m_wake.wait(lock, [this]() { return (m_stopping || (0 < m_numPending)); });
+				worker.idleNanoseconds += ElapsedNanoseconds(start);
+			}
+		}
+	};
+
+	ThreadPool::ThreadPool(const int numWorkers)
+		: m_pImpl{ std::make_shared<Impl>((0 <= numWorkers) ? numWorkers
+			: std::max((static_cast<int>(std::thread::hardware_concurrency()) - 1), 0)) } {}
+
+	ThreadPool::~ThreadPool() = default;
+
+	int ThreadPool::numWorkers() const noexcept
+	{
+		return m_pImpl->numWorkers();
+	}
+
+	int ThreadPool::concurrency() const noexcept
+	{
+		return (m_pImpl->numWorkers() + 1);
+	}
+
+	void ThreadPool::parallelFor(const int begin, const int end, const std::function<void(int, int)>& function, const int grainSize)
+	{
+		m_pImpl->parallelFor(begin, end, function, grainSize);
+	}
+
+	void ThreadPool::parallelFor(const Rect& range, const Point& tileSize, const std::function<void(const Rect&)>& function)
+	{
+		if (range.isEmpty())
+		{
+			return;
+		}
+
+		const int tileWidth = std::max(tileSize.x, 1);
+		const int tileHeight = std::max(tileSize.y, 1);
+		const int numTilesX = ((range.w + tileWidth - 1) / tileWidth);
+		const int numTilesY = ((range.h + tileHeight - 1) / tileHeight);
+
+		m_pImpl->parallelFor(0, (numTilesX * numTilesY), [&](const int t0, const int t1)
+		{
+			for (int i = t0; i < t1; ++i)
+			{
+				const int x = (range.x + (i % numTilesX) * tileWidth);
+				const int y = (range.y + (i / numTilesX) * tileHeight);
+				function(Rect{ x, y, std::min(tileWidth, (range.right() - x)), std::min(tileHeight, (range.bottom() - y)) });
+			}
+		}, 1);
+	}
+
+	std::vector<ThreadPoolWorkerStats> ThreadPool::workerStats() const
+	{
+		return m_pImpl->workerStats();
+	}
+
+	void ThreadPool::resetStats()
+	{
+		m_pImpl->resetStats();
+	}
+
+	// 無名名前空間（この中の関数を、別の翻訳単位からは見えなくする）
+	namespace
+	{
+		/// @brief 共有のスレッドプール
+		struct DefaultThreadPool
+		{
+			std::mutex mutex;
+
+			std::optional<ThreadPool> pool;
+		};
+
+		[[nodiscard]]
+		DefaultThreadPool& GetDefaultThreadPoolStorage()
+		{
+			static DefaultThreadPool storage;
+			return storage;
+		}
+	}
+
+	ThreadPool GetDefaultThreadPool()
+	{
+		DefaultThreadPool& storage = GetDefaultThreadPoolStorage();
+		const std::lock_guard lock{ storage.mutex };
+
+		if (!storage.pool)
+		{
+			storage.pool.emplace();
+		}
+
+		return *storage.pool;
+	}
+
+	void SetDefaultThreadPool(const ThreadPool& pool)
+	{
+		DefaultThreadPool& storage = GetDefaultThreadPoolStorage();
+		std::optional<ThreadPool> previous{ pool };
+		{
+			const std::lock_guard lock{ storage.mutex };
+			storage.pool.swap(previous);
+		}
+
+		// それまでのスレッドプールは、ロックの外で破棄する（ワーカースレッドの終了を待つため）
+	}
+}
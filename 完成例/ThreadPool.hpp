@@ -0,0 +1,96 @@
+﻿#pragma once
+#include <memory>		// std::shared_ptr
+#include <functional>	// std::function
+#include <cstdint>		// std::uint64_t
+#include <vector>		// std::vector
+#include "Point.hpp"	// mini::Point
+#include "Rect.hpp"		// mini::Rect
+
+namespace mini
+{
+	/// @brief `ThreadPool` のワーカースレッドごとの統計情報
+	struct ThreadPoolWorkerStats
+	{
+		/// @brief 実行したタスクの数
+		std::uint64_t tasksExecuted = 0;
+
+		/// @brief 実行したタスクのうち、ほかのワーカースレッドのキューから盗んだものの数
+		std::uint64_t tasksStolen = 0;
+
+		/// @brief タスクを実行していた時間（秒）
+		double busySeconds = 0.0;
+
+		/// @brief タスクがなく待機していた時間（秒）
+		double idleSeconds = 0.0;
+	};
+
+	/// @brief 複数のワーカースレッドで処理を分担するスレッドプール
+	/// @remark 各ワーカースレッドは自分のタスクのキュー（両端キュー）を持ち、自分のキューが空になると、ほかのワーカースレッドのキューからタスクを盗みます（ワークスティーリング）。
+	/// ライブラリの並列処理はすべて共有のプール（`GetDefaultThreadPool()`）で実行し、スレッドの作りすぎを防ぎます。
+	/// コピーしたスレッドプールは状態を共有します。
+	class ThreadPool
+	{
+	public:
+
+		/// @brief スレッドプールを作成します。
+		/// @param numWorkers ワーカースレッドの数。負の場合はハードウェアの同時実行数 - 1（呼び出し元のスレッドも処理に加わるため）
+		[[nodiscard]]
+		explicit ThreadPool(int numWorkers = -1);
+
+		/// @brief デストラクタ
+		/// @remark 最後のコピーが破棄されると、キューに残っている処理を終えてからワーカースレッドを終了します。
+		~ThreadPool();
+
+		/// @brief ワーカースレッドの数を返します。
+		/// @return ワーカースレッドの数
+		[[nodiscard]]
+		int numWorkers() const noexcept;
+
+		/// @brief 同時に処理できるスレッドの数（ワーカースレッドの数 + 呼び出し元のスレッド）を返します。
+		/// @return 同時に処理できるスレッドの数
+		[[nodiscard]]
+		int concurrency() const noexcept;
+
+		/// @brief 範囲 [begin, end) を分割して、ワーカースレッドと呼び出し元のスレッドで並列に処理します。
+		/// @param begin 範囲の先頭
+		/// @param end 範囲の終端（含まない）
+		/// @param function 分割した範囲を処理する関数。範囲の先頭と終端（含まない）を受け取ります
+		/// @param grainSize 一度に処理する範囲の最小の大きさ
+		/// @remark すべての範囲の処理が終わるまで戻りません。`function` の中から再び呼び出しても、デッドロックしません。
+		/// `function` が例外を送出した場合は、すべての処理が終わった後、最初の例外を呼び出し元に再送出します。
+		void parallelFor(int begin, int end, const std::function<void(int, int)>& function, int grainSize = 1);
+
+		/// @brief 二次元の範囲をタイルに分割して、ワーカースレッドと呼び出し元のスレッドで並列に処理します。
+		/// @param range 処理する範囲
+		/// @param tileSize タイルの幅と高さ（範囲の右端と下端のタイルは小さくなります）
+		/// @param function タイルを処理する関数。タイルの範囲を受け取ります
+		/// @remark すべてのタイルの処理が終わるまで戻りません。
+		void parallelFor(const Rect& range, const Point& tileSize, const std::function<void(const Rect&)>& function);
+
+		/// @brief ワーカースレッドごとの統計情報を返します。
+		/// @return ワーカースレッドごとの統計情報
+		[[nodiscard]]
+		std::vector<ThreadPoolWorkerStats> workerStats() const;
+
+		/// @brief 統計情報を 0 に戻します。
+		void resetStats();
+
+	private:
+
+		class Impl;
+
+		std::shared_ptr<Impl> m_pImpl;
+	};
+
+	/// @brief ライブラリ全体で共有するスレッドプールを返します。
+	/// @return 共有のスレッドプール
+	/// @remark 初回の呼び出し時に作成します。
+	[[nodiscard]]
+	ThreadPool GetDefaultThreadPool();
+
+	/// @brief ライブラリ全体で共有するスレッドプールを置き換えます。
+	/// @param pool 新しいスレッドプール
+	/// @remark ワーカースレッドの数を変える場合は `SetDefaultThreadPool(ThreadPool{ numWorkers })` のように呼び出します。
+	/// 実行中の処理は、それまでのスレッドプールで最後まで実行されます。
+	void SetDefaultThreadPool(const ThreadPool& pool);
+}